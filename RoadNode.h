@@ -1,10 +1,12 @@
 #ifndef ROADNODE_H
 #define ROADNODE_H
 
+#include "memoryAccounting.h"
+
 /**
  * @brief The node for the Hash Table containing a key-value pair and a pointer for chaining
  */
-struct RoadNode {
+struct RoadNode : MemoryTracked<MEMORY_CONGESTION> {
     char path[2]; //< Start and end Intersection
     int carCount; //< The number of cars on the road
     RoadNode* right; //< Pointer for chaining in case of collisions in hashtables. Points to right child in minheap
@@ -4,7 +4,10 @@
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <unordered_map>
 #include "graph.h"  // Assuming you have a Graph class for managing vertices and edges
+#include "memoryAccounting.h"
+#include "metrics.h"
 using namespace std;
 
 /**
@@ -22,6 +25,18 @@ private:
     
     int vertexCount = 0;  ///< Counter for the number of vertices
 
+    /// A cached path, its characters accounted to the GPS
+    typedef std::basic_string<char, std::char_traits<char>, TrackingAllocator<char, MEMORY_GPS> > CachedPath;
+    typedef std::unordered_map<std::string, CachedPath, std::hash<std::string>, std::equal_to<std::string>,
+                               TrackingAllocator<std::pair<const std::string, CachedPath>, MEMORY_GPS> > PathCache;
+
+    PathCache pathCache;  ///< getPathAsString results by start and end
+    int pathCacheVersion = -1;  ///< Graph topology version the cached paths were found on
+    std::size_t pathCacheCapacity = 4096;  ///< The cache is emptied when it would grow beyond this
+    Counter* routeQueries;  ///< stms_route_queries_total
+    Counter* cacheLookups;  ///< stms_route_cache_lookups_total
+    Counter* cacheHits;     ///< stms_route_cache_hits_total
+
     /**
      * @brief Helper function to map vertex names to indices in the graph.
      * 
@@ -92,7 +107,10 @@ public:
     /**
      * @brief Function to get the path as a string between two vertices.
      * 
-     * This function returns a string representation of the path from the start vertex to the end vertex.
+     * This function returns a string representation of the path from the start vertex to the end vertex,
+     * the vertex names separated by spaces (the format Vehicle::setPath reads).
+     * The path depends only on the roads of the graph, not on their status, so found paths are cached
+     * until an intersection or road is added or removed.
      * 
      * @param startName The name of the starting vertex.
      * @param endName The name of the destination vertex.
@@ -131,6 +149,13 @@ public:
      */
     void printAllPathsDijkstra(const string& startName, const string& endName);
 
+    /**
+     * @brief Sets the number of paths getPathAsString() keeps.
+     *
+     * @param capacity The number of paths, or 0 to disable the cache.
+     */
+    void setPathCacheCapacity(std::size_t capacity);
+
     /**
      * @brief Heuristic function to estimate the distance between two vertices.
      * 
@@ -1,14 +1,19 @@
 
 #include "accidents.h"
 #include "graph.h"
-#include <fstream>
+#include "csvReader.h"
 #include <iostream>
+#include <vector>
 
 // Constructor
 Accident_roads::Accident_roads() : head(nullptr), underRepairHead(nullptr) {}
 
 // Destructor
 Accident_roads::~Accident_roads() {
+    clear();
+}
+
+void Accident_roads::clear() {
     // Delete accident nodes (Blocked)
     AccidentNode* current = head;
     while (current) {
@@ -24,60 +29,45 @@ Accident_roads::~Accident_roads() {
         repairCurrent = repairCurrent->next;
         delete temp;
     }
+    head = nullptr;
+    underRepairHead = nullptr;
 }
 
 void Accident_roads::loadRoadData(Graph& graph) {
-    std::ifstream file("dataset/road_closures.csv"); 
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file road_closures.csv" << std::endl;
+    CsvReader reader;
+    if (!reader.open("dataset/road_closures.csv"))
         return;
-    }
-
-    std::string intersection1, intersection2, status;
-    while (file.good()) {
-        std::getline(file, intersection1, ','); 
-        std::getline(file, intersection2, ',');
-        std::getline(file, status);
-
-        if (!intersection1.empty() && !intersection2.empty() && !status.empty()) {
-            bool isBlocked = (status == "Blocked");
-
-            // Create a new node for this road closure
-            AccidentNode* newNode = new AccidentNode(intersection1, intersection2, isBlocked);
-            
-            // Insert the new node at the end of the blocked list
-            if (isBlocked) {
-                if (head == nullptr) {
-                    head = newNode;  // If the list is empty, the new node is the first node
-                } else {
-                    AccidentNode* temp = head;
-                    while (temp->next != nullptr) {
-                        temp = temp->next;  // Traverse to the end of the list
-                    }
-                    temp->next = newNode;  // Insert the new node at the end
-                    graph.markEdgeAsBlocked(intersection1, intersection2, true);
-                }
-            } else if (status == "Under Repair") {
-                // Insert under repair intersections in the separate list at the end
-                if (underRepairHead == nullptr) {
-                    underRepairHead = newNode;  // If the list is empty, the new node is the first node
-                } else {
-                    AccidentNode* temp = underRepairHead;
-                    while (temp->next != nullptr) {
-                        temp = temp->next;  // Traverse to the end of the list
-                    }
-                    temp->next = newNode;  // Insert the new node at the end
-                    graph.markEdgesAsUnderRepaired(intersection1, intersection2, true);
-                }
-                
-            }
-
-            
-            
+    reader.skipRow(); // header
+
+    // new closures go at the end of their list
+    AccidentNode* lastBlocked = head;
+    while (lastBlocked && lastBlocked->next)
+        lastBlocked = lastBlocked->next;
+    AccidentNode* lastUnderRepair = underRepairHead;
+    while (lastUnderRepair && lastUnderRepair->next)
+        lastUnderRepair = lastUnderRepair->next;
+
+    std::vector<CsvField> fields;
+    while (reader.nextRow(fields)) {
+        if (fields.size() < 3 || fields[0].empty() || fields[1].empty())
+            continue;
+        bool isBlocked = fields[2].equals("Blocked");
+        if (!isBlocked && !fields[2].equals("Under Repair"))
+            continue; // e.g. Clear
+
+        // Create a new node for this road closure and mark its road in the graph
+        std::string intersection1 = fields[0].str(), intersection2 = fields[1].str();
+        AccidentNode* newNode = new AccidentNode(intersection1, intersection2, isBlocked);
+        if (isBlocked) {
+            (lastBlocked ? lastBlocked->next : head) = newNode;
+            lastBlocked = newNode;
+            graph.markEdgeAsBlocked(intersection1, intersection2, true);
+        } else {
+            (lastUnderRepair ? lastUnderRepair->next : underRepairHead) = newNode;
+            lastUnderRepair = newNode;
+            graph.markEdgesAsUnderRepaired(intersection1, intersection2, true);
         }
     }
-
-    file.close();
 }
 void Accident_roads::displayBlockedRoads() {
     std::cout << "Blocked Roads:\n";
@@ -107,7 +97,7 @@ void Accident_roads::displayUnderRepairRoads() {
     }
 }
 
-void Accident_roads::blockRoad(const std::string& start, const std::string& end, Graph& cityGraph) {
+void Accident_roads::blockRoad(const std::string& start, const std::string& end, Graph& cityGraph, bool display) {
     // Check if both intersections exist in the graph
     if (cityGraph.findVertex(start) == nullptr || cityGraph.findVertex(end) == nullptr) {
         std::cout << "One or both intersections do not exist in the graph.\n";
@@ -130,6 +120,28 @@ void Accident_roads::blockRoad(const std::string& start, const std::string& end,
     }
 
     // Display the updated list of blocked roads
-    std::cout << "\nUpdated Blocked Roads:\n";
-    displayBlockedRoads();
+    if (display) {
+        std::cout << "\nUpdated Blocked Roads:\n";
+        displayBlockedRoads();
+    }
+}
+
+bool Accident_roads::clearRoad(const std::string& start, const std::string& end, Graph& cityGraph) {
+    AccidentNode* previous = nullptr;
+    AccidentNode* current = head;
+    while (current && (current->intersection1 != start || current->intersection2 != end)) {
+        previous = current;
+        current = current->next;
+    }
+    if (current == nullptr)
+        return false;
+
+    // Unlink the record and reopen the road
+    if (previous)
+        previous->next = current->next;
+    else
+        head = current->next;
+    delete current;
+    cityGraph.markEdgeAsBlocked(start, end, false);
+    return true;
 }
@@ -1,6 +1,7 @@
 #ifndef ACCIDENTS_H
 #define ACCIDENTS_H
 #include <string>
+#include "memoryAccounting.h"
 
 // Forward declaration of Graph class
 class Graph;
@@ -21,7 +22,7 @@ private:
      * Each node in the linked list stores information about an accident/road closure, including the 
      * affected intersections and whether the road is blocked or not.
      */
-    struct AccidentNode {
+    struct AccidentNode : MemoryTracked<MEMORY_ACCIDENTS> {
         std::string intersection1;  /**< The name of the first intersection involved in the incident */
         std::string intersection2;  /**< The name of the second intersection involved in the incident */
         bool isBlocked;            /**< Whether the road between the intersections is blocked or not */
@@ -41,8 +42,28 @@ private:
     AccidentNode* head;  /**< Head of the linked list of blocked accident nodes */
     AccidentNode* underRepairHead;  /**< Head of the linked list of under repair accident nodes */
 
+    friend class Checkpoint;
+
 public:
-    void blockRoad(const std::string& start, const std::string& end, Graph& cityGraph);
+    /**
+     * @brief Blocks a road due to an accident and records it.
+     * 
+     * @param start The name of the start intersection of the road.
+     * @param end The name of the end intersection of the road.
+     * @param cityGraph The graph containing the road.
+     * @param display Whether to print the updated list of blocked roads.
+     */
+    void blockRoad(const std::string& start, const std::string& end, Graph& cityGraph, bool display = true);
+
+    /**
+     * @brief Reopens a blocked road and removes its record.
+     * 
+     * @param start The name of the start intersection of the road.
+     * @param end The name of the end intersection of the road.
+     * @param cityGraph The graph containing the road.
+     * @return true if the road was recorded as blocked, false otherwise.
+     */
+    bool clearRoad(const std::string& start, const std::string& end, Graph& cityGraph);
     /**
      * @brief Default constructor for the Accident_roads class.
      * 
@@ -57,6 +78,13 @@ public:
      */
     ~Accident_roads();
 
+    /**
+     * @brief Deletes every blocked and under-repair record.
+     * 
+     * The roads of the graph keep their status.
+     */
+    void clear();
+
     /**
      * @brief Load road closure data from a file and update the graph.
      * 
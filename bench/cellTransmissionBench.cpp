@@ -0,0 +1,66 @@
+// Wall time of a 24-hour Cell Transmission Model simulation of a signalized grid region.
+//
+// usage: ./bench/cellTransmissionBench [gridSide] [stepSeconds] [vehiclesPerHour]
+// Builds a gridSide x gridSide grid (150 x 150 = 22.5k intersections by default) of two-way roads
+// with travel times of 10-30 s, a signal at every intersection (60 s cycle, 25 s green, alternate
+// intersections offset by half a cycle) and a demand of vehiclesPerHour (60 by default) at every
+// intersection, then simulates 24 hours in steps of stepSeconds (5 by default). Target: under a minute.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "../compactGraph.h"
+#include "../cellTransmissionModel.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 150;
+    int stepSeconds = argc > 2 ? std::atoi(argv[2]) : 5;
+    double vehiclesPerHour = argc > 3 ? std::atof(argv[3]) : 60;
+    const int day = 24 * 3600;
+
+    // grid network, roads grouped by start intersection as CompactGraph::build() would lay them out
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> travel(10, 30);
+    CompactGraph graph;
+    graph.names.resize(side * side);
+    graph.edgeOffset.push_back(0);
+    for (int i = 0; i < side * side; i++) {
+        int r = i / side, c = i % side;
+        int neighbours[4] = {c > 0 ? i - 1 : -1, c + 1 < side ? i + 1 : -1, r > 0 ? i - side : -1, r + 1 < side ? i + side : -1};
+        for (int k = 0; k < 4; k++) {
+            if (neighbours[k] == -1)
+                continue;
+            graph.edgeSource.push_back(i);
+            graph.edgeTarget.push_back(neighbours[k]);
+            graph.travelTime.push_back(travel(rng));
+            graph.edgeFlags.push_back(0);
+        }
+        graph.edgeOffset.push_back(static_cast<int>(graph.edgeTarget.size()));
+    }
+
+    CellTransmissionModel model(stepSeconds);
+    model.build(graph);
+    for (int i = 0; i < graph.getIntersectionCount(); i++) {
+        model.setSignalPlan(i, 60, ((i / side + i % side) & 1) * 30, 25);
+        model.setDemand(i, vehiclesPerHour);
+    }
+
+    std::cout << "intersections: " << graph.getIntersectionCount() << ", roads: " << graph.getEdgeCount()
+              << ", cells: " << model.getCellCount() << ", memory: " << model.memoryUsage() / (1024.0 * 1024.0)
+              << " MiB" << std::endl;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int steps = model.run(day);
+    double elapsed = secondsSince(start);
+
+    model.printSummary();
+    std::cout << "24 h in " << steps << " steps of " << stepSeconds << " s: " << elapsed << " s wall time ("
+              << day / elapsed << "x real time, " << static_cast<double>(model.getCellCount()) * steps / elapsed / 1e6
+              << "M cell updates/s)" << (elapsed < 60 ? "" : "  -- over the one-minute target") << std::endl;
+    return 0;
+}
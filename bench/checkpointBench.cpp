@@ -0,0 +1,149 @@
+// Save and restore time of a checkpoint holding a large vehicle population.
+//
+// usage: ./bench/checkpointBench [storeVehicles] [listVehicles] [file]
+// Checkpoints a 100 x 100 grid with a signal per intersection, storeVehicles vehicles (5M by default)
+// with 15-intersection paths in a VehicleStore and listVehicles vehicles (1M by default) in the
+// Vehicles list, restores it into empty objects and checks that the restored state matches.
+// Target: a 5M-vehicle population saved and restored in under a second each.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../checkpoint.h"
+#include "../fnv1a.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Order-dependent hash of every live vehicle of a store
+static uint64_t hashStore(const VehicleStore& store) {
+    uint64_t hash = FNV1A_OFFSET_BASIS;
+    for (int slot = 0; slot < store.slotCount(); slot++) {
+        if (!store.isAlive(slot))
+            continue;
+        int length;
+        const int32_t* path = store.getPath(slot, length);
+        uint64_t values[4] = {static_cast<uint64_t>(store.getId(slot)), static_cast<uint64_t>(store.getPathPosition(slot)),
+                              static_cast<uint64_t>(path[length - 1]), store.getPriority(slot)};
+        fnv1a(hash, values, sizeof(values));
+    }
+    return hash;
+}
+
+static uint64_t hashList(Vehicles& vehicles) {
+    uint64_t hash = FNV1A_OFFSET_BASIS;
+    for (Vehicle* v = vehicles.getHead(); v; v = v->next) {
+        std::string text = v->vehicleID + v->endIntersection + v->path.back();
+        fnv1a(hash, text.data(), text.size());
+        fnv1a(hash, &v->currentIntersectionInPath, sizeof(v->currentIntersectionInPath));
+    }
+    return hash;
+}
+
+int main(int argc, char* argv[]) {
+    int storeVehicles = argc > 1 ? std::atoi(argv[1]) : 5000000;
+    int listVehicles = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    std::string filename = argc > 3 ? argv[3] : "checkpointBench.ckpt";
+    const int side = 100, hops = 15;
+
+    // grid network with a signal at every intersection
+    Graph graph;
+    TrafficLightManagement traffic;
+    std::vector<std::string> names(side * side);
+    for (int i = 0; i < side * side; i++) {
+        names[i] = "I" + std::to_string(i);
+        graph.addVertex(names[i]);
+        traffic.addSignal(new TrafficSignal("red", names[i], 30 + i % 30));
+    }
+    for (int i = 0; i < side * side; i++) {
+        int r = i / side, c = i % side;
+        if (c + 1 < side) { graph.addEdge(names[i], names[i + 1], 10 + i % 20); graph.addEdge(names[i + 1], names[i], 10 + i % 20); }
+        if (r + 1 < side) { graph.addEdge(names[i], names[i + side], 10 + i % 20); graph.addEdge(names[i + side], names[i], 10 + i % 20); }
+    }
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int32_t> intersection(0, side * side - 1);
+    const char* levels[3] = {"High", "Medium", "Low"};
+
+    Vehicles vehicles;
+    for (int i = 0; i < listVehicles; i++) {
+        vehicles.enqueue("V" + std::to_string(i), names[intersection(rng)], names[intersection(rng)], levels[i % 3]);
+        Vehicle* v = vehicles.findVehicle("V" + std::to_string(i));
+        for (int h = 1; h < hops; h++)
+            v->path.push_back(names[intersection(rng)]);
+        v->pathLength = hops;
+        v->presetPath = true;
+        v->currentIntersectionInPath = i % hops;
+    }
+
+    VehicleStore store;
+    store.reserve(storeVehicles, static_cast<std::size_t>(storeVehicles) * hops);
+    std::vector<int32_t> path(hops);
+    for (int i = 0; i < storeVehicles; i++) {
+        for (int h = 0; h < hops; h++)
+            path[h] = intersection(rng);
+        int slot = store.spawn(i, path.data(), hops, static_cast<uint8_t>(i % 3));
+        store.setCurrentEdge(slot, i % 1000);
+        for (int h = 0; h < i % hops; h++)
+            store.advance(slot);
+    }
+    for (int slot = 0; slot < storeVehicles; slot += 97)
+        store.despawn(slot);
+
+    Vehicles noVehicles;
+    noVehicles.insertAtHead("V", names[0], names[1], "Low");
+    CongestionMonitoring ht(noVehicles.getHead());
+    Accident_roads accidents;
+    accidents.blockRoad(names[0], names[1], graph, false);
+
+    std::cout << "intersections: " << graph.getVertexCount() << ", list vehicles: " << vehicles.size()
+              << ", store vehicles: " << store.size() << " (" << store.memoryUsage() / (1024.0 * 1024.0) << " MiB)" << std::endl;
+
+    // the store alone, which is what the one-second target is about
+    Graph emptyGraph;
+    Vehicles emptyVehicles;
+    TrafficLightManagement emptyTraffic;
+    Accident_roads emptyAccidents;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!Checkpoint::save(filename, emptyGraph, emptyVehicles, emptyTraffic, ht, emptyAccidents, &store))
+        return 1;
+    double storeSave = secondsSince(start);
+
+    VehicleStore restoredStore;
+    start = std::chrono::steady_clock::now();
+    if (!Checkpoint::restore(filename, emptyGraph, emptyVehicles, emptyTraffic, ht, emptyAccidents, &restoredStore))
+        return 1;
+    double storeRestore = secondsSince(start);
+    bool storeMatches = hashStore(store) == hashStore(restoredStore) && store.size() == restoredStore.size();
+
+    // everything, with the object-per-vehicle list
+    start = std::chrono::steady_clock::now();
+    if (!Checkpoint::save(filename, graph, vehicles, traffic, ht, accidents, &store))
+        return 1;
+    double fullSave = secondsSince(start);
+
+    Graph restoredGraph;
+    Vehicles restoredVehicles;
+    TrafficLightManagement restoredTraffic;
+    Accident_roads restoredAccidents;
+    start = std::chrono::steady_clock::now();
+    if (!Checkpoint::restore(filename, restoredGraph, restoredVehicles, restoredTraffic, ht, restoredAccidents, &restoredStore))
+        return 1;
+    double fullRestore = secondsSince(start);
+    bool fullMatches = storeMatches && hashList(vehicles) == hashList(restoredVehicles) &&
+                       restoredGraph.getVertexCount() == graph.getVertexCount() &&
+                       restoredGraph.getEdgeWeight(names[5], names[6]) == graph.getEdgeWeight(names[5], names[6]) &&
+                       restoredGraph.isBlocked(names[0], names[1]);
+    std::remove(filename.c_str());
+
+    std::cout << "store only:  save " << storeSave << " s, restore " << storeRestore << " s"
+              << (storeSave < 1 && storeRestore < 1 ? "" : "  -- over the one-second target") << std::endl;
+    std::cout << "full state:  save " << fullSave << " s, restore " << fullRestore << " s" << std::endl;
+    std::cout << "restored state " << (fullMatches ? "matches" : "DIFFERS") << std::endl;
+    return fullMatches ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+// Recording and replay throughput of the event log.
+//
+// usage: ./bench/eventLogBench [vehicles] [events] [log]
+// Records `events` events (20M by default) for `vehicles` vehicles (500k by default) with 30-intersection
+// paths: every second a thirtieth of the vehicles moves, in slot order as the SimulationEngine logs
+// them, and each of 400 signals changes state every 20 s. A checkpoint is taken at time 0 and every
+// 600 s. The log is then replayed to its end from the first checkpoint and the result compared with
+// the last checkpoint. Target: over 10M events/s replayed, besides the fixed cost of restoring the
+// checkpoint (measured separately by replaying to time 0).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../eventLog.h"
+#include "../checkpoint.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::vector<char> readFile(const std::string& name) {
+    std::ifstream file(name.c_str(), std::ios::binary);
+    return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+int main(int argc, char* argv[]) {
+    int vehicleCount = argc > 1 ? std::atoi(argv[1]) : 500000;
+    long long eventCount = argc > 2 ? std::atoll(argv[2]) : 20000000;
+    std::string base = argc > 3 ? argv[3] : "eventLogBench";
+    const int hops = 30, signalCount = 400, checkpointInterval = 600;
+
+    Graph graph;
+    TrafficLightManagement traffic;
+    for (int i = 0; i < signalCount; i++) {
+        graph.addVertex("I" + std::to_string(i));
+        traffic.addSignal(new TrafficSignal("red", "I" + std::to_string(i)));
+    }
+    Vehicles vehicles;
+    for (int i = 0; i < vehicleCount; i++) {
+        std::string id = "V" + std::to_string(i);
+        vehicles.insertAtHead(id, "I0", "I" + std::to_string(hops - 1), "Low");
+        Vehicle* v = vehicles.findVehicle(id);
+        for (int h = 1; h < hops; h++)
+            v->path.push_back("I" + std::to_string(h));
+        v->pathLength = hops;
+        v->presetPath = true;
+    }
+    CongestionMonitoring ht(vehicles.getHead());
+    Accident_roads accidents;
+
+    // record: the state objects follow the log as the simulation would keep them
+    std::vector<Vehicle*> vehicleAt;
+    for (Vehicle* v = vehicles.getHead(); v; v = v->next)
+        vehicleAt.push_back(v);
+    std::vector<TrafficSignal*> signalAt;
+    for (TrafficSignal* s = traffic.getHeadSignal(); s; s = s->next)
+        signalAt.push_back(s);
+
+    EventLog log;
+    if (!log.open(base) || !log.checkpoint(0, graph, vehicles, traffic, ht, accidents))
+        return 1;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double checkpointTime = 0;
+    int time = 0;
+    while (log.getRecordedEvents() < eventCount) {
+        time++;
+        for (int i = time % 30; i < vehicleCount && log.getRecordedEvents() < eventCount; i += 30) {
+            vehicleAt[i]->moveForward();
+            log.record(time, LOG_VEHICLE_MOVE, i);
+        }
+        for (int s = time % 20; s < signalCount; s += 20) {
+            const char* states[3] = {"red", "yellow", "green"};
+            int state = (time / 20 + s) % 3;
+            signalAt[s]->state = states[state];
+            signalAt[s]->temp = time;
+            log.record(time, LOG_SIGNAL_STATE, s, time, state);
+        }
+        if (time % checkpointInterval == 0) {
+            std::chrono::steady_clock::time_point checkpointStart = std::chrono::steady_clock::now();
+            log.checkpoint(time, graph, vehicles, traffic, ht, accidents);
+            checkpointTime += secondsSince(checkpointStart);
+        }
+    }
+    log.checkpoint(time, graph, vehicles, traffic, ht, accidents);
+    log.close();
+    double recordTime = secondsSince(start) - checkpointTime;
+    long long recorded = log.getRecordedEvents();
+
+    // replay everything after the first checkpoint: keep only the index entry of time 0
+    std::vector<char> index = readFile(base + ".index");
+    int lastCheckpoint = static_cast<int>(index.size() / 16) - 1;
+    std::vector<char> finalCheckpoint = readFile(base + "." + std::to_string(lastCheckpoint) + ".ckpt");
+    {
+        std::ofstream first((base + ".index").c_str(), std::ios::binary | std::ios::trunc);
+        first.write(index.data(), 16);
+    }
+
+    Graph replayGraph;
+    Vehicles replayVehicles;
+    TrafficLightManagement replayTraffic;
+    Accident_roads replayAccidents;
+    long long applied = 0;
+    start = std::chrono::steady_clock::now();
+    if (!EventLog::replay(base, 0, replayGraph, replayVehicles, replayTraffic, ht, replayAccidents))
+        return 1;
+    double restoreTime = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    if (!EventLog::replay(base, time, replayGraph, replayVehicles, replayTraffic, ht, replayAccidents, &applied))
+        return 1;
+    double replayTime = secondsSince(start);
+
+    std::string check = base + ".check";
+    Checkpoint::save(check, replayGraph, replayVehicles, replayTraffic, ht, replayAccidents);
+    bool matches = readFile(check) == finalCheckpoint;
+
+    std::remove(check.c_str());
+    std::remove((base + ".events").c_str());
+    std::remove((base + ".index").c_str());
+    for (int i = 0; i <= lastCheckpoint; i++)
+        std::remove((base + "." + std::to_string(i) + ".ckpt").c_str());
+
+    std::cout << "vehicles: " << vehicleCount << ", events: " << recorded << " over " << time << " s, log: "
+              << recorded * sizeof(LoggedEvent) / (1024.0 * 1024.0) << " MiB" << std::endl;
+    std::cout << "record: " << recorded / recordTime / 1e6 << "M events/s (plus " << checkpointTime
+              << " s for " << lastCheckpoint + 1 << " checkpoints)" << std::endl;
+    double applyTime = replayTime - restoreTime;
+    std::cout << "replay: checkpoint restore " << restoreTime << " s, then " << applied << " events in " << applyTime
+              << " s (" << applied / applyTime / 1e6 << "M events/s)"
+              << (applied / applyTime > 1e7 ? "" : "  -- under the 10M events/s target") << std::endl;
+    std::cout << "replayed state " << (matches ? "matches" : "DIFFERS") << " the last checkpoint" << std::endl;
+    return matches ? 0 : 1;
+}
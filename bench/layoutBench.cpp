@@ -0,0 +1,121 @@
+// Layout of a large road network for the visualizer.
+//
+// usage: ./bench/layoutBench [intersections] [threads] [iterations]
+// Generates a grid city of `intersections` intersections (100k by default) and times the Barnes-Hut
+// force-directed layout on 1 thread and on `threads` threads (one per hardware thread by default), then
+// loading the same layout back from the cache, and the geographic placement from an intersections.csv
+// with the generated coordinates. Also reports how well the layout keeps roads short: the mean road
+// length over the mean distance between random intersections (the lower, the more readable).
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include "../cityGenerator.h"
+#include "../compactGraph.h"
+#include "../graphLayout.h"
+#include "../parallelFor.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// mean road length over mean distance between random pairs
+static double roadStretch(const CompactGraph& graph, const GraphLayout& layout) {
+    double roads = 0, pairs = 0;
+    for (int e = 0; e < graph.getEdgeCount(); e++) {
+        int a = graph.edgeSource[e], b = graph.edgeTarget[e];
+        roads += std::hypot(layout.x[a] - layout.x[b], layout.y[a] - layout.y[b]);
+    }
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> pick(0, graph.getIntersectionCount() - 1);
+    for (int s = 0; s < 10000; s++) {
+        int a = pick(random), b = pick(random);
+        pairs += std::hypot(layout.x[a] - layout.x[b], layout.y[a] - layout.y[b]);
+    }
+    return (roads / graph.getEdgeCount()) / (pairs / 10000);
+}
+
+int main(int argc, char* argv[]) {
+    long long intersections = argc > 1 ? std::atoll(argv[1]) : 100000;
+    int threads = argc > 2 ? std::atoi(argv[2]) : defaultThreadCount();
+    int iterations = argc > 3 ? std::atoi(argv[3]) : 300;
+
+    CityOptions options;
+    options.intersections = intersections;
+    options.vehicles = 0;
+    options.closureShare = 0;
+    CityGenerator city(options);
+    city.generate();
+
+    // the CSR copy straight from the generated roads, both directions
+    CompactGraph graph;
+    long long n = city.getIntersectionCount();
+    for (long long i = 0; i < n; i++)
+        graph.names.push_back(CityGenerator::intersectionName(i));
+    graph.edgeOffset.assign(n + 1, 0);
+    for (std::size_t r = 0; r < city.roadFrom.size(); r++) {
+        graph.edgeOffset[city.roadFrom[r] + 1]++;
+        graph.edgeOffset[city.roadTo[r] + 1]++;
+    }
+    for (long long i = 0; i < n; i++)
+        graph.edgeOffset[i + 1] += graph.edgeOffset[i];
+    std::vector<int> fill(graph.edgeOffset.begin(), graph.edgeOffset.end() - 1);
+    graph.edgeSource.resize(2 * city.roadFrom.size());
+    graph.edgeTarget.resize(2 * city.roadFrom.size());
+    for (std::size_t r = 0; r < city.roadFrom.size(); r++) {
+        int forward = fill[city.roadFrom[r]]++, backward = fill[city.roadTo[r]]++;
+        graph.edgeSource[forward] = graph.edgeTarget[backward] = city.roadFrom[r];
+        graph.edgeTarget[forward] = graph.edgeSource[backward] = city.roadTo[r];
+    }
+    std::cout << "intersections: " << n << ", roads: " << graph.getEdgeCount() << ", iterations: " << iterations << std::endl;
+
+    GraphLayout layout;
+    layout.setIterations(iterations);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    layout.forceDirected(graph);
+    double serialTime = secondsSince(start);
+    std::cout << "force-directed, 1 thread:  " << serialTime << " s (road stretch " << roadStretch(graph, layout) << ")" << std::endl;
+
+    if (threads > 1) {
+        layout.setThreadCount(threads);
+        start = std::chrono::steady_clock::now();
+        layout.forceDirected(graph);
+        double parallelTime = secondsSince(start);
+        std::cout << "force-directed, " << threads << " threads: " << parallelTime << " s (" << serialTime / parallelTime << "x)" << std::endl;
+    }
+
+    // first compute() fills the cache, the second reads it
+    std::string directory = "/tmp/layoutBench";
+    layout.setCacheDirectory(directory);
+    uint64_t hash = GraphLayout::hashGraph(graph);
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx.bin", static_cast<unsigned long long>(hash));
+    std::remove((directory + name).c_str());
+    layout.compute(graph, "");
+    start = std::chrono::steady_clock::now();
+    GraphLayout::Method method = layout.compute(graph, "");
+    std::cout << "cached layout loaded: " << secondsSince(start) * 1000 << " ms"
+              << (method == GraphLayout::CACHED ? "" : "  -- not from the cache") << std::endl;
+
+    std::string coordinates = directory + "/intersections.csv";
+    {
+        std::FILE* file = std::fopen(coordinates.c_str(), "w");
+        if (!file)
+            return 1;
+        std::fprintf(file, "Intersection,X,Y\n");
+        for (long long i = 0; i < n; i++)
+            std::fprintf(file, "I%lld,%.3f,%.3f\n", i, city.x[i], city.y[i]);
+        std::fclose(file);
+    }
+    start = std::chrono::steady_clock::now();
+    method = layout.compute(graph, coordinates);
+    std::cout << "geographic placement: " << secondsSince(start) * 1000 << " ms (road stretch " << roadStretch(graph, layout) << ")"
+              << (method == GraphLayout::GEOGRAPHIC ? "" : "  -- coordinates not used") << std::endl;
+    std::remove(coordinates.c_str());
+    std::remove((directory + name).c_str());
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Step time and memory of the link queueing model with a million vehicles.
+//
+// usage: ./bench/linkModelBench [gridSide] [vehicles] [steps]
+// Builds a gridSide x gridSide grid (300 x 300 = 90k intersections by default) of two-way roads
+// with travel times of 10-30 s, spawns `vehicles` vehicles (1M by default) on random 12-hop paths
+// and runs `steps` one-second link updates with the signals of alternate intersections green.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../compactGraph.h"
+#include "../vehicleStore.h"
+#include "../linkModel.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 300;
+    int vehicles = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    int steps = argc > 3 ? std::atoi(argv[3]) : 600;
+    const int hops = 12;
+
+    // grid network, roads grouped by start intersection as CompactGraph::build() would lay them out
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> travel(10, 30);
+    CompactGraph graph;
+    graph.names.resize(side * side);
+    graph.edgeOffset.push_back(0);
+    for (int i = 0; i < side * side; i++) {
+        int r = i / side, c = i % side;
+        int neighbours[4] = {c > 0 ? i - 1 : -1, c + 1 < side ? i + 1 : -1, r > 0 ? i - side : -1, r + 1 < side ? i + side : -1};
+        for (int k = 0; k < 4; k++) {
+            if (neighbours[k] == -1)
+                continue;
+            graph.edgeSource.push_back(i);
+            graph.edgeTarget.push_back(neighbours[k]);
+            graph.travelTime.push_back(travel(rng));
+            graph.edgeFlags.push_back(0);
+        }
+        graph.edgeOffset.push_back(static_cast<int>(graph.edgeTarget.size()));
+    }
+
+    LinkModel links(2.0, 2);
+    links.build(graph);
+
+    // random walks without immediate U-turns
+    VehicleStore store;
+    store.reserve(vehicles, static_cast<std::size_t>(vehicles) * (hops + 1));
+    std::uniform_int_distribution<int> anywhere(0, side * side - 1);
+    std::vector<int32_t> path(hops + 1);
+    int placed = 0;
+    for (int v = 0; v < vehicles; v++) {
+        path[0] = anywhere(rng);
+        for (int h = 1; h <= hops; h++) {
+            int from = path[h - 1];
+            int degree = graph.edgeOffset[from + 1] - graph.edgeOffset[from];
+            int to;
+            do {
+                to = graph.edgeTarget[graph.edgeOffset[from] + rng() % degree];
+            } while (h > 1 && to == path[h - 2]);
+            path[h] = to;
+        }
+        int slot = store.spawn(v, path.data(), hops + 1);
+        int road = graph.findEdge(path[0], path[1]);
+        if (links.enter(road, slot, 0)) {
+            store.setCurrentEdge(slot, road);
+            placed++;
+        }
+    }
+
+    std::cout << "intersections: " << graph.getIntersectionCount() << ", roads: " << graph.getEdgeCount()
+              << ", vehicles on the roads: " << placed << " of " << vehicles << std::endl;
+    std::cout << "memory: queues " << links.memoryUsage() / (1024.0 * 1024.0) << " MiB, vehicles "
+              << store.memoryUsage() / (1024.0 * 1024.0) << " MiB" << std::endl;
+
+    std::vector<unsigned char> greenAt(graph.getIntersectionCount());
+    std::vector<int> moved, finished;
+    long long crossed = 0, arrived = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int t = 1; t <= steps; t++) {
+        // signals switch every 30 s, alternate intersections green
+        for (int i = 0; i < graph.getIntersectionCount(); i++)
+            greenAt[i] = ((i + t / 30) & 1) != 0;
+        moved.clear();
+        finished.clear();
+        crossed += links.step(t, greenAt, store, moved, finished);
+        arrived += finished.size();
+    }
+    double elapsed = secondsSince(start);
+
+    std::cout << "steps: " << steps << ", " << elapsed * 1000 / steps << " ms/step, "
+              << crossed << " intersection crossings, " << arrived << " arrivals, "
+              << links.getVehicleCount() << " still on the roads" << std::endl;
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Speedup of the link queueing model stepped by 1 to 64 threads over a partitioned network.
+//
+// usage: ./bench/parallelSimulationBench [gridSide] [vehicles] [steps] [maxThreads]
+// Builds a gridSide x gridSide grid (300 x 300 = 90k intersections by default) of two-way roads,
+// spawns `vehicles` vehicles (1M by default) on random 12-hop paths and, for 1, 2, 4, ... up to
+// maxThreads threads (64 by default), splits the grid into one region per thread and runs `steps`
+// one-second link updates. Every run must end in the same state; a hash of it is printed per run.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../compactGraph.h"
+#include "../fnv1a.h"
+#include "../graphPartitioner.h"
+#include "../vehicleStore.h"
+#include "../linkModel.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// FNV-1a over a sequence of integers, each hashed as 8 little-endian bytes
+static void mix(uint64_t& hash, int64_t value) {
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; i++)
+        bytes[i] = static_cast<unsigned char>(value >> (i * 8));
+    fnv1a(hash, bytes, sizeof(bytes));
+}
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 300;
+    int vehicles = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    int steps = argc > 3 ? std::atoi(argv[3]) : 200;
+    int maxThreads = argc > 4 ? std::atoi(argv[4]) : 64;
+    const int hops = 12;
+
+    // grid network, roads grouped by start intersection as CompactGraph::build() would lay them out
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> travel(10, 30);
+    CompactGraph graph;
+    graph.names.resize(side * side);
+    graph.edgeOffset.push_back(0);
+    for (int i = 0; i < side * side; i++) {
+        int r = i / side, c = i % side;
+        int neighbours[4] = {c > 0 ? i - 1 : -1, c + 1 < side ? i + 1 : -1, r > 0 ? i - side : -1, r + 1 < side ? i + side : -1};
+        for (int k = 0; k < 4; k++) {
+            if (neighbours[k] == -1)
+                continue;
+            graph.edgeSource.push_back(i);
+            graph.edgeTarget.push_back(neighbours[k]);
+            graph.travelTime.push_back(travel(rng));
+            graph.edgeFlags.push_back(0);
+        }
+        graph.edgeOffset.push_back(static_cast<int>(graph.edgeTarget.size()));
+    }
+
+    // random walks without immediate U-turns, shared by every run
+    std::uniform_int_distribution<int> anywhere(0, side * side - 1);
+    std::vector<int32_t> paths(static_cast<std::size_t>(vehicles) * (hops + 1));
+    for (int v = 0; v < vehicles; v++) {
+        int32_t* path = &paths[static_cast<std::size_t>(v) * (hops + 1)];
+        path[0] = anywhere(rng);
+        for (int h = 1; h <= hops; h++) {
+            int from = path[h - 1];
+            int degree = graph.edgeOffset[from + 1] - graph.edgeOffset[from];
+            int to;
+            do {
+                to = graph.edgeTarget[graph.edgeOffset[from] + rng() % degree];
+            } while (h > 1 && to == path[h - 2]);
+            path[h] = to;
+        }
+    }
+
+    std::cout << "intersections: " << graph.getIntersectionCount() << ", roads: " << graph.getEdgeCount()
+              << ", vehicles: " << vehicles << ", steps: " << steps << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(10) << "cut" << std::setw(11) << "imbalance"
+              << std::setw(14) << "partition ms" << std::setw(10) << "ms/step" << std::setw(9) << "speedup"
+              << std::setw(20) << "state hash" << std::endl;
+
+    std::vector<unsigned char> greenAt(graph.getIntersectionCount());
+    double baseline = 0;
+    uint64_t baselineHash = 0;
+    bool identical = true;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        GraphPartitioner partitioner;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<int> regionOf = partitioner.partition(graph, threads);
+        double partitionTime = secondsSince(start);
+
+        LinkModel links(2.0, 2);
+        links.build(graph);
+        links.setRegions(regionOf, threads);
+        links.setThreadCount(threads);
+
+        VehicleStore store;
+        store.reserve(vehicles, paths.size());
+        for (int v = 0; v < vehicles; v++) {
+            const int32_t* path = &paths[static_cast<std::size_t>(v) * (hops + 1)];
+            int slot = store.spawn(v, path, hops + 1);
+            int road = graph.findEdge(path[0], path[1]);
+            if (links.enter(road, slot, 0))
+                store.setCurrentEdge(slot, road);
+        }
+
+        uint64_t hash = FNV1A_OFFSET_BASIS;
+        std::vector<int> moved, finished;
+        start = std::chrono::steady_clock::now();
+        for (int t = 1; t <= steps; t++) {
+            // signals switch every 30 s, alternate intersections green
+            for (int i = 0; i < graph.getIntersectionCount(); i++)
+                greenAt[i] = ((i + t / 30) & 1) != 0;
+            moved.clear();
+            finished.clear();
+            mix(hash, links.step(t, greenAt, store, moved, finished));
+            // the vehicles that moved come in no particular order
+            long long movedSum = 0;
+            for (size_t i = 0; i < moved.size(); i++)
+                movedSum += static_cast<long long>(moved[i]) * moved[i];
+            mix(hash, static_cast<long long>(moved.size()));
+            mix(hash, movedSum);
+            for (size_t i = 0; i < finished.size(); i++)
+                mix(hash, -finished[i]);
+        }
+        double elapsed = secondsSince(start);
+        for (int link = 0; link < links.getLinkCount(); link++)
+            mix(hash, links.getQueueLength(link));
+        for (int slot = 0; slot < store.slotCount(); slot++) {
+            mix(hash, store.getCurrentEdge(slot));
+            mix(hash, store.getPathPosition(slot));
+        }
+
+        if (threads == 1) {
+            baseline = elapsed;
+            baselineHash = hash;
+        } else if (hash != baselineHash) {
+            identical = false;
+        }
+        std::cout << std::setw(8) << threads << std::setw(10) << partitioner.getEdgeCut()
+                  << std::setw(11) << std::fixed << std::setprecision(3) << partitioner.getImbalance()
+                  << std::setw(14) << std::setprecision(1) << partitionTime * 1000
+                  << std::setw(10) << std::setprecision(2) << elapsed * 1000 / steps
+                  << std::setw(9) << baseline / elapsed
+                  << std::setw(20) << std::hex << hash << std::dec << std::endl;
+    }
+
+    std::cout << (identical ? "every run ended in the same state" : "ERROR: runs ended in different states") << std::endl;
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// Startup time of a large road network: binary snapshot against CSV.
+//
+// usage: ./bench/roadSnapshotBench [intersections] [directory]
+// Generates a grid of `intersections` intersections (5M by default, about 20M roads) and writes it to
+// directory (/tmp by default) both as road_network.csv and as a snapshot. It then times opening the
+// snapshot and looking up intersections in it (what a run needs before its first step), scanning
+// every road from the mapping, building the linked Graph from the snapshot, and, for comparison,
+// loading the same network with Graph::loadRoadData. Target: the snapshot usable in under 100 ms.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../cityGenerator.h"
+#include "../compactGraph.h"
+#include "../graph.h"
+#include "../roadSnapshot.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    long long intersections = argc > 1 ? std::atoll(argv[1]) : 5000000;
+    std::string directory = argc > 2 ? argv[2] : "/tmp";
+    std::string csv = directory + "/road_network.csv", snapshotFile = directory + "/road_network.bin";
+
+    CityOptions options;
+    options.intersections = intersections;
+    options.vehicles = 0;
+    options.closureShare = 0;
+    CityGenerator city(options);
+    city.generate();
+
+    // the CSR copy straight from the generated roads, both directions, without an intermediate Graph
+    CompactGraph compact;
+    long long n = city.getIntersectionCount();
+    for (long long i = 0; i < n; i++)
+        compact.names.push_back(CityGenerator::intersectionName(i));
+    compact.edgeOffset.assign(n + 1, 0);
+    for (std::size_t r = 0; r < city.roadFrom.size(); r++) {
+        compact.edgeOffset[city.roadFrom[r] + 1]++;
+        compact.edgeOffset[city.roadTo[r] + 1]++;
+    }
+    for (long long i = 0; i < n; i++)
+        compact.edgeOffset[i + 1] += compact.edgeOffset[i];
+    std::vector<int> fill(compact.edgeOffset.begin(), compact.edgeOffset.end() - 1);
+    compact.edgeTarget.resize(2 * city.roadFrom.size());
+    compact.travelTime.resize(compact.edgeTarget.size());
+    compact.edgeFlags.assign(compact.edgeTarget.size(), 0);
+    for (std::size_t r = 0; r < city.roadFrom.size(); r++) {
+        int forward = fill[city.roadFrom[r]]++, backward = fill[city.roadTo[r]]++;
+        compact.edgeTarget[forward] = city.roadTo[r];
+        compact.edgeTarget[backward] = city.roadFrom[r];
+        compact.travelTime[forward] = compact.travelTime[backward] = city.travelTime[r];
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!RoadSnapshot::write(snapshotFile, compact))
+        return 1;
+    double writeTime = secondsSince(start);
+    compact = CompactGraph();
+
+    // road_network.csv in the dataset format, for the comparison
+    {
+        std::FILE* file = std::fopen(csv.c_str(), "w");
+        if (!file)
+            return 1;
+        std::fprintf(file, "Intersection1,Intersection2,TravelTime\n");
+        for (std::size_t r = 0; r < city.roadFrom.size(); r++) {
+            std::fprintf(file, "I%d,I%d,%d\n", city.roadFrom[r], city.roadTo[r], city.travelTime[r]);
+            std::fprintf(file, "I%d,I%d,%d\n", city.roadTo[r], city.roadFrom[r], city.travelTime[r]);
+        }
+        std::fclose(file);
+    }
+    std::vector<std::string> lookups;
+    for (int i = 0; i < 1000; i++)
+        lookups.push_back(CityGenerator::intersectionName((i * 7919LL) % n));
+    long long roads = 2 * city.getRoadCount();
+    city = CityGenerator(options); // frees the generated arrays
+
+    start = std::chrono::steady_clock::now();
+    RoadSnapshot snapshot;
+    if (!snapshot.open(snapshotFile))
+        return 1;
+    long long found = 0;
+    for (std::size_t i = 0; i < lookups.size(); i++)
+        found += snapshot.findIntersection(lookups[i]) != -1;
+    double openTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    long long totalTime = 0;
+    for (int e = 0; e < snapshot.getEdgeCount(); e++)
+        totalTime += snapshot.travelTime[e] + snapshot.edgeTarget[e];
+    double scanTime = secondsSince(start);
+
+    Graph graph;
+    start = std::chrono::steady_clock::now();
+    snapshot.copyTo(graph);
+    double copyTime = secondsSince(start);
+    graph.clear();
+    snapshot.close();
+
+    start = std::chrono::steady_clock::now();
+    graph.loadRoadData(csv);
+    double csvTime = secondsSince(start);
+    graph.clear();
+
+    std::cout << "intersections: " << n << ", roads: " << roads << std::endl;
+    std::cout << "snapshot written in " << writeTime << " s" << std::endl;
+    std::cout << "snapshot open + " << lookups.size() << " lookups (" << found << " found): " << openTime * 1000 << " ms"
+              << (openTime < 0.1 ? "" : "  -- over the 100 ms target") << std::endl;
+    std::cout << "scan of every road from the mapping: " << scanTime * 1000 << " ms (checksum " << totalTime << ")" << std::endl;
+    std::cout << "linked Graph built from the snapshot: " << copyTime << " s" << std::endl;
+    std::cout << "linked Graph loaded from CSV:         " << csvTime << " s" << std::endl;
+    std::remove(csv.c_str());
+    std::remove(snapshotFile.c_str());
+    return 0;
+}
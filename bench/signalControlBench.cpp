@@ -0,0 +1,71 @@
+// Control-cycle latency of the max-pressure signal controller.
+//
+// usage: ./bench/signalControlBench [gridSide] [cycles]
+// Builds a gridSide x gridSide grid of intersections (200 x 200 = 40k by default) connected by
+// two-way roads, fills the roads with random queues and times runControlCycle() for 1, 2, 4, ...
+// threads up to the number of hardware threads.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../maxPressureController.h"
+#include "../parallelFor.h"
+
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 200;
+    int cycles = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    MaxPressureController controller;
+    for (int i = 0; i < side * side; i++)
+        controller.addIntersection("I" + std::to_string(i));
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int here = r * side + c;
+            if (c + 1 < side) {
+                controller.addRoad(here, here + 1);
+                controller.addRoad(here + 1, here);
+            }
+            if (r + 1 < side) {
+                controller.addRoad(here, here + side);
+                controller.addRoad(here + side, here);
+            }
+        }
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> vehicles(0, 30);
+    for (int road = 0; road < controller.getRoadCount(); road++)
+        controller.setQueue(road, vehicles(rng));
+
+    std::cout << "intersections: " << controller.getIntersectionCount()
+              << ", roads: " << controller.getRoadCount() << ", cycles: " << cycles << std::endl;
+
+    controller.runControlCycle(1); // warm-up, also builds the incoming/outgoing road lists
+
+    int maxThreads = defaultThreadCount();
+    // 1, 2, 4, ... threads, ending with maxThreads when it is not a power of two
+    for (int threads = 1; threads <= maxThreads;
+         threads = threads == maxThreads ? maxThreads + 1 : std::min(threads * 2, maxThreads)) {
+        std::vector<double> samples;
+        for (int i = 0; i < cycles; i++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            controller.runControlCycle(threads);
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        double total = 0;
+        for (size_t i = 0; i < samples.size(); i++)
+            total += samples[i];
+
+        std::cout << "threads: " << threads
+                  << "  mean: " << total / samples.size() << " us"
+                  << "  p50: " << samples[samples.size() / 2] << " us"
+                  << "  p99: " << samples[(samples.size() * 99) / 100] << " us" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Throughput of the headless discrete-event simulation engine.
+//
+// usage: ./bench/simulationEngineBench [vehicles] [seconds]
+// Loads the road network and signals of dataset/, spawns `vehicles` vehicles (20k by default)
+// between random intersections on their best path and simulates `seconds` seconds (1 hour by
+// default) without a window, with a few incidents blocking roads for a while. Run from the
+// repository root so the dataset files are found.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "../graph.h"
+#include "../vehicles.h"
+#include "../Route.h"
+#include "../accidents.h"
+#include "../congestionMonitoring.h"
+#include "../trafficLightManagement.h"
+#include "../simulationEngine.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int vehicleCount = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int duration = argc > 2 ? std::atoi(argv[2]) : 3600;
+
+    Graph cityGraph;
+    cityGraph.loadRoadData("dataset/road_network.csv");
+    Accident_roads accidentManager;
+    GPS gps(&cityGraph);
+
+    std::string names[250];  // GPS handles up to 250 intersections
+    int intersectionCount = 0;
+    cityGraph.getVertices(names, intersectionCount);
+    if (intersectionCount < 2) {
+        std::cerr << "No road network found, run from the repository root" << std::endl;
+        return 1;
+    }
+
+    // vehicles between random pairs of intersections; paths are computed once per pair
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, intersectionCount - 1);
+    std::map<std::pair<int, int>, std::string> paths;
+    Vehicles vehicles;
+    std::streambuf* messages = std::cout.rdbuf(nullptr);
+    for (int i = 0; i < vehicleCount; i++) {
+        int start = pick(rng), end = pick(rng);
+        std::pair<int, int> key(start, end);
+        if (!paths.count(key))
+            paths[key] = gps.rerouteEmergencyVehicle(names[start], names[end]);
+        vehicles.enqueue("V" + std::to_string(i), names[start], names[end], i % 10 == 0 ? "High" : "Low");
+        if (!paths[key].empty())
+            vehicles.findVehicle("V" + std::to_string(i))->setPath(paths[key]);
+    }
+    std::cout.rdbuf(messages);
+
+    CongestionMonitoring ht(vehicles.getHead());
+    TrafficLightManagement traffic;
+    traffic.makeTrafficSignals();
+    traffic.updateTrafficSignals(ht, cityGraph);
+
+    SimulationEngine engine(cityGraph, vehicles, traffic, ht, accidentManager);
+    engine.setLinkCapacity(20.0, 10); // multi-lane arterials, the dataset network is small
+    engine.scheduleIncident(600, "A", "B", 900);
+    engine.scheduleIncident(1200, "D", "E", 600);
+    engine.reset();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    long long processed = engine.run(duration);
+    double wallTime = secondsSince(start);
+
+    engine.printSummary();
+    std::cout << "wall time: " << wallTime << " s, " << processed / wallTime / 1e6 << " M events/s, "
+              << duration / wallTime << "x real time" << std::endl;
+    return 0;
+}
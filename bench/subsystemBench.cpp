@@ -0,0 +1,320 @@
+// Microbenchmarks and macro scenarios of every subsystem's hot path, written as JSON.
+//
+// usage: ./bench/subsystemBench [largest] > results.json
+// Generates grid cities of largest / 16, largest / 4 and largest intersections (16384 by default)
+// with CityGenerator, writes them to a temporary dataset/ directory and times, at each size:
+//   micro  graph.loadRoadData, graph.findVertex, congestion.makeHashTable, congestion.getTravelTime,
+//          heap.makeHeap, signal.update
+//   macro  city.load (every loader of the dashboard), simulation.tick (one simulated second of the
+//          SimulationEngine with vehicles on their shortest paths)
+// The GPS keeps its intersections in fixed arrays of 250, so routing is timed on grids small enough
+// for each variant: gps.printAllPaths and gps.getPathAsString (all-paths DFS) on 9 to 25 intersections,
+// gps.printAllPathsDijkstra on 4 to 16 and gps.rerouteEmergencyVehicle (A*) on 64 to 225.
+// The congestion hash table is keyed by the first letter of the intersection names, so its trips are
+// relabelled onto the letters A to Z.
+//
+// Every record gives the operation, its kind, the network size, the iterations timed and the mean
+// nanoseconds per operation; progress goes to stderr, so stdout is valid JSON.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../cityGenerator.h"
+#include "../graph.h"
+#include "../vehicles.h"
+#include "../Route.h"
+#include "../accidents.h"
+#include "../congestionMonitoring.h"
+#include "../congestionMaxHeap.h"
+#include "../trafficLightManagement.h"
+#include "../simulationEngine.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct BenchRecord {
+    std::string name;
+    std::string kind;
+    long long intersections;
+    long long roads;
+    long long iterations;
+    double seconds;
+};
+
+static std::vector<BenchRecord> records;
+static volatile long long sink; // keeps the results of the timed calls alive
+
+// Calls body (which performs opsPerCall operations) until minSeconds have passed, at least once
+template <typename Body>
+static void measure(const std::string& name, const std::string& kind, const CityGenerator& city,
+                    long long opsPerCall, double minSeconds, Body body) {
+    std::streambuf* messages = std::cout.rdbuf(nullptr); // the GPS and loaders print as they go
+    long long calls = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    do {
+        body();
+        calls++;
+        elapsed = secondsSince(start);
+    } while (elapsed < minSeconds);
+    std::cout.rdbuf(messages);
+
+    BenchRecord record;
+    record.name = name;
+    record.kind = kind;
+    record.intersections = city.getIntersectionCount();
+    record.roads = 2 * city.getRoadCount();
+    record.iterations = calls * opsPerCall;
+    record.seconds = elapsed;
+    records.push_back(record);
+    std::cerr << name << " @ " << record.intersections << ": " << elapsed * 1e9 / record.iterations << " ns/op" << std::endl;
+}
+
+static CityGenerator makeCity(long long intersections, const std::string& directory) {
+    CityOptions options;
+    options.layout = CITY_GRID;
+    options.intersections = intersections;
+    options.vehicles = intersections;
+    CityGenerator city(options);
+    city.generate();
+    if (!directory.empty() && !city.write(directory)) {
+        std::cerr << "Unable to write the generated city to " << directory << std::endl;
+        std::exit(1);
+    }
+    return city;
+}
+
+// Hop-shortest path of every trip, for the vehicles the simulation moves
+static std::vector<std::vector<int32_t> > shortestPaths(const CityGenerator& city, int trips) {
+    long long n = city.getIntersectionCount();
+    std::vector<int32_t> start(n + 1, 0), target(2 * city.roadFrom.size());
+    for (std::size_t r = 0; r < city.roadFrom.size(); r++) {
+        start[city.roadFrom[r] + 1]++;
+        start[city.roadTo[r] + 1]++;
+    }
+    for (long long i = 0; i < n; i++)
+        start[i + 1] += start[i];
+    std::vector<int32_t> fill(start.begin(), start.end() - 1);
+    for (std::size_t r = 0; r < city.roadFrom.size(); r++) {
+        target[fill[city.roadFrom[r]]++] = city.roadTo[r];
+        target[fill[city.roadTo[r]]++] = city.roadFrom[r];
+    }
+
+    std::vector<std::vector<int32_t> > paths;
+    std::vector<int32_t> from(n);
+    for (int t = 0; t < trips && t < static_cast<int>(city.tripStart.size()); t++) {
+        std::fill(from.begin(), from.end(), -1);
+        std::queue<int32_t> frontier;
+        frontier.push(city.tripStart[t]);
+        from[city.tripStart[t]] = city.tripStart[t];
+        while (!frontier.empty() && from[city.tripEnd[t]] == -1) {
+            int32_t i = frontier.front();
+            frontier.pop();
+            for (int32_t e = start[i]; e < start[i + 1]; e++) {
+                if (from[target[e]] == -1) {
+                    from[target[e]] = i;
+                    frontier.push(target[e]);
+                }
+            }
+        }
+        std::vector<int32_t> path;
+        for (int32_t i = city.tripEnd[t]; from[i] != -1; i = from[i]) {
+            path.push_back(i);
+            if (i == city.tripStart[t])
+                break;
+        }
+        paths.push_back(std::vector<int32_t>(path.rbegin(), path.rend()));
+    }
+    return paths;
+}
+
+static void benchNetwork(long long intersections, const std::string& root) {
+    std::string dataset = root + "/dataset";
+    CityGenerator city = makeCity(intersections, dataset);
+    long long n = city.getIntersectionCount();
+    std::mt19937 rng(7);
+
+    // the loaders read dataset/ in the working directory
+    char cwd[4096];
+    if (!getcwd(cwd, sizeof(cwd)) || chdir(root.c_str()) != 0) {
+        std::cerr << "Unable to enter " << root << std::endl;
+        std::exit(1);
+    }
+
+    // micro: loading and looking up the road network
+    Graph graph;
+    measure("graph.loadRoadData", "micro", city, 1, 0.5, [&]() {
+        graph.clear();
+        graph.loadRoadData("dataset/road_network.csv");
+        sink = graph.getVertexCount();
+    });
+    std::vector<std::string> lookups;
+    for (int i = 0; i < 1000; i++)
+        lookups.push_back(CityGenerator::intersectionName(rng() % n));
+    measure("graph.findVertex", "micro", city, lookups.size(), 0.2, [&]() {
+        for (std::size_t i = 0; i < lookups.size(); i++)
+            sink = graph.findVertex(lookups[i]) != nullptr;
+    });
+
+    // micro: congestion table, heap and signal control over a vehicle per trip
+    Vehicles vehicles;
+    for (std::size_t t = 0; t < city.tripStart.size(); t++) {
+        std::string id = "V" + std::to_string(t);
+        std::string from(1, static_cast<char>('A' + city.tripStart[t] % 26));
+        std::string to(1, static_cast<char>('A' + city.tripEnd[t] % 26));
+        vehicles.enqueue(id, from, to, "Low");
+        Vehicle* vehicle = vehicles.findVehicle(id);
+        vehicle->path.push_back(to);
+        vehicle->pathLength = 2;
+        vehicle->presetPath = true;
+    }
+    CongestionMonitoring ht(vehicles.getHead());
+    measure("congestion.makeHashTable", "micro", city, 1, 0.2, [&]() {
+        ht.makeHashTable(vehicles.getHead());
+    });
+    measure("congestion.getTravelTime", "micro", city, 26 * 26, 0.2, [&]() {
+        long long total = 0;
+        for (char a = 'A'; a <= 'Z'; a++)
+            for (char b = 'A'; b <= 'Z'; b++)
+                total += ht.getTravelTime(a, b, 60);
+        sink = total;
+    });
+    CongestionMaxHeap heap;
+    measure("heap.makeHeap", "micro", city, 1, 0.2, [&]() {
+        heap.makeHeap(ht.hashTable, HASH_TABLE_SIZE);
+        sink = heap.mostCongested() != nullptr;
+    });
+
+    TrafficLightManagement traffic;
+    traffic.makeTrafficSignals();
+    traffic.updateTrafficSignals(ht, graph); // builds the controller once
+    measure("signal.update", "micro", city, 1, 0.2, [&]() {
+        traffic.updateTrafficSignals(ht, graph);
+    });
+
+    // macro: every loader, as the dashboard starts
+    measure("city.load", "macro", city, 1, 0.5, [&]() {
+        Graph loaded;
+        loaded.loadRoadData("dataset/road_network.csv");
+        Accident_roads closures;
+        closures.loadRoadData(loaded);
+        Vehicles loadedVehicles;
+        loadedVehicles.loadAndReadCSVs();
+        TrafficLightManagement signals;
+        signals.makeTrafficSignals();
+        sink = loadedVehicles.size();
+    });
+
+    // macro: one simulated second with up to 5000 vehicles on their shortest paths
+    std::vector<std::vector<int32_t> > paths = shortestPaths(city, 5000);
+    Vehicles travellers;
+    for (std::size_t t = 0; t < paths.size(); t++) {
+        if (paths[t].size() < 2)
+            continue;
+        std::string id = "V" + std::to_string(t);
+        travellers.enqueue(id, CityGenerator::intersectionName(paths[t].front()),
+                           CityGenerator::intersectionName(paths[t].back()), "Low");
+        Vehicle* vehicle = travellers.findVehicle(id);
+        for (std::size_t h = 1; h < paths[t].size(); h++)
+            vehicle->path.push_back(CityGenerator::intersectionName(paths[t][h]));
+        vehicle->pathLength = static_cast<int>(paths[t].size());
+        vehicle->presetPath = true;
+    }
+    Accident_roads accidents;
+    SimulationEngine engine(graph, travellers, traffic, ht, accidents);
+    engine.reset();
+    engine.run(60); // vehicles on the roads and signals cycling
+    measure("simulation.tick", "macro", city, 1, 0.5, [&]() {
+        engine.run(engine.getTime() + 1);
+    });
+    if (chdir(cwd) != 0) {
+        std::cerr << "Unable to return to " << cwd << std::endl;
+        std::exit(1);
+    }
+}
+
+static void benchRouting(const std::string& name, const std::vector<long long>& sizes, int trips,
+                         void (*route)(GPS&, const std::string&, const std::string&)) {
+    for (std::size_t s = 0; s < sizes.size(); s++) {
+        CityGenerator city = makeCity(sizes[s], "");
+        Graph graph;
+        for (long long i = 0; i < city.getIntersectionCount(); i++)
+            graph.addVertex(CityGenerator::intersectionName(i));
+        for (std::size_t r = 0; r < city.roadFrom.size(); r++) {
+            graph.addEdge(CityGenerator::intersectionName(city.roadFrom[r]), CityGenerator::intersectionName(city.roadTo[r]), city.travelTime[r]);
+            graph.addEdge(CityGenerator::intersectionName(city.roadTo[r]), CityGenerator::intersectionName(city.roadFrom[r]), city.travelTime[r]);
+        }
+        GPS gps(&graph);
+        gps.setPathCacheCapacity(0); // time the search, not the path cache
+        measure(name, "micro", city, trips, 0.2, [&]() {
+            for (int t = 0; t < trips; t++)
+                route(gps, CityGenerator::intersectionName(city.tripStart[t]), CityGenerator::intersectionName(city.tripEnd[t]));
+        });
+    }
+}
+
+static void printAllPaths(GPS& gps, const std::string& start, const std::string& end) {
+    gps.printAllPaths(start, end);
+}
+
+static void getPathAsString(GPS& gps, const std::string& start, const std::string& end) {
+    sink = gps.getPathAsString(start, end).size();
+}
+
+static void printAllPathsDijkstra(GPS& gps, const std::string& start, const std::string& end) {
+    gps.printAllPathsDijkstra(start, end);
+}
+
+static void rerouteEmergencyVehicle(GPS& gps, const std::string& start, const std::string& end) {
+    sink = gps.rerouteEmergencyVehicle(start, end).size();
+}
+
+int main(int argc, char* argv[]) {
+    long long largest = argc > 1 ? std::atoll(argv[1]) : 16384;
+    if (largest < 64) {
+        std::cerr << "usage: " << argv[0] << " [largest network, at least 64 intersections]" << std::endl;
+        return 1;
+    }
+
+    char root[] = "/tmp/subsystemBench.XXXXXX";
+    if (!mkdtemp(root) || mkdir((std::string(root) + "/dataset").c_str(), 0755) != 0) {
+        std::cerr << "Unable to create a temporary directory" << std::endl;
+        return 1;
+    }
+    long long sizes[3] = {largest / 16, largest / 4, largest};
+    for (int s = 0; s < 3; s++)
+        benchNetwork(sizes[s], root);
+    const char* files[] = {"road_network.csv", "traffic_signals.csv", "vehicles.csv", "emergency_vehicles.csv",
+                           "road_closures.csv", "intersections.csv"};
+    for (int f = 0; f < 6; f++)
+        std::remove((std::string(root) + "/dataset/" + files[f]).c_str());
+    rmdir((std::string(root) + "/dataset").c_str());
+    rmdir(root);
+
+    std::vector<long long> tiny = {4, 9, 16}, small = {9, 16, 25}, medium = {64, 144, 225};
+    benchRouting("gps.printAllPaths", small, 4, printAllPaths);
+    benchRouting("gps.getPathAsString", small, 4, getPathAsString);
+    benchRouting("gps.printAllPathsDijkstra", tiny, 4, printAllPathsDijkstra);
+    benchRouting("gps.rerouteEmergencyVehicle", medium, 16, rerouteEmergencyVehicle);
+
+    std::cout << "{\n  \"suite\": \"subsystemBench\",\n  \"layout\": \"grid\",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < records.size(); i++) {
+        const BenchRecord& r = records[i];
+        std::ostringstream line;
+        line << "    {\"name\": \"" << r.name << "\", \"kind\": \"" << r.kind << "\", \"intersections\": " << r.intersections
+             << ", \"roads\": " << r.roads << ", \"iterations\": " << r.iterations << ", \"seconds\": " << r.seconds
+             << ", \"nsPerOp\": " << r.seconds * 1e9 / r.iterations << "}" << (i + 1 < records.size() ? "," : "");
+        std::cout << line.str() << "\n";
+    }
+    std::cout << "  ]\n}" << std::endl;
+    return 0;
+}
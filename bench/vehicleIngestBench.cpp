@@ -0,0 +1,125 @@
+// Ingest, lookup and dispatch throughput of the Vehicles list with its ID hash index and priority buckets.
+//
+// usage: ./bench/vehicleIngestBench [vehicles]
+// Enqueues `vehicles` vehicles (1M by default) with unique IDs and mixed priorities, looks every
+// one of them up by ID, re-inserts a few duplicates to check they are rejected, deletes half of
+// them by ID and drains the rest in priority order. Every step should scale linearly with the
+// number of vehicles.
+//
+// It then checks the priority buckets: after positional inserts that interleave the priorities,
+// and again after a checkpoint round trip, dequeue(priority) must drain every vehicle of each
+// priority in list order. The exit status is 1 if it does not.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../vehicles.h"
+#include "../checkpoint.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Drains every bucket with dequeue(priority); returns the number of vehicles left behind or served
+// out of list order
+static int drainBuckets(Vehicles& list) {
+    std::vector<Vehicle*> order;
+    for (Vehicle* vehicle = list.getHead(); vehicle != nullptr; vehicle = vehicle->next)
+        order.push_back(vehicle);
+    int errors = 0;
+    for (int priority = 0; priority < PRIORITY_LEVELS; priority++) {
+        size_t next = 0;
+        while (Vehicle* vehicle = list.dequeue(static_cast<VehiclePriority>(priority))) {
+            while (next < order.size() && order[next]->priority != priority)
+                next++;
+            if (vehicle->priority != priority || next == order.size() || order[next] != vehicle)
+                errors++;
+            next++;
+            delete vehicle;
+        }
+    }
+    return errors + list.size();
+}
+
+int main(int argc, char* argv[]) {
+    int vehicles = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const char* levels[] = {"High", "medium", "Low", "low"};
+
+    std::vector<std::string> ids(vehicles);
+    for (int i = 0; i < vehicles; i++)
+        ids[i] = "V" + std::to_string(i);
+
+    Vehicles list;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < vehicles; i++)
+        list.enqueue(ids[i], "A", "Z", levels[i % 4]);
+    double ingestTime = secondsSince(start);
+    std::cout << "ingest: " << list.size() << " vehicles in " << ingestTime << " s ("
+              << vehicles / ingestTime / 1e6 << " M vehicles/s)" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    int found = 0;
+    for (int i = 0; i < vehicles; i++)
+        found += list.findVehicle(ids[i]) != nullptr ? 1 : 0;
+    std::cout << "lookup: " << found << " found in " << secondsSince(start) << " s" << std::endl;
+
+    // duplicates are rejected with a message per vehicle, so only try a few
+    std::streambuf* errors = std::cerr.rdbuf(nullptr);
+    int duplicates = vehicles < 1000 ? vehicles : 1000;
+    for (int i = 0; i < duplicates; i++)
+        list.enqueue(ids[i], "A", "Z", "Low");
+    std::cerr.rdbuf(errors);
+    std::cout << "after " << duplicates << " duplicate inserts: " << list.size() << " vehicles" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = vehicles - 1; i >= 0; i -= 2)
+        list.deleteAtID(ids[i]);
+    std::cout << "delete half by ID: " << secondsSince(start) << " s, " << list.size() << " left" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    int drained = 0, outOfOrder = 0;
+    int lastPriority = PRIORITY_HIGH;
+    while (Vehicle* vehicle = list.dequeue()) {
+        if (vehicle->priority < lastPriority)
+            outOfOrder++;
+        lastPriority = vehicle->priority;
+        delete vehicle;
+        drained++;
+    }
+    std::cout << "drain: " << drained << " vehicles in " << secondsSince(start) << " s, "
+              << outOfOrder << " out of priority order" << std::endl;
+
+    // positional inserts interleave the priorities, so no bucket is a contiguous span of the list
+    int mixed = vehicles < 10000 ? vehicles : 10000;
+    for (int i = 0; i < mixed; i++) {
+        if (i % 3 == 0)
+            list.insertAtHead(ids[i], "A", "Z", levels[i % 4]);
+        else if (i % 3 == 1)
+            list.insertAfterPosition(list.size() / 2, ids[i], "A", "Z", levels[i % 4]);
+        else
+            list.insertAfterID(ids[i / 2], ids[i], "A", "Z", levels[i % 4]);
+    }
+    int inserted = list.size();
+    int bucketErrors = drainBuckets(list);
+    std::cout << "bucket drain after " << inserted << " positional inserts: " << bucketErrors << " errors" << std::endl;
+
+    // a restored list must rebuild the same buckets
+    for (int i = 0; i < mixed; i++)
+        list.insertAfterPosition(i % 7 == 0 ? 0 : list.size() / 3, ids[i], "A", "Z", levels[i % 4]);
+    Graph graph;
+    TrafficLightManagement traffic;
+    CongestionMonitoring ht(list.getHead());
+    Accident_roads accidents;
+    std::string file = "vehicleIngestBench.ckpt";
+    Vehicles restored;
+    if (!Checkpoint::save(file, graph, list, traffic, ht, accidents) ||
+        !Checkpoint::restore(file, graph, restored, traffic, ht, accidents))
+        return 1;
+    std::remove(file.c_str());
+    int restoreErrors = restored.size() == list.size() ? drainBuckets(restored) : restored.size() + 1;
+    std::cout << "bucket drain after restoring " << list.size() << " vehicles: " << restoreErrors << " errors" << std::endl;
+    return bucketErrors == 0 && restoreErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+// Memory footprint and spawn/despawn throughput of the structure-of-arrays vehicle store.
+//
+// usage: ./bench/vehicleStoreBench [vehicles] [hops]
+// Spawns `vehicles` vehicles (5M by default) with paths of `hops` intersections (15 by default),
+// reports the bytes used per vehicle, then despawns every other vehicle and spawns them again to
+// exercise the free list and the path arena compaction.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../vehicleStore.h"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int vehicles = argc > 1 ? std::atoi(argv[1]) : 5000000;
+    int hops = argc > 2 ? std::atoi(argv[2]) : 15;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int32_t> intersection(0, 1000000);
+    std::vector<int32_t> path(hops);
+
+    VehicleStore store;
+    store.reserve(vehicles, static_cast<std::size_t>(vehicles) * hops);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < vehicles; i++) {
+        for (int h = 0; h < hops; h++)
+            path[h] = intersection(rng);
+        store.spawn(i, path.data(), hops, static_cast<uint8_t>(i % 3));
+    }
+    double spawnTime = secondsSince(start);
+
+    std::cout << "vehicles: " << store.size() << ", path length: " << hops << std::endl;
+    std::cout << "spawn: " << spawnTime << " s (" << vehicles / spawnTime / 1e6 << " M vehicles/s)" << std::endl;
+    std::cout << "memory: " << store.memoryUsage() / (1024.0 * 1024.0) << " MiB, "
+              << static_cast<double>(store.memoryUsage()) / vehicles << " bytes/vehicle" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    for (int slot = 0; slot < store.slotCount(); slot += 2)
+        store.despawn(slot);
+    for (int i = 0; i < vehicles / 2; i++) {
+        for (int h = 0; h < hops; h++)
+            path[h] = intersection(rng);
+        store.spawn(vehicles + i, path.data(), hops, 2);
+    }
+    double churnTime = secondsSince(start);
+
+    std::cout << "despawn + respawn half: " << churnTime << " s, slots: " << store.slotCount()
+              << ", memory: " << static_cast<double>(store.memoryUsage()) / store.size() << " bytes/vehicle" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    long long moved = 0;
+    for (int slot = 0; slot < store.slotCount(); slot++)
+        moved += store.advance(slot) ? 1 : 0;
+    std::cout << "advance all: " << secondsSince(start) << " s (" << moved << " moved)" << std::endl;
+    return 0;
+}
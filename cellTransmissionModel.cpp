@@ -0,0 +1,301 @@
+#include "cellTransmissionModel.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// The cell kernels take restrict-qualified pointers, so the compiler knows the arrays do not overlap,
+// and walk the cells in blocks of CELL_BLOCK (the arrays are padded to a whole number of blocks), so
+// the fixed-size inner loops are vectorized even at -O2.
+static const int CELL_BLOCK = 8;
+
+static void sendAndReceive(const float* __restrict__ density, float* __restrict__ sending, float* __restrict__ receiving,
+                           int cells, float cellFlow, float cellJam, float waveSpeedRatio) {
+    for (int b = 0; b < cells; b += CELL_BLOCK) {
+        for (int k = 0; k < CELL_BLOCK; k++) {
+            sending[b + k] = std::min(density[b + k], cellFlow);
+            receiving[b + k] = std::min(cellFlow, waveSpeedRatio * (cellJam - density[b + k]));
+        }
+    }
+}
+
+static void cellToCell(const float* __restrict__ sending, const float* __restrict__ receiving,
+                       const float* __restrict__ interior, float* __restrict__ flow, int cells) {
+    // receiving has one extra cell, so the last cell reads a valid (and masked) value
+    for (int b = 0; b < cells; b += CELL_BLOCK) {
+        for (int k = 0; k < CELL_BLOCK; k++)
+            flow[b + k] = std::min(sending[b + k], receiving[b + k + 1]) * interior[b + k];
+    }
+}
+
+static void applyFlows(float* __restrict__ density, const float* __restrict__ flow, const float* __restrict__ flowIn, int cells) {
+    // flowIn is flow shifted by one cell: flowIn[c] = flow[c - 1]
+    for (int b = 0; b < cells; b += CELL_BLOCK) {
+        for (int k = 0; k < CELL_BLOCK; k++)
+            density[b + k] += flowIn[b + k] - flow[b + k];
+    }
+}
+
+CellTransmissionModel::CellTransmissionModel(int stepSeconds, double saturationFlow, double vehiclesPerTravelSecond,
+                                             double waveSpeedRatio, double exitShare)
+    : graph(nullptr), stepSeconds(stepSeconds > 0 ? stepSeconds : 1), time(0), generated(0), exited(0) {
+    cellFlow = static_cast<float>((saturationFlow > 0 ? saturationFlow : 0.5) * this->stepSeconds);
+    cellJam = static_cast<float>((vehiclesPerTravelSecond > 0 ? vehiclesPerTravelSecond : 1.0) * this->stepSeconds);
+    this->waveSpeedRatio = static_cast<float>(std::min(1.0, std::max(0.0, waveSpeedRatio)));
+    this->exitShare = static_cast<float>(std::min(1.0, std::max(0.0, exitShare)));
+}
+
+void CellTransmissionModel::build(const CompactGraph& graph) {
+    this->graph = &graph;
+    int links = graph.getEdgeCount();
+    int intersections = graph.getIntersectionCount();
+
+    // cells of every road, crossed in one step each at free flow
+    cellOffset.assign(links + 1, 0);
+    for (int e = 0; e < links; e++) {
+        int cells = std::max(1, static_cast<int>(std::lround(static_cast<double>(graph.travelTime[e]) / stepSeconds)));
+        cellOffset[e + 1] = cellOffset[e] + cells;
+    }
+    int cells = cellOffset[links];
+    int padded = (cells + CELL_BLOCK - 1) / CELL_BLOCK * CELL_BLOCK;
+    density.assign(padded, 0.0f);
+    sending.assign(padded, 0.0f);
+    receiving.assign(padded + 1, 0.0f);
+    flow.assign(padded + 1, 0.0f);
+    interior.assign(padded, 0.0f);
+    std::fill(interior.begin(), interior.begin() + cells, 1.0f);
+    for (int e = 0; e < links; e++)
+        interior[cellOffset[e + 1] - 1] = 0.0f;
+
+    // turns: every road leaving the end intersection except the way back, unless it is the only one
+    turnOffset.assign(links + 1, 0);
+    turnTarget.clear();
+    turnShare.clear();
+    exitFraction.assign(links, 1.0f);
+    for (int e = 0; e < links; e++) {
+        int from = graph.edgeSource[e], at = graph.edgeTarget[e];
+        int first = graph.edgeOffset[at], last = graph.edgeOffset[at + 1];
+        int start = static_cast<int>(turnTarget.size());
+        for (int k = first; k < last; k++) {
+            if (graph.edgeTarget[k] != from || last - first == 1)
+                turnTarget.push_back(k);
+        }
+        int turns = static_cast<int>(turnTarget.size()) - start;
+        if (turns > 0) {
+            exitFraction[e] = exitShare;
+            turnShare.resize(turnTarget.size(), (1.0f - exitShare) / turns);
+        }
+        turnOffset[e + 1] = static_cast<int>(turnTarget.size());
+    }
+    linkSending.assign(links, 0.0f);
+    linkDemand.assign(links, 0.0f);
+    linkAccepted.assign(links, 1.0f);
+    linkInflow.assign(links, 0.0f);
+
+    demandRate.assign(intersections, 0.0f);
+    waiting.assign(intersections, 0.0f);
+    signalCycle.assign(intersections, 0);
+    signalGreenStart.assign(intersections, 0);
+    signalGreenLength.assign(intersections, 0);
+    greenAt.assign(intersections, 1);
+
+    time = 0;
+    generated = 0;
+    exited = 0;
+}
+
+int CellTransmissionModel::setSignals(TrafficLightManagement& traffic, int redTime) {
+    int found = 0;
+    for (TrafficSignal* signal = traffic.getHeadSignal(); signal != nullptr; signal = signal->next) {
+        int v = graph->findIntersection(signal->intersectionId);
+        if (v == -1)
+            continue;
+        if (signal->isCoordinated()) {
+            setSignalPlan(v, signal->cycleLength, signal->offset, signal->duration);
+        } else {
+            // green, yellow, red from the current state
+            int cycle = signal->duration + signal->transitionTime + redTime;
+            int greenStart = redTime;
+            if (signal->state == "green")
+                greenStart = 0;
+            else if (signal->state == "yellow")
+                greenStart = signal->transitionTime + redTime;
+            setSignalPlan(v, cycle, greenStart, signal->duration);
+        }
+        found++;
+    }
+    return found;
+}
+
+void CellTransmissionModel::setSignalPlan(int intersection, int cycle, int greenStart, int greenLength) {
+    signalCycle[intersection] = cycle > 0 ? cycle : 0;
+    signalGreenStart[intersection] = greenStart;
+    signalGreenLength[intersection] = greenLength;
+    greenAt[intersection] = isGreen(intersection);
+}
+
+void CellTransmissionModel::setDemand(int intersection, double vehiclesPerHour) {
+    demandRate[intersection] = static_cast<float>(vehiclesPerHour * stepSeconds / 3600.0);
+}
+
+int CellTransmissionModel::loadDemand(Vehicles& vehicles) {
+    std::vector<int> departures(graph->getIntersectionCount(), 0);
+    int found = 0;
+    for (Vehicle* vehicle = vehicles.getHead(); vehicle != nullptr; vehicle = vehicle->next) {
+        int v = graph->findIntersection(vehicle->startIntersection);
+        if (v == -1)
+            continue;
+        departures[v]++;
+        found++;
+    }
+    for (int v = 0; v < graph->getIntersectionCount(); v++)
+        setDemand(v, departures[v]);
+    return found;
+}
+
+bool CellTransmissionModel::isGreen(int intersection) const {
+    int cycle = signalCycle[intersection];
+    if (cycle <= 0)
+        return true;
+    int inCycle = (time - signalGreenStart[intersection]) % cycle;
+    if (inCycle < 0)
+        inCycle += cycle;
+    return inCycle < signalGreenLength[intersection];
+}
+
+void CellTransmissionModel::updateSignals() {
+    for (size_t v = 0; v < signalCycle.size(); v++) {
+        if (signalCycle[v] > 0)
+            greenAt[v] = isGreen(static_cast<int>(v));
+    }
+}
+
+void CellTransmissionModel::updateIntersections() {
+    int links = static_cast<int>(linkSending.size());
+    const std::vector<int>& edgeTarget = graph->edgeTarget;
+    const std::vector<unsigned char>& edgeFlags = graph->edgeFlags;
+
+    // what every road offers at its end and where it goes
+    std::fill(linkDemand.begin(), linkDemand.end(), 0.0f);
+    for (int e = 0; e < links; e++) {
+        float offered = greenAt[edgeTarget[e]] ? sending[cellOffset[e + 1] - 1] : 0.0f;
+        linkSending[e] = offered;
+        if (offered == 0.0f)
+            continue;
+        for (int k = turnOffset[e]; k < turnOffset[e + 1]; k++)
+            linkDemand[turnTarget[k]] += offered * turnShare[k];
+    }
+
+    // roads offered more than they receive scale every inflow down
+    for (int e = 0; e < links; e++) {
+        float room = (edgeFlags[e] & CompactGraph::EDGE_BLOCKED) ? 0.0f : receiving[cellOffset[e]];
+        linkAccepted[e] = linkDemand[e] > room ? room / linkDemand[e] : 1.0f;
+        linkInflow[e] = 0.0f;
+    }
+
+    for (int e = 0; e < links; e++) {
+        float offered = linkSending[e];
+        if (offered == 0.0f)
+            continue;
+        float leaving = offered * exitFraction[e];
+        exited += leaving;
+        for (int k = turnOffset[e]; k < turnOffset[e + 1]; k++) {
+            float moving = offered * turnShare[k] * linkAccepted[turnTarget[k]];
+            linkInflow[turnTarget[k]] += moving;
+            leaving += moving;
+        }
+        density[cellOffset[e + 1] - 1] -= leaving;
+    }
+
+    // demand waits at its intersection for room on the roads leaving it
+    const std::vector<int>& edgeOffset = graph->edgeOffset;
+    for (size_t v = 0; v < waiting.size(); v++) {
+        waiting[v] += demandRate[v];
+        generated += demandRate[v];
+        int roads = edgeOffset[v + 1] - edgeOffset[v];
+        if (waiting[v] <= 0.0f || roads == 0)
+            continue;
+        float share = waiting[v] / roads;
+        for (int e = edgeOffset[v]; e < edgeOffset[v + 1]; e++) {
+            float room = (edgeFlags[e] & CompactGraph::EDGE_BLOCKED) ? 0.0f : receiving[cellOffset[e]] - linkInflow[e];
+            float entering = std::max(0.0f, std::min(room, share));
+            linkInflow[e] += entering;
+            waiting[v] -= entering;
+        }
+    }
+
+    for (int e = 0; e < links; e++)
+        density[cellOffset[e]] += linkInflow[e];
+}
+
+void CellTransmissionModel::step() {
+    int padded = static_cast<int>(density.size());
+    updateSignals();
+    sendAndReceive(density.data(), sending.data(), receiving.data(), padded, cellFlow, cellJam, waveSpeedRatio);
+    cellToCell(sending.data(), receiving.data(), interior.data(), flow.data() + 1, padded);
+    updateIntersections();
+    applyFlows(density.data(), flow.data() + 1, flow.data(), padded);
+    time += stepSeconds;
+}
+
+int CellTransmissionModel::run(int seconds) {
+    int steps = (seconds + stepSeconds - 1) / stepSeconds;
+    for (int s = 0; s < steps; s++)
+        step();
+    return steps;
+}
+
+int CellTransmissionModel::getTime() const {
+    return time;
+}
+
+double CellTransmissionModel::getVehiclesOnLink(int link) const {
+    double total = 0;
+    for (int c = cellOffset[link]; c < cellOffset[link + 1]; c++)
+        total += density[c];
+    return total;
+}
+
+double CellTransmissionModel::getLinkCapacity(int link) const {
+    return static_cast<double>(cellJam) * (cellOffset[link + 1] - cellOffset[link]);
+}
+
+double CellTransmissionModel::getVehicleCount() const {
+    double total = 0;
+    for (size_t c = 0; c < density.size(); c++)
+        total += density[c];
+    return total;
+}
+
+double CellTransmissionModel::getWaitingVehicles() const {
+    double total = 0;
+    for (size_t v = 0; v < waiting.size(); v++)
+        total += waiting[v];
+    return total;
+}
+
+double CellTransmissionModel::getGeneratedVehicles() const {
+    return generated;
+}
+
+double CellTransmissionModel::getExitedVehicles() const {
+    return exited;
+}
+
+int CellTransmissionModel::getCellCount() const {
+    return cellOffset.empty() ? 0 : cellOffset.back();
+}
+
+std::size_t CellTransmissionModel::memoryUsage() const {
+    return (cellOffset.capacity() + turnOffset.capacity() + turnTarget.capacity() + signalCycle.capacity() +
+            signalGreenStart.capacity() + signalGreenLength.capacity()) * sizeof(int32_t) +
+           (density.capacity() + sending.capacity() + receiving.capacity() + flow.capacity() + interior.capacity() +
+            turnShare.capacity() + exitFraction.capacity() + linkSending.capacity() + linkDemand.capacity() +
+            linkAccepted.capacity() + linkInflow.capacity() + demandRate.capacity() + waiting.capacity()) * sizeof(float) +
+           greenAt.capacity();
+}
+
+void CellTransmissionModel::printSummary() const {
+    std::cout << "Simulated time: " << time << "s, cells: " << getCellCount() << std::endl;
+    std::cout << "Vehicles entered: " << generated << ", exited: " << exited << ", on the roads: "
+              << getVehicleCount() << ", waiting to enter: " << getWaitingVehicles() << std::endl;
+}
@@ -0,0 +1,205 @@
+#ifndef CELL_TRANSMISSION_MODEL_H
+#define CELL_TRANSMISSION_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "compactGraph.h"
+#include "trafficLightManagement.h"
+#include "vehicles.h"
+
+/**
+ * @class CellTransmissionModel
+ * @brief Macroscopic simulation of the road network with the Cell Transmission Model.
+ *
+ * Traffic is a density rather than a set of vehicles. Every road of a CompactGraph is split into
+ * cells a vehicle crosses in one step at free flow, i.e. max(1, round(travelTime / stepSeconds))
+ * cells. Each step every cell can send min(n, Q) vehicles and receive min(Q, w/v * (N - n)), where n
+ * is the number of vehicles in the cell, Q the vehicles a cell passes per step (saturation flow) and
+ * N the vehicles a cell holds at jam density; the flow between two cells is the smaller of what the
+ * upstream one sends and the downstream one receives.
+ *
+ * At an intersection the flow arriving on each road leaves the network for the exitShare, and the
+ * rest is split evenly over the roads leaving the intersection (U-turns only at dead ends); a road
+ * that receives less than is sent to it scales every flow into it down proportionally. A red signal
+ * stops the flow out of every road ending at its intersection, and a blocked road takes no flow.
+ * Demand enters at intersections at a given rate and waits there until the roads leaving have room.
+ *
+ * The cells of all roads live in contiguous float arrays (the cells of road e are
+ * cellOffset[e] .. cellOffset[e + 1] - 1) and the cell update is a handful of branch-free loops over
+ * them, which the compiler vectorizes; only the intersections are handled road by road.
+ */
+class CellTransmissionModel {
+public:
+    /**
+     * @brief Constructs an empty model.
+     * @param stepSeconds Length of a step in seconds, which is also the free-flow crossing time of a cell.
+     * @param saturationFlow Vehicles per second a road passes at capacity.
+     * @param vehiclesPerTravelSecond Vehicles a road holds at jam density per second of travel time.
+     * @param waveSpeedRatio Speed of the congestion wave relative to the free-flow speed (w/v, at most 1).
+     * @param exitShare Share of the flow arriving at an intersection that leaves the network there.
+     */
+    CellTransmissionModel(int stepSeconds = 5, double saturationFlow = 0.5, double vehiclesPerTravelSecond = 1.0,
+                          double waveSpeedRatio = 0.5, double exitShare = 0.1);
+
+    /**
+     * @brief Splits the roads of a network into cells and empties them. Signals and demand are cleared.
+     * @param graph The road network; it must outlive the model. Road statuses are read every step,
+     * so CompactGraph::refreshFlags() takes effect immediately.
+     */
+    void build(const CompactGraph& graph);
+
+    /**
+     * @brief Takes the signal timings of TrafficLightManagement.
+     *
+     * Coordinated signals follow their plan (green for duration seconds from offset in every cycle);
+     * the others repeat green for duration, yellow for transitionTime and red for redTime seconds,
+     * starting from their current state. Only green lets vehicles cross.
+     * @param traffic The traffic signals.
+     * @param redTime Red time of uncoordinated signals in seconds.
+     * @return The number of signals found in the network.
+     */
+    int setSignals(TrafficLightManagement& traffic, int redTime = 30);
+
+    /**
+     * @brief Sets a fixed-time plan for the signal of an intersection.
+     * @param intersection The index of the intersection.
+     * @param cycle The length of the cycle in seconds (0 removes the signal).
+     * @param greenStart The start of green within the cycle in seconds.
+     * @param greenLength The length of green in seconds.
+     */
+    void setSignalPlan(int intersection, int cycle, int greenStart, int greenLength);
+
+    /**
+     * @brief Sets the rate at which vehicles enter the network at an intersection.
+     * @param intersection The index of the intersection.
+     * @param vehiclesPerHour The demand.
+     */
+    void setDemand(int intersection, double vehiclesPerHour);
+
+    /**
+     * @brief Derives the demand from a vehicle list: every vehicle departs once per hour from its start intersection.
+     * @param vehicles The vehicles.
+     * @return The number of vehicles whose start intersection is in the network.
+     */
+    int loadDemand(Vehicles& vehicles);
+
+    /**
+     * @brief Advances the model by one step.
+     */
+    void step();
+
+    /**
+     * @brief Advances the model by a number of seconds (rounded up to whole steps).
+     * @param seconds The simulated time to run for.
+     * @return The number of steps taken.
+     */
+    int run(int seconds);
+
+    /**
+     * @brief Gets the simulated time.
+     * @return int Seconds since build().
+     */
+    int getTime() const;
+
+    /**
+     * @brief Gets the number of vehicles on a road.
+     * @param link The index of the road.
+     * @return double
+     */
+    double getVehiclesOnLink(int link) const;
+
+    /**
+     * @brief Gets the number of vehicles a road holds at jam density.
+     * @param link The index of the road.
+     * @return double
+     */
+    double getLinkCapacity(int link) const;
+
+    /**
+     * @brief Gets the number of vehicles on all roads.
+     * @return double
+     */
+    double getVehicleCount() const;
+
+    /**
+     * @brief Gets the number of vehicles waiting to enter the network.
+     * @return double
+     */
+    double getWaitingVehicles() const;
+
+    /**
+     * @brief Gets the number of vehicles that entered the demand queues since build().
+     * @return double
+     */
+    double getGeneratedVehicles() const;
+
+    /**
+     * @brief Gets the number of vehicles that left the network since build().
+     * @return double
+     */
+    double getExitedVehicles() const;
+
+    /**
+     * @brief Gets the number of cells of all roads.
+     * @return int
+     */
+    int getCellCount() const;
+
+    /**
+     * @brief Gets the memory used by the model's arrays (allocated capacity).
+     * @return std::size_t Bytes.
+     */
+    std::size_t memoryUsage() const;
+
+    /**
+     * @brief Prints the time and vehicle totals of the model.
+     */
+    void printSummary() const;
+
+private:
+    const CompactGraph* graph;  /**< Road network (nullptr until build()) */
+    int stepSeconds;            /**< Length of a step */
+    float cellFlow;             /**< Vehicles a cell passes per step (Q) */
+    float cellJam;              /**< Vehicles a cell holds at jam density (N) */
+    float waveSpeedRatio;       /**< w/v */
+    float exitShare;            /**< Share of the flow leaving the network at each intersection */
+
+    // cells of every road
+    std::vector<int32_t> cellOffset;  /**< First cell of each road (size roads + 1) */
+    std::vector<float> density;       /**< Vehicles in each cell, padded with empty cells to a whole number of blocks */
+    std::vector<float> sending;       /**< Vehicles each cell can send this step */
+    std::vector<float> receiving;     /**< Vehicles each cell can receive this step (one extra cell) */
+    std::vector<float> flow;          /**< Vehicles moving from cell c to the next cell of its road at c + 1 (flow[0] is 0) */
+    std::vector<float> interior;      /**< 1 for cells followed by a cell of the same road, 0 for last and padding cells */
+
+    // intersections: turns from each road onto the roads leaving its end intersection
+    std::vector<int32_t> turnOffset;  /**< First turn of each road (size roads + 1) */
+    std::vector<int32_t> turnTarget;  /**< Road entered by each turn */
+    std::vector<float> turnShare;     /**< Share of the road's outflow taking each turn */
+    std::vector<float> exitFraction;  /**< Share of each road's outflow leaving the network */
+    std::vector<float> linkSending;   /**< Outflow each road offers this step (0 on red) */
+    std::vector<float> linkDemand;    /**< Inflow offered to each road this step */
+    std::vector<float> linkAccepted;  /**< Share of the offered inflow each road accepts */
+    std::vector<float> linkInflow;    /**< Inflow into the first cell of each road this step */
+
+    // demand
+    std::vector<float> demandRate;    /**< Vehicles entering at each intersection per step */
+    std::vector<float> waiting;       /**< Vehicles waiting to enter at each intersection */
+
+    // signals
+    std::vector<int32_t> signalCycle;       /**< Cycle of the signal at each intersection (0 for always green) */
+    std::vector<int32_t> signalGreenStart;  /**< Start of green within the cycle */
+    std::vector<int32_t> signalGreenLength; /**< Length of green */
+    std::vector<unsigned char> greenAt;     /**< Whether vehicles may cross each intersection this step */
+
+    int time;          /**< Simulated time */
+    double generated;  /**< Vehicles that entered the demand queues */
+    double exited;     /**< Vehicles that left the network */
+
+    bool isGreen(int intersection) const;
+    void updateSignals();
+    void updateIntersections();
+};
+
+#endif // CELL_TRANSMISSION_MODEL_H
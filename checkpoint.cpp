@@ -0,0 +1,452 @@
+#include "checkpoint.h"
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+const char MAGIC[8] = {'S', 'T', 'M', 'S', 'C', 'K', 'P', 'T'};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sections;
+};
+
+// Closes the file when the function using it returns
+struct FileCloser {
+    std::FILE* file;
+    explicit FileCloser(std::FILE* file) : file(file) {}
+    ~FileCloser() { if (file) std::fclose(file); }
+};
+
+uint8_t encodeState(const std::string& state) {
+    if (state == "green") return 2;
+    if (state == "yellow") return 1;
+    return 0;
+}
+
+const char* decodeState(uint8_t state) {
+    return state == 2 ? "green" : state == 1 ? "yellow" : "red";
+}
+}
+
+void Checkpoint::StringTable::add(const std::string& text) {
+    chars.insert(chars.end(), text.begin(), text.end());
+    offset.push_back(static_cast<uint32_t>(chars.size()));
+}
+
+std::string Checkpoint::StringTable::get(std::size_t i) const {
+    return std::string(chars.data() + offset[i], offset[i + 1] - offset[i]);
+}
+
+template <typename T>
+bool Checkpoint::writeSection(std::FILE* file, uint32_t tag, const std::vector<T>& values, uint32_t& sections) {
+    SectionHeader header;
+    header.tag = tag;
+    header.elementSize = sizeof(T);
+    header.count = values.size();
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1)
+        return false;
+    if (!values.empty() && std::fwrite(values.data(), sizeof(T), values.size(), file) != values.size())
+        return false;
+    sections++;
+    return true;
+}
+
+bool Checkpoint::writeStrings(std::FILE* file, uint32_t offsetTag, uint32_t charsTag, const StringTable& table, uint32_t& sections) {
+    return writeSection(file, offsetTag, table.offset, sections) && writeSection(file, charsTag, table.chars, sections);
+}
+
+template <typename T>
+bool Checkpoint::readSection(std::FILE* file, const SectionHeader& header, std::vector<T>& values) {
+    if (header.elementSize != sizeof(T))
+        return false;
+    values.resize(header.count);
+    return values.empty() || std::fread(values.data(), sizeof(T), values.size(), file) == values.size();
+}
+
+bool Checkpoint::isValid(const StringTable& table) {
+    if (table.offset.empty() || table.offset[0] != 0 || table.offset.back() != table.chars.size())
+        return false;
+    for (std::size_t i = 1; i < table.offset.size(); i++)
+        if (table.offset[i] < table.offset[i - 1])
+            return false;
+    return true;
+}
+
+bool Checkpoint::save(const std::string& filename, Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                      CongestionMonitoring& ht, Accident_roads& accidentManager, const VehicleStore* store) {
+    // graph: intersection names, and the roads of every intersection in list order
+    StringTable names;
+    std::unordered_map<const Vertex*, int32_t> vertexIndex;
+    for (VertexNode* node = cityGraph.headVertex; node; node = node->next) {
+        vertexIndex[node->vertex] = static_cast<int32_t>(names.size());
+        names.add(node->vertex->name);
+    }
+    std::vector<uint32_t> edgeOffset(1, 0);
+    std::vector<EdgeRecord> edges;
+    for (VertexNode* node = cityGraph.headVertex; node; node = node->next) {
+        for (EdgeNode* edgeNode = node->vertex->edges; edgeNode; edgeNode = edgeNode->next) {
+            Edge* edge = edgeNode->edge;
+            EdgeRecord record;
+            std::memset(&record, 0, sizeof(record));
+            std::unordered_map<const Vertex*, int32_t>::const_iterator target = vertexIndex.find(edge->destination);
+            if (target == vertexIndex.end()) {
+                std::cerr << "Error: road from " << node->vertex->name << " leads to an intersection outside the graph" << std::endl;
+                return false;
+            }
+            record.target = target->second;
+            record.travelTime = edge->travelTime;
+            record.blocked = edge->blocked;
+            record.underRepair = edge->underRepaired;
+            edges.push_back(record);
+        }
+        edgeOffset.push_back(static_cast<uint32_t>(edges.size()));
+    }
+
+    // vehicles, in list order
+    std::vector<VehicleRecord> vehicleRecords;
+    StringTable ids, endpoints, priorities, paths;
+    for (Vehicle* v = vehicles.head; v; v = v->next) {
+        VehicleRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.pathStart = static_cast<uint32_t>(paths.size());
+        record.pathEntries = static_cast<uint32_t>(v->path.size());
+        record.pathLength = v->pathLength;
+        record.position = v->currentIntersectionInPath;
+        record.presetPath = v->presetPath;
+        vehicleRecords.push_back(record);
+        ids.add(v->vehicleID);
+        endpoints.add(v->startIntersection);
+        endpoints.add(v->endIntersection);
+        priorities.add(v->priorityLevel);
+        for (std::size_t i = 0; i < v->path.size(); i++)
+            paths.add(v->path[i]);
+    }
+
+    // signals, in list order; the full names go in a string table, two per signal
+    std::vector<SignalRecord> signals;
+    StringTable signalNames;
+    for (TrafficSignal* signal = traffic.headSignal; signal; signal = signal->next) {
+        SignalRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.duration = signal->duration;
+        record.transitionTime = signal->transitionTime;
+        record.temp = signal->temp;
+        record.cycleLength = signal->cycleLength;
+        record.offset = signal->offset;
+        record.intersectionId = signal->intersectionId.empty() ? '\0' : signal->intersectionId[0];
+        record.greenApproach = signal->greenApproach.empty() ? '\0' : signal->greenApproach[0];
+        record.state = encodeState(signal->state);
+        signals.push_back(record);
+        signalNames.add(signal->intersectionId);
+        signalNames.add(signal->greenApproach);
+    }
+
+    // congestion counts: every node of every chain, skipping empty buckets
+    std::vector<RoadCountRecord> roads;
+    for (int bucket = 0; bucket < HASH_TABLE_SIZE; bucket++) {
+        if (ht.hashTable[bucket].right == nullptr && ht.hashTable[bucket].path[0] == '\0')
+            continue;
+        for (RoadNode* road = &ht.hashTable[bucket]; road; road = road->right) {
+            RoadCountRecord record;
+            std::memset(&record, 0, sizeof(record));
+            record.bucket = bucket;
+            record.carCount = road->carCount;
+            record.start = road->path[0];
+            record.end = road->path[1];
+            roads.push_back(record);
+        }
+    }
+
+    // accident records
+    StringTable blocked, repair;
+    std::vector<uint8_t> blockedFlags, repairFlags;
+    for (Accident_roads::AccidentNode* node = accidentManager.head; node; node = node->next) {
+        blocked.add(node->intersection1);
+        blocked.add(node->intersection2);
+        blockedFlags.push_back(node->isBlocked);
+    }
+    for (Accident_roads::AccidentNode* node = accidentManager.underRepairHead; node; node = node->next) {
+        repair.add(node->intersection1);
+        repair.add(node->intersection2);
+        repairFlags.push_back(node->isBlocked);
+    }
+
+    // write to a temporary file and replace the checkpoint only once it is complete
+    std::string temporary = filename + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Unable to open file " << temporary << std::endl;
+        return false;
+    }
+    FileCloser closer(file);
+
+    FileHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.sections = 0;
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              writeStrings(file, TAG_GRAPH_NAMES_OFFSET, TAG_GRAPH_NAMES_CHARS, names, header.sections) &&
+              writeSection(file, TAG_GRAPH_EDGE_OFFSET, edgeOffset, header.sections) &&
+              writeSection(file, TAG_GRAPH_EDGES, edges, header.sections) &&
+              writeSection(file, TAG_VEHICLES, vehicleRecords, header.sections) &&
+              writeStrings(file, TAG_VEHICLE_IDS_OFFSET, TAG_VEHICLE_IDS_CHARS, ids, header.sections) &&
+              writeStrings(file, TAG_VEHICLE_ENDPOINTS_OFFSET, TAG_VEHICLE_ENDPOINTS_CHARS, endpoints, header.sections) &&
+              writeStrings(file, TAG_VEHICLE_PRIORITIES_OFFSET, TAG_VEHICLE_PRIORITIES_CHARS, priorities, header.sections) &&
+              writeStrings(file, TAG_VEHICLE_PATHS_OFFSET, TAG_VEHICLE_PATHS_CHARS, paths, header.sections) &&
+              writeSection(file, TAG_SIGNALS, signals, header.sections) &&
+              writeSection(file, TAG_ROAD_COUNTS, roads, header.sections) &&
+              writeStrings(file, TAG_BLOCKED_OFFSET, TAG_BLOCKED_CHARS, blocked, header.sections) &&
+              writeSection(file, TAG_BLOCKED_FLAGS, blockedFlags, header.sections) &&
+              writeStrings(file, TAG_REPAIR_OFFSET, TAG_REPAIR_CHARS, repair, header.sections) &&
+              writeSection(file, TAG_REPAIR_FLAGS, repairFlags, header.sections) &&
+              writeStrings(file, TAG_SIGNAL_NAMES_OFFSET, TAG_SIGNAL_NAMES_CHARS, signalNames, header.sections);
+    if (ok && store) {
+        std::vector<int64_t> state(3);
+        state[0] = store->freeHead;
+        state[1] = store->liveCount;
+        state[2] = static_cast<int64_t>(store->garbageEntries);
+        ok = writeSection(file, TAG_STORE_IDS, store->ids, header.sections) &&
+             writeSection(file, TAG_STORE_CURRENT_EDGE, store->currentEdge, header.sections) &&
+             writeSection(file, TAG_STORE_PATH_OFFSET, store->pathOffset, header.sections) &&
+             writeSection(file, TAG_STORE_PATH_LENGTH, store->pathLength, header.sections) &&
+             writeSection(file, TAG_STORE_PATH_POSITION, store->pathPosition, header.sections) &&
+             writeSection(file, TAG_STORE_PRIORITY, store->priority, header.sections) &&
+             writeSection(file, TAG_STORE_PATH_ARENA, store->pathArena, header.sections) &&
+             writeSection(file, TAG_STORE_STATE, state, header.sections);
+    }
+    // the section count is only known now
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    closer.file = nullptr;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::cerr << "Error: Unable to write checkpoint " << filename << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Checkpoint::restore(const std::string& filename, Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                         CongestionMonitoring& ht, Accident_roads& accidentManager, VehicleStore* store) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Error: Unable to open file " << filename << std::endl;
+        return false;
+    }
+    FileCloser closer(file);
+
+    FileHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Error: " << filename << " is not a checkpoint" << std::endl;
+        return false;
+    }
+    if (header.version > VERSION) {
+        std::cerr << "Error: " << filename << " has checkpoint version " << header.version
+                  << ", this build reads up to version " << VERSION << std::endl;
+        return false;
+    }
+
+    // read every section into its array
+    StringTable names, ids, endpoints, priorities, paths, blocked, repair, signalNames;
+    std::vector<uint32_t> edgeOffset;
+    std::vector<EdgeRecord> edges;
+    std::vector<VehicleRecord> vehicleRecords;
+    std::vector<SignalRecord> signals;
+    std::vector<RoadCountRecord> roads;
+    std::vector<uint8_t> blockedFlags, repairFlags;
+    VehicleStore loaded;
+    std::vector<int64_t> storeState;
+    bool ok = true;
+    for (uint32_t i = 0; i < header.sections && ok; i++) {
+        SectionHeader section;
+        if (std::fread(&section, sizeof(section), 1, file) != 1) {
+            ok = false;
+            break;
+        }
+        switch (section.tag) {
+            case TAG_GRAPH_NAMES_OFFSET: ok = readSection(file, section, names.offset); break;
+            case TAG_GRAPH_NAMES_CHARS: ok = readSection(file, section, names.chars); break;
+            case TAG_GRAPH_EDGE_OFFSET: ok = readSection(file, section, edgeOffset); break;
+            case TAG_GRAPH_EDGES: ok = readSection(file, section, edges); break;
+            case TAG_VEHICLES: ok = readSection(file, section, vehicleRecords); break;
+            case TAG_VEHICLE_IDS_OFFSET: ok = readSection(file, section, ids.offset); break;
+            case TAG_VEHICLE_IDS_CHARS: ok = readSection(file, section, ids.chars); break;
+            case TAG_VEHICLE_ENDPOINTS_OFFSET: ok = readSection(file, section, endpoints.offset); break;
+            case TAG_VEHICLE_ENDPOINTS_CHARS: ok = readSection(file, section, endpoints.chars); break;
+            case TAG_VEHICLE_PRIORITIES_OFFSET: ok = readSection(file, section, priorities.offset); break;
+            case TAG_VEHICLE_PRIORITIES_CHARS: ok = readSection(file, section, priorities.chars); break;
+            case TAG_VEHICLE_PATHS_OFFSET: ok = readSection(file, section, paths.offset); break;
+            case TAG_VEHICLE_PATHS_CHARS: ok = readSection(file, section, paths.chars); break;
+            case TAG_SIGNALS: ok = readSection(file, section, signals); break;
+            case TAG_ROAD_COUNTS: ok = readSection(file, section, roads); break;
+            case TAG_SIGNAL_NAMES_OFFSET: ok = readSection(file, section, signalNames.offset); break;
+            case TAG_SIGNAL_NAMES_CHARS: ok = readSection(file, section, signalNames.chars); break;
+            case TAG_BLOCKED_OFFSET: ok = readSection(file, section, blocked.offset); break;
+            case TAG_BLOCKED_CHARS: ok = readSection(file, section, blocked.chars); break;
+            case TAG_BLOCKED_FLAGS: ok = readSection(file, section, blockedFlags); break;
+            case TAG_REPAIR_OFFSET: ok = readSection(file, section, repair.offset); break;
+            case TAG_REPAIR_CHARS: ok = readSection(file, section, repair.chars); break;
+            case TAG_REPAIR_FLAGS: ok = readSection(file, section, repairFlags); break;
+            case TAG_STORE_IDS: ok = readSection(file, section, loaded.ids); break;
+            case TAG_STORE_CURRENT_EDGE: ok = readSection(file, section, loaded.currentEdge); break;
+            case TAG_STORE_PATH_OFFSET: ok = readSection(file, section, loaded.pathOffset); break;
+            case TAG_STORE_PATH_LENGTH: ok = readSection(file, section, loaded.pathLength); break;
+            case TAG_STORE_PATH_POSITION: ok = readSection(file, section, loaded.pathPosition); break;
+            case TAG_STORE_PRIORITY: ok = readSection(file, section, loaded.priority); break;
+            case TAG_STORE_PATH_ARENA: ok = readSection(file, section, loaded.pathArena); break;
+            case TAG_STORE_STATE: ok = readSection(file, section, storeState); break;
+            default:
+                // written by a newer build: skip it
+                ok = std::fseek(file, static_cast<long>(section.elementSize * section.count), SEEK_CUR) == 0;
+        }
+    }
+
+    // check that every index points inside its array before touching the current state
+    std::size_t vertexCount = names.size();
+    ok = ok && isValid(names) && isValid(ids) && isValid(endpoints) && isValid(priorities) && isValid(paths) &&
+         isValid(blocked) && isValid(repair) && edgeOffset.size() == vertexCount + 1 && edgeOffset[0] == 0 &&
+         edgeOffset.back() == edges.size() && ids.size() == vehicleRecords.size() &&
+         endpoints.size() == 2 * vehicleRecords.size() && priorities.size() == vehicleRecords.size() &&
+         blocked.size() == 2 * blockedFlags.size() && repair.size() == 2 * repairFlags.size() &&
+         isValid(signalNames) && (signalNames.size() == 0 || signalNames.size() == 2 * signals.size());
+    for (std::size_t v = 0; ok && v < vertexCount; v++)
+        ok = edgeOffset[v] <= edgeOffset[v + 1];
+    for (std::size_t e = 0; ok && e < edges.size(); e++)
+        ok = edges[e].target >= 0 && static_cast<std::size_t>(edges[e].target) < vertexCount;
+    for (std::size_t v = 0; ok && v < vehicleRecords.size(); v++) {
+        const VehicleRecord& record = vehicleRecords[v];
+        ok = static_cast<uint64_t>(record.pathStart) + record.pathEntries <= paths.size() && record.pathEntries >= 1 &&
+             record.pathLength >= 0 && static_cast<uint32_t>(record.pathLength) <= record.pathEntries &&
+             record.position >= 0 && static_cast<uint32_t>(record.position) < record.pathEntries;
+    }
+    for (std::size_t r = 0; ok && r < roads.size(); r++)
+        ok = roads[r].bucket >= 0 && roads[r].bucket < HASH_TABLE_SIZE;
+    bool hasStore = !storeState.empty();
+    if (ok && hasStore) {
+        std::size_t slots = loaded.ids.size();
+        ok = storeState.size() == 3 && loaded.currentEdge.size() == slots && loaded.pathOffset.size() == slots &&
+             loaded.pathLength.size() == slots && loaded.pathPosition.size() == slots && loaded.priority.size() == slots &&
+             storeState[0] >= -1 && storeState[0] < static_cast<int64_t>(slots);
+        for (std::size_t slot = 0; ok && slot < slots; slot++)
+            ok = loaded.ids[slot] == -1 ||
+                 (static_cast<uint64_t>(loaded.pathOffset[slot]) + loaded.pathLength[slot] <= loaded.pathArena.size() &&
+                  loaded.pathPosition[slot] < loaded.pathLength[slot]);
+    }
+    if (!ok) {
+        std::cerr << "Error: " << filename << " is truncated or corrupt" << std::endl;
+        return false;
+    }
+
+    // graph: vertices and roads in their saved order
+    cityGraph.clear();
+    std::vector<Vertex*> vertices(vertexCount);
+    VertexNode* lastVertex = nullptr;
+    for (std::size_t v = 0; v < vertexCount; v++) {
+        vertices[v] = new Vertex(names.get(v));
+        VertexNode* node = new VertexNode(vertices[v]);
+        if (lastVertex)
+            lastVertex->next = node;
+        else
+            cityGraph.headVertex = node;
+        lastVertex = node;
+    }
+    for (std::size_t v = 0; v < vertexCount; v++) {
+        EdgeNode* lastEdge = nullptr;
+        for (uint32_t e = edgeOffset[v]; e < edgeOffset[v + 1]; e++) {
+            Edge* edge = new Edge(vertices[edges[e].target], edges[e].travelTime);
+            edge->blocked = edges[e].blocked != 0;
+            edge->underRepaired = edges[e].underRepair != 0;
+            EdgeNode* node = new EdgeNode(edge);
+            if (lastEdge)
+                lastEdge->next = node;
+            else
+                vertices[v]->edges = node;
+            lastEdge = node;
+        }
+    }
+
+    // vehicles, appended in their saved order
+    vehicles.clear();
+    vehicles.index.reserve(vehicleRecords.size());
+    for (std::size_t v = 0; v < vehicleRecords.size(); v++) {
+        const VehicleRecord& record = vehicleRecords[v];
+        Vehicle* vehicle = new Vehicle(ids.get(v), endpoints.get(2 * v), endpoints.get(2 * v + 1), priorities.get(v));
+        vehicle->path.resize(record.pathEntries);
+        for (uint32_t i = 0; i < record.pathEntries; i++)
+            vehicle->path[i] = paths.get(record.pathStart + i);
+        vehicle->pathLength = record.pathLength;
+        vehicle->currentIntersectionInPath = record.position;
+        vehicle->presetPath = record.presetPath != 0;
+        vehicles.linkAfter(vehicles.tail, vehicle);
+    }
+
+    // signals; the controller is rebuilt on the next update
+    TrafficSignal* signal = traffic.headSignal;
+    while (signal) {
+        TrafficSignal* next = signal->next;
+        delete signal;
+        signal = next;
+    }
+    traffic.headSignal = NULL;
+    traffic.controlledSignals.clear();
+    traffic.controllerVersion = -1;
+    TrafficSignal* lastSignal = NULL;
+    // files from builds that stored single-character names only have the record characters
+    bool hasSignalNames = signalNames.size() != 0;
+    for (std::size_t s = 0; s < signals.size(); s++) {
+        const SignalRecord& record = signals[s];
+        std::string intersectionId = hasSignalNames ? signalNames.get(2 * s) : std::string(1, record.intersectionId);
+        TrafficSignal* restored = new TrafficSignal(decodeState(record.state), intersectionId);
+        restored->duration = record.duration;
+        restored->transitionTime = record.transitionTime;
+        restored->temp = record.temp;
+        restored->greenApproach = hasSignalNames ? signalNames.get(2 * s + 1) : std::string(1, record.greenApproach);
+        restored->cycleLength = record.cycleLength;
+        restored->offset = record.offset;
+        restored->next = NULL;
+        if (lastSignal)
+            lastSignal->next = restored;
+        else
+            traffic.headSignal = restored;
+        lastSignal = restored;
+    }
+
+    // congestion counts, chain by chain
+    ht.deleteTable();
+    RoadNode* chainTail[HASH_TABLE_SIZE] = {};
+    for (std::size_t r = 0; r < roads.size(); r++) {
+        int bucket = roads[r].bucket;
+        RoadNode* road = &ht.hashTable[bucket];
+        if (chainTail[bucket]) {
+            road = new RoadNode();
+            chainTail[bucket]->right = road;
+        }
+        road->path[0] = roads[r].start;
+        road->path[1] = roads[r].end;
+        road->carCount = roads[r].carCount;
+        chainTail[bucket] = road;
+    }
+
+    // accident records
+    accidentManager.clear();
+    Accident_roads::AccidentNode** link = &accidentManager.head;
+    for (std::size_t a = 0; a < blockedFlags.size(); a++) {
+        *link = new Accident_roads::AccidentNode(blocked.get(2 * a), blocked.get(2 * a + 1), blockedFlags[a] != 0);
+        link = &(*link)->next;
+    }
+    link = &accidentManager.underRepairHead;
+    for (std::size_t a = 0; a < repairFlags.size(); a++) {
+        *link = new Accident_roads::AccidentNode(repair.get(2 * a), repair.get(2 * a + 1), repairFlags[a] != 0);
+        link = &(*link)->next;
+    }
+
+    if (store && hasStore) {
+        loaded.freeHead = static_cast<int>(storeState[0]);
+        loaded.liveCount = static_cast<int>(storeState[1]);
+        loaded.garbageEntries = static_cast<std::size_t>(storeState[2]);
+        std::swap(*store, loaded);
+    }
+    return true;
+}
@@ -0,0 +1,184 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "vehicles.h"
+#include "trafficLightManagement.h"
+#include "congestionMonitoring.h"
+#include "accidents.h"
+#include "vehicleStore.h"
+
+/**
+ * @class Checkpoint
+ * @brief Versioned binary snapshot of the whole simulation state.
+ *
+ * A checkpoint file starts with a header (magic "STMSCKPT", format version, number of sections)
+ * followed by sections, each a header (tag, element size, element count) and an array of plain
+ * records written and read with a single fwrite / fread. Strings are stored as string tables: one
+ * array of offsets and one array of characters. Objects refer to each other by index (e.g. a road by
+ * the index of its end intersection), never by pointer, so restoring is a matter of reading the arrays
+ * back and relinking the lists.
+ *
+ * Sections with an unknown tag are skipped, so older readers can load files from newer writers as
+ * long as the format version is not bumped; a reader rejects files with a newer format version.
+ */
+class Checkpoint {
+public:
+    static const uint32_t VERSION = 1;  /**< Format version written by this build */
+
+    /**
+     * @brief Writes the simulation state to a file.
+     * @param filename The file to write (replaced if it exists).
+     * @param cityGraph The road network.
+     * @param vehicles The vehicles.
+     * @param traffic The traffic signals.
+     * @param ht The congestion counts.
+     * @param accidentManager The blocked and under-repair roads.
+     * @param store Optional structure-of-arrays vehicle population to include (nullptr for none).
+     * @return true on success, false if the file could not be written.
+     */
+    static bool save(const std::string& filename, Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                     CongestionMonitoring& ht, Accident_roads& accidentManager, const VehicleStore* store = nullptr);
+
+    /**
+     * @brief Replaces the simulation state with the contents of a checkpoint file.
+     *
+     * The file is read and checked completely before anything is replaced, so a failed restore leaves
+     * the current state untouched.
+     * @param filename The file to read.
+     * @param cityGraph Receives the road network.
+     * @param vehicles Receives the vehicles.
+     * @param traffic Receives the traffic signals.
+     * @param ht Receives the congestion counts.
+     * @param accidentManager Receives the blocked and under-repair roads.
+     * @param store Receives the vehicle population if the file has one (nullptr to ignore it).
+     * @return true on success, false if the file is missing, truncated or of an unsupported version.
+     */
+    static bool restore(const std::string& filename, Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                        CongestionMonitoring& ht, Accident_roads& accidentManager, VehicleStore* store = nullptr);
+
+private:
+    /**
+     * @struct StringTable
+     * @brief Strings packed into one character array; string i is chars[offset[i] .. offset[i + 1]).
+     */
+    struct StringTable {
+        std::vector<uint32_t> offset;
+        std::vector<char> chars;
+
+        StringTable() : offset(1, 0) {}
+        void add(const std::string& text);
+        std::string get(std::size_t i) const;
+        std::size_t size() const { return offset.size() - 1; }
+    };
+
+    /**
+     * @struct EdgeRecord
+     * @brief A road, stored with the roads of its start intersection.
+     */
+    struct EdgeRecord {
+        int32_t target;        /**< Index of the end intersection */
+        int32_t travelTime;    /**< Travel time in seconds */
+        uint8_t blocked;       /**< Edge::blocked */
+        uint8_t underRepair;   /**< Edge::underRepaired */
+        uint8_t padding[2];
+    };
+
+    /**
+     * @struct VehicleRecord
+     * @brief The fixed-size part of a vehicle; its strings are in the vehicle string tables.
+     */
+    struct VehicleRecord {
+        uint32_t pathStart;    /**< First entry of the path in the path string table */
+        uint32_t pathEntries;  /**< Number of entries of Vehicle::path */
+        int32_t pathLength;    /**< Vehicle::pathLength */
+        int32_t position;      /**< Vehicle::currentIntersectionInPath */
+        uint8_t presetPath;    /**< Vehicle::presetPath */
+        uint8_t padding[3];
+    };
+
+    /**
+     * @struct SignalRecord
+     * @brief A traffic signal.
+     */
+    struct SignalRecord {
+        int32_t duration;
+        int32_t transitionTime;
+        int32_t temp;
+        int32_t cycleLength;
+        int32_t offset;
+        char intersectionId;   /**< First character of the name, read when the file has no signal names */
+        char greenApproach;    /**< First character of the name, read when the file has no signal names */
+        uint8_t state;         /**< 0 red, 1 yellow, 2 green */
+        uint8_t padding;
+    };
+
+    /**
+     * @struct RoadCountRecord
+     * @brief A road of the congestion hash table, in chain order.
+     */
+    struct RoadCountRecord {
+        int32_t bucket;        /**< Index in CongestionMonitoring::hashTable */
+        int32_t carCount;
+        char start;
+        char end;
+        uint8_t padding[2];
+    };
+
+    enum SectionTag {
+        TAG_GRAPH_NAMES_OFFSET = 1,
+        TAG_GRAPH_NAMES_CHARS,
+        TAG_GRAPH_EDGE_OFFSET,
+        TAG_GRAPH_EDGES,
+        TAG_VEHICLES,
+        TAG_VEHICLE_IDS_OFFSET,
+        TAG_VEHICLE_IDS_CHARS,
+        TAG_VEHICLE_ENDPOINTS_OFFSET,
+        TAG_VEHICLE_ENDPOINTS_CHARS,
+        TAG_VEHICLE_PRIORITIES_OFFSET,
+        TAG_VEHICLE_PRIORITIES_CHARS,
+        TAG_VEHICLE_PATHS_OFFSET,
+        TAG_VEHICLE_PATHS_CHARS,
+        TAG_SIGNALS,
+        TAG_ROAD_COUNTS,
+        TAG_BLOCKED_OFFSET,
+        TAG_BLOCKED_CHARS,
+        TAG_BLOCKED_FLAGS,
+        TAG_REPAIR_OFFSET,
+        TAG_REPAIR_CHARS,
+        TAG_REPAIR_FLAGS,
+        TAG_STORE_IDS,
+        TAG_STORE_CURRENT_EDGE,
+        TAG_STORE_PATH_OFFSET,
+        TAG_STORE_PATH_LENGTH,
+        TAG_STORE_PATH_POSITION,
+        TAG_STORE_PRIORITY,
+        TAG_STORE_PATH_ARENA,
+        TAG_STORE_STATE,
+        TAG_SIGNAL_NAMES_OFFSET,
+        TAG_SIGNAL_NAMES_CHARS
+    };
+
+    /**
+     * @struct SectionHeader
+     * @brief Precedes the records of every section.
+     */
+    struct SectionHeader {
+        uint32_t tag;          /**< A SectionTag */
+        uint32_t elementSize;  /**< sizeof one record, checked on restore */
+        uint64_t count;        /**< Number of records */
+    };
+
+    template <typename T>
+    static bool writeSection(std::FILE* file, uint32_t tag, const std::vector<T>& values, uint32_t& sections);
+    static bool writeStrings(std::FILE* file, uint32_t offsetTag, uint32_t charsTag, const StringTable& table, uint32_t& sections);
+    template <typename T>
+    static bool readSection(std::FILE* file, const SectionHeader& header, std::vector<T>& values);
+    static bool isValid(const StringTable& table);
+};
+
+#endif // CHECKPOINT_H
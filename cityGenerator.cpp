@@ -0,0 +1,354 @@
+#include "cityGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+const double PI = 3.14159265358979323846;
+
+// Buffered CSV output; numbers are formatted by hand, as printf would dominate for 10^7 rows
+class CsvWriter {
+public:
+    explicit CsvWriter(const std::string& filename) : filename(filename), file(std::fopen(filename.c_str(), "wb")), ok(file != nullptr) {
+        if (!file)
+            std::cerr << "Error: Unable to open file " << filename << std::endl;
+        buffer.reserve(BUFFER_SIZE + 256);
+    }
+
+    ~CsvWriter() { close(); }
+
+    CsvWriter& text(const char* value) { buffer += value; return *this; }
+    CsvWriter& character(char value) { buffer += value; return *this; }
+
+    CsvWriter& number(long long value) {
+        char digits[24];
+        int length = 0;
+        unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : value;
+        do {
+            digits[length++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0)
+            buffer += '-';
+        while (length)
+            buffer += digits[--length];
+        return *this;
+    }
+
+    // one decimal is enough for coordinates in units of about one road
+    CsvWriter& decimal(double value) {
+        long long tenths = static_cast<long long>(std::floor(value * 10 + 0.5));
+        if (tenths < 0) {
+            buffer += '-';
+            tenths = -tenths;
+        }
+        number(tenths / 10);
+        buffer += '.';
+        buffer += static_cast<char>('0' + tenths % 10);
+        return *this;
+    }
+
+    CsvWriter& name(long long intersection) { buffer += 'I'; return number(intersection); }
+
+    void endLine() {
+        buffer += '\n';
+        if (buffer.size() >= BUFFER_SIZE)
+            flush();
+    }
+
+    bool close() {
+        if (file) {
+            flush();
+            ok = std::fclose(file) == 0 && ok;
+            file = nullptr;
+            if (!ok)
+                std::cerr << "Error: Unable to write file " << filename << std::endl;
+        }
+        return ok;
+    }
+
+private:
+    static const std::size_t BUFFER_SIZE = 1 << 20;
+    std::string filename;
+    std::FILE* file;
+    std::string buffer;
+    bool ok;
+
+    void flush() {
+        if (file && !buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+            ok = false;
+        buffer.clear();
+    }
+};
+
+int32_t findRoot(std::vector<int32_t>& parent, int32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+}
+
+CityGenerator::CityGenerator(const CityOptions& options) : options(options), rng(options.seed) {}
+
+// Random integer in [0, bound), drawn the same way with every standard library
+uint64_t CityGenerator::below(uint64_t bound) {
+    return bound ? rng() % bound : 0;
+}
+
+// Random number in [0, 1)
+double CityGenerator::uniform() {
+    return (rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void CityGenerator::addRoad(long long a, long long b) {
+    double length = std::sqrt(static_cast<double>(x[a] - x[b]) * (x[a] - x[b]) + static_cast<double>(y[a] - y[b]) * (y[a] - y[b]));
+    double time = length * options.secondsPerUnit * (0.8 + 0.4 * uniform());
+    roadFrom.push_back(static_cast<int32_t>(a));
+    roadTo.push_back(static_cast<int32_t>(b));
+    travelTime.push_back(std::max(1, static_cast<int32_t>(time + 0.5)));
+}
+
+void CityGenerator::generate() {
+    rng.seed(options.seed);
+    long long n = std::max(2LL, options.intersections);
+    x.assign(n, 0);
+    y.assign(n, 0);
+    roadFrom.clear();
+    roadTo.clear();
+    travelTime.clear();
+
+    if (options.layout == CITY_RADIAL)
+        makeRadial();
+    else if (options.layout == CITY_RANDOM_GEOMETRIC)
+        makeRandomGeometric();
+    else
+        makeGrid();
+
+    // a signal at every intersection where three or more roads meet
+    std::vector<int32_t> degree(n, 0);
+    for (std::size_t r = 0; r < roadFrom.size(); r++) {
+        degree[roadFrom[r]]++;
+        degree[roadTo[r]]++;
+    }
+    signalAt.clear();
+    greenTime.clear();
+    for (long long i = 0; i < n; i++) {
+        if (degree[i] >= 3) {
+            signalAt.push_back(static_cast<int32_t>(i));
+            greenTime.push_back(static_cast<int32_t>(20 + below(41)));
+        }
+    }
+
+    // each direction of each road is closed independently
+    closedRoad.clear();
+    closedBlocked.clear();
+    for (int64_t direction = 0; direction < static_cast<int64_t>(2 * roadFrom.size()); direction++) {
+        if (uniform() < options.closureShare) {
+            closedRoad.push_back(direction);
+            closedBlocked.push_back(uniform() < 0.7);
+        }
+    }
+
+    tripStart.resize(std::max(0LL, options.vehicles));
+    tripEnd.resize(tripStart.size());
+    for (std::size_t v = 0; v < tripStart.size(); v++) {
+        tripStart[v] = static_cast<int32_t>(below(n));
+        tripEnd[v] = static_cast<int32_t>(below(n - 1));
+        if (tripEnd[v] >= tripStart[v])
+            tripEnd[v]++;
+    }
+}
+
+void CityGenerator::makeGrid() {
+    long long n = static_cast<long long>(x.size());
+    long long side = static_cast<long long>(std::ceil(std::sqrt(static_cast<double>(n))));
+    for (long long i = 0; i < n; i++) {
+        x[i] = static_cast<float>(i % side);
+        y[i] = static_cast<float>(i / side);
+    }
+    roadFrom.reserve(2 * n);
+    for (long long i = 0; i < n; i++) {
+        if (i % side + 1 < side && i + 1 < n)
+            addRoad(i, i + 1);
+        if (i + side < n)
+            addRoad(i, i + side);
+    }
+}
+
+void CityGenerator::makeRadial() {
+    // rings one unit apart with as many spokes as keep the outer ring's roads about one unit long
+    long long n = static_cast<long long>(x.size());
+    long long rings = std::max(1LL, static_cast<long long>(std::sqrt((n - 1) / (2 * PI)) + 0.5));
+    long long spokes = std::max(3LL, (n - 1 + rings - 1) / rings);
+    for (long long i = 1; i < n; i++) {
+        long long ring = (i - 1) / spokes + 1, spoke = (i - 1) % spokes;
+        x[i] = static_cast<float>(ring * std::cos(2 * PI * spoke / spokes));
+        y[i] = static_cast<float>(ring * std::sin(2 * PI * spoke / spokes));
+    }
+    roadFrom.reserve(2 * n);
+    for (long long i = 1; i < n; i++) {
+        long long ring = (i - 1) / spokes + 1, spoke = (i - 1) % spokes;
+        if (ring == 1)
+            addRoad(0, i);
+        // along the ring; the last ring may be partial and then does not close
+        if (spoke + 1 < spokes && i + 1 < n)
+            addRoad(i, i + 1);
+        else if (spoke + 1 == spokes)
+            addRoad(i, i - spokes + 1);
+        // outwards along the spoke
+        if (i + spokes < n)
+            addRoad(i, i + spokes);
+    }
+}
+
+void CityGenerator::makeRandomGeometric() {
+    // one intersection per unit of area; neighbours within the radius that gives five roads on average
+    long long n = static_cast<long long>(x.size());
+    double side = std::sqrt(static_cast<double>(n));
+    double radius = std::sqrt(5.0 / PI);
+    for (long long i = 0; i < n; i++) {
+        x[i] = static_cast<float>(uniform() * side);
+        y[i] = static_cast<float>(uniform() * side);
+    }
+
+    // bucket the intersections into cells of the radius, so only the 3 x 3 cells around one are searched
+    long long cellsPerSide = std::max(1LL, static_cast<long long>(side / radius));
+    double cellSize = side / cellsPerSide;
+    std::vector<int32_t> cellOf(n), cellStart(cellsPerSide * cellsPerSide + 1, 0), order(n);
+    for (long long i = 0; i < n; i++) {
+        long long cx = std::min(cellsPerSide - 1, static_cast<long long>(x[i] / cellSize));
+        long long cy = std::min(cellsPerSide - 1, static_cast<long long>(y[i] / cellSize));
+        cellOf[i] = static_cast<int32_t>(cy * cellsPerSide + cx);
+        cellStart[cellOf[i] + 1]++;
+    }
+    for (std::size_t c = 1; c < cellStart.size(); c++)
+        cellStart[c] += cellStart[c - 1];
+    std::vector<int32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (long long i = 0; i < n; i++)
+        order[fill[cellOf[i]]++] = static_cast<int32_t>(i);
+
+    std::vector<int32_t> parent(n);
+    for (long long i = 0; i < n; i++)
+        parent[i] = static_cast<int32_t>(i);
+    roadFrom.reserve(3 * n);
+    double radius2 = radius * radius;
+    for (long long cy = 0; cy < cellsPerSide; cy++) {
+        for (long long cx = 0; cx < cellsPerSide; cx++) {
+            long long cell = cy * cellsPerSide + cx;
+            for (int32_t k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+                int32_t a = order[k];
+                for (long long ny = std::max(0LL, cy - 1); ny <= std::min(cellsPerSide - 1, cy + 1); ny++) {
+                    for (long long nx = std::max(0LL, cx - 1); nx <= std::min(cellsPerSide - 1, cx + 1); nx++) {
+                        long long other = ny * cellsPerSide + nx;
+                        for (int32_t m = cellStart[other]; m < cellStart[other + 1]; m++) {
+                            int32_t b = order[m];
+                            if (b <= a)
+                                continue;
+                            double dx = x[a] - x[b], dy = y[a] - y[b];
+                            if (dx * dx + dy * dy <= radius2) {
+                                addRoad(a, b);
+                                parent[findRoot(parent, a)] = findRoot(parent, b);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // join what is left disconnected to the intersection visited before it when walking the cells row by
+    // row in alternating directions, which is close by
+    int32_t previous = -1;
+    for (long long cy = 0; cy < cellsPerSide; cy++) {
+        for (long long step = 0; step < cellsPerSide; step++) {
+            long long cell = cy * cellsPerSide + (cy % 2 == 0 ? step : cellsPerSide - 1 - step);
+            for (int32_t k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+                int32_t b = order[k];
+                if (previous != -1 && findRoot(parent, previous) != findRoot(parent, b)) {
+                    addRoad(previous, b);
+                    parent[findRoot(parent, previous)] = findRoot(parent, b);
+                }
+                previous = b;
+            }
+        }
+    }
+}
+
+bool CityGenerator::write(const std::string& directory) const {
+    std::string prefix = directory.empty() ? "" : directory + "/";
+    long long n = static_cast<long long>(x.size());
+
+    CsvWriter network(prefix + "road_network.csv");
+    network.text("Intersection1,Intersection2,TravelTime").endLine();
+    for (std::size_t r = 0; r < roadFrom.size(); r++) {
+        network.name(roadFrom[r]).character(',').name(roadTo[r]).character(',').number(travelTime[r]).endLine();
+        network.name(roadTo[r]).character(',').name(roadFrom[r]).character(',').number(travelTime[r]).endLine();
+    }
+
+    CsvWriter intersections(prefix + "intersections.csv");
+    intersections.text("Intersection,X,Y").endLine();
+    for (long long i = 0; i < n; i++)
+        intersections.name(i).character(',').decimal(x[i]).character(',').decimal(y[i]).endLine();
+
+    CsvWriter signals(prefix + "traffic_signals.csv");
+    signals.text("Intersection,GreenTime(s)").endLine();
+    for (std::size_t s = 0; s < signalAt.size(); s++)
+        signals.name(signalAt[s]).character(',').number(greenTime[s]).endLine();
+
+    CsvWriter closures(prefix + "road_closures.csv");
+    closures.text("Intersection1,Intersection2,Status").endLine();
+    for (std::size_t c = 0; c < closedRoad.size(); c++) {
+        std::size_t road = static_cast<std::size_t>(closedRoad[c] / 2);
+        bool reverse = closedRoad[c] % 2 != 0;
+        closures.name(reverse ? roadTo[road] : roadFrom[road]).character(',').name(reverse ? roadFrom[road] : roadTo[road]);
+        closures.text(closedBlocked[c] ? ",Blocked" : ",Under Repair").endLine();
+    }
+
+    // the first vehicles are the emergency vehicles, alternately High and Medium priority
+    std::size_t emergency = static_cast<std::size_t>(tripStart.size() * options.emergencyShare + 0.5);
+    CsvWriter emergencyVehicles(prefix + "emergency_vehicles.csv");
+    emergencyVehicles.text("VehicleID,StartIntersection,EndIntersection,PriorityLevel").endLine();
+    for (std::size_t v = 0; v < emergency && v < tripStart.size(); v++) {
+        emergencyVehicles.text("EV").number(v + 1).character(',').name(tripStart[v]).character(',').name(tripEnd[v]);
+        emergencyVehicles.text(v % 2 == 0 ? ",High" : ",Medium").endLine();
+    }
+    CsvWriter vehicles(prefix + "vehicles.csv");
+    vehicles.text("VehicleID,StartIntersection,EndIntersection").endLine();
+    for (std::size_t v = emergency; v < tripStart.size(); v++)
+        vehicles.text("V").number(v - emergency + 1).character(',').name(tripStart[v]).character(',').name(tripEnd[v]).endLine();
+
+    bool ok = network.close();
+    ok = intersections.close() && ok;
+    ok = signals.close() && ok;
+    ok = closures.close() && ok;
+    ok = emergencyVehicles.close() && ok;
+    ok = vehicles.close() && ok;
+    return ok;
+}
+
+std::string CityGenerator::intersectionName(long long intersection) {
+    return "I" + std::to_string(intersection);
+}
+
+bool CityGenerator::parseLayout(const std::string& name, CityLayout& layout) {
+    if (name == "grid")
+        layout = CITY_GRID;
+    else if (name == "radial")
+        layout = CITY_RADIAL;
+    else if (name == "geometric")
+        layout = CITY_RANDOM_GEOMETRIC;
+    else
+        return false;
+    return true;
+}
+
+long long CityGenerator::getIntersectionCount() const {
+    return static_cast<long long>(x.size());
+}
+
+long long CityGenerator::getRoadCount() const {
+    return static_cast<long long>(roadFrom.size());
+}
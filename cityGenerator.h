@@ -0,0 +1,125 @@
+#ifndef CITY_GENERATOR_H
+#define CITY_GENERATOR_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @enum CityLayout
+ * @brief The street patterns a CityGenerator can produce.
+ */
+enum CityLayout {
+    CITY_GRID,               /**< Square grid, roads to the four neighbours */
+    CITY_RADIAL,             /**< Rings around a centre joined by spokes */
+    CITY_RANDOM_GEOMETRIC    /**< Random points joined to the points within a fixed radius */
+};
+
+/**
+ * @struct CityOptions
+ * @brief Parameters of a generated city.
+ */
+struct CityOptions {
+    CityLayout layout;        /**< Street pattern */
+    long long intersections;  /**< Number of intersections */
+    long long vehicles;       /**< Number of vehicles (regular and emergency) */
+    double emergencyShare;    /**< Share of the vehicles that are emergency vehicles */
+    double closureShare;      /**< Share of the roads that are blocked or under repair */
+    double secondsPerUnit;    /**< Travel time of a road per unit of length (neighbouring intersections are about one unit apart) */
+    uint64_t seed;            /**< Seed of the random generator; the same options always give the same city */
+
+    /**
+     * @brief Default options: a 100-intersection grid with as many vehicles.
+     */
+    CityOptions()
+        : layout(CITY_GRID), intersections(100), vehicles(100), emergencyShare(0.05), closureShare(0.01),
+          secondsPerUnit(20), seed(1) {}
+};
+
+/**
+ * @class CityGenerator
+ * @brief Generates seeded, reproducible road networks and demand for scale testing.
+ *
+ * generate() lays out the intersections of the chosen pattern, joins them by two-way roads whose
+ * travel time follows their length, and draws the signals, road closures and vehicle trips; write()
+ * saves them in the dataset CSV formats read by the loaders (road_network.csv, traffic_signals.csv,
+ * vehicles.csv, emergency_vehicles.csv, road_closures.csv) plus intersections.csv with the coordinates
+ * of every intersection. Intersections are named I0, I1, ... and every network is connected.
+ *
+ * Randomness comes from std::mt19937_64 only, whose output the standard fixes, so a seed gives the same
+ * files with every compiler. Memory grows linearly (about 60 bytes per intersection for a grid), so
+ * networks of 10^7 intersections are generated in seconds.
+ */
+class CityGenerator {
+public:
+    /**
+     * @brief Constructs a generator; nothing is generated until generate().
+     * @param options The parameters of the city.
+     */
+    explicit CityGenerator(const CityOptions& options);
+
+    /**
+     * @brief Generates the network, signals, closures and vehicles, replacing any previous city.
+     */
+    void generate();
+
+    /**
+     * @brief Writes the city to CSV files.
+     * @param directory An existing directory to write the files to.
+     * @return true on success, false if a file could not be written.
+     */
+    bool write(const std::string& directory) const;
+
+    /**
+     * @brief Gets the name of an intersection.
+     * @param intersection The index of the intersection.
+     * @return std::string
+     */
+    static std::string intersectionName(long long intersection);
+
+    /**
+     * @brief Parses a layout name ("grid", "radial" or "geometric").
+     * @param name The name.
+     * @param layout Receives the layout.
+     * @return true if the name is known, false otherwise.
+     */
+    static bool parseLayout(const std::string& name, CityLayout& layout);
+
+    /**
+     * @brief Gets the number of intersections generated.
+     * @return long long
+     */
+    long long getIntersectionCount() const;
+
+    /**
+     * @brief Gets the number of two-way roads generated (each is two rows of road_network.csv).
+     * @return long long
+     */
+    long long getRoadCount() const;
+
+    std::vector<float> x;               /**< X coordinate of each intersection */
+    std::vector<float> y;               /**< Y coordinate of each intersection */
+    std::vector<int32_t> roadFrom;      /**< One end of each two-way road */
+    std::vector<int32_t> roadTo;        /**< The other end of each two-way road */
+    std::vector<int32_t> travelTime;    /**< Travel time of each road in seconds (both directions) */
+    std::vector<int32_t> signalAt;      /**< Intersections with a traffic signal */
+    std::vector<int32_t> greenTime;     /**< Green time of each signal in seconds */
+    std::vector<int64_t> closedRoad;    /**< Closed roads: 2 * road for roadFrom -> roadTo, 2 * road + 1 for the reverse */
+    std::vector<uint8_t> closedBlocked; /**< 1 if the closed road is blocked, 0 if under repair */
+    std::vector<int32_t> tripStart;     /**< Start intersection of each vehicle */
+    std::vector<int32_t> tripEnd;       /**< End intersection of each vehicle */
+
+private:
+    CityOptions options;
+    std::mt19937_64 rng;
+
+    uint64_t below(uint64_t bound);
+    double uniform();
+    void addRoad(long long a, long long b);
+    void makeGrid();
+    void makeRadial();
+    void makeRandomGeometric();
+};
+
+#endif // CITY_GENERATOR_H
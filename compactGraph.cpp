@@ -0,0 +1,70 @@
+#include "compactGraph.h"
+
+const unsigned char CompactGraph::EDGE_BLOCKED;
+const unsigned char CompactGraph::EDGE_UNDER_REPAIR;
+
+CompactGraph::CompactGraph() : version(-1) {}
+
+void CompactGraph::build(Graph& graph) {
+    names.clear();
+    indexOf.clear();
+    edgeOffset.clear();
+    edgeSource.clear();
+    edgeTarget.clear();
+    travelTime.clear();
+    edgeFlags.clear();
+
+    // number the intersections in vertex list order
+    for (VertexNode* v = graph.headVertex; v; v = v->next) {
+        indexOf[v->vertex->name] = static_cast<int>(names.size());
+        names.push_back(v->vertex->name);
+    }
+
+    // roads are stored grouped by start intersection, in adjacency list order
+    edgeOffset.push_back(0);
+    int source = 0;
+    for (VertexNode* v = graph.headVertex; v; v = v->next, source++) {
+        for (EdgeNode* e = v->vertex->edges; e; e = e->next) {
+            edgeSource.push_back(source);
+            edgeTarget.push_back(findIntersection(e->edge->destination->name));
+            travelTime.push_back(e->edge->travelTime);
+            edgeFlags.push_back((e->edge->isBlocked() ? EDGE_BLOCKED : 0) |
+                                (e->edge->isUnderRepaired() ? EDGE_UNDER_REPAIR : 0));
+        }
+        edgeOffset.push_back(static_cast<int>(edgeTarget.size()));
+    }
+    version = graph.getTopologyVersion();
+}
+
+void CompactGraph::refreshFlags(Graph& graph) {
+    int edge = 0;
+    for (VertexNode* v = graph.headVertex; v; v = v->next) {
+        for (EdgeNode* e = v->vertex->edges; e && edge < getEdgeCount(); e = e->next, edge++) {
+            edgeFlags[edge] = (e->edge->isBlocked() ? EDGE_BLOCKED : 0) |
+                              (e->edge->isUnderRepaired() ? EDGE_UNDER_REPAIR : 0);
+        }
+    }
+}
+
+int CompactGraph::findIntersection(const std::string& name) const {
+    std::unordered_map<std::string, int>::const_iterator found = indexOf.find(name);
+    return found == indexOf.end() ? -1 : found->second;
+}
+
+int CompactGraph::findEdge(int from, int to) const {
+    if (from < 0 || from >= getIntersectionCount())
+        return -1;
+    for (int e = edgeOffset[from]; e < edgeOffset[from + 1]; e++) {
+        if (edgeTarget[e] == to)
+            return e;
+    }
+    return -1;
+}
+
+int CompactGraph::getIntersectionCount() const {
+    return static_cast<int>(names.size());
+}
+
+int CompactGraph::getEdgeCount() const {
+    return static_cast<int>(edgeTarget.size());
+}
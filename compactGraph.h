@@ -0,0 +1,81 @@
+#ifndef COMPACT_GRAPH_H
+#define COMPACT_GRAPH_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "graph.h"
+
+/**
+ * @class CompactGraph
+ * @brief Index-based (CSR) copy of the road network.
+ *
+ * Intersections are numbered 0..n-1 in the order of Graph's vertex list and roads are numbered
+ * 0..m-1 grouped by their start intersection: the roads leaving intersection i are
+ * edgeOffset[i] .. edgeOffset[i + 1] - 1. Simulation structures that handle millions of vehicles
+ * refer to intersections and roads by these indices instead of names or pointers.
+ */
+class CompactGraph {
+public:
+    static const unsigned char EDGE_BLOCKED = 1;       /**< Flag set on blocked roads */
+    static const unsigned char EDGE_UNDER_REPAIR = 2;  /**< Flag set on roads under repair */
+
+    std::vector<std::string> names;          /**< Intersection names indexed by intersection */
+    std::vector<int> edgeOffset;             /**< First road of each intersection (size n + 1) */
+    std::vector<int> edgeSource;             /**< Start intersection of each road */
+    std::vector<int> edgeTarget;             /**< End intersection of each road */
+    std::vector<int> travelTime;             /**< Travel time of each road */
+    std::vector<unsigned char> edgeFlags;    /**< EDGE_BLOCKED / EDGE_UNDER_REPAIR flags of each road */
+    int version;                             /**< Graph topology version this copy was built from (-1 if never built) */
+
+    /**
+     * @brief Constructs an empty CompactGraph.
+     */
+    CompactGraph();
+
+    /**
+     * @brief Rebuilds the compact copy from the road network.
+     * @param graph The road network.
+     */
+    void build(Graph& graph);
+
+    /**
+     * @brief Copies the blocked and under-repair status of every road from the road network.
+     *
+     * Cheaper than build() when only road statuses changed.
+     * @param graph The road network the copy was built from.
+     */
+    void refreshFlags(Graph& graph);
+
+    /**
+     * @brief Finds an intersection by name.
+     * @param name The name of the intersection.
+     * @return The index of the intersection, or -1 if not found.
+     */
+    int findIntersection(const std::string& name) const;
+
+    /**
+     * @brief Finds the road between two intersections.
+     * @param from The index of the start intersection.
+     * @param to The index of the end intersection.
+     * @return The index of the road, or -1 if no road exists.
+     */
+    int findEdge(int from, int to) const;
+
+    /**
+     * @brief Gets the number of intersections.
+     * @return int
+     */
+    int getIntersectionCount() const;
+
+    /**
+     * @brief Gets the number of roads.
+     * @return int
+     */
+    int getEdgeCount() const;
+
+private:
+    std::unordered_map<std::string, int> indexOf;  /**< Intersection name -> index */
+};
+
+#endif // COMPACT_GRAPH_H
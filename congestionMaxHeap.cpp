@@ -1,28 +1,52 @@
 # include"congestionMaxHeap.h"
+# include"memoryAccounting.h"
+# include"profiler.h"
 # include"roadQueue.h"
 # include<iostream>
+# include<new>
+
+namespace {
+// RoadNode::operator new accounts to the congestion table; the copies of the heap are its own
+RoadNode* newHeapNode(const RoadNode& road){
+      void* block = ::operator new(sizeof(RoadNode));
+      MemoryAccounting::allocated(MEMORY_HEAP, sizeof(RoadNode));
+      return ::new (block) RoadNode(road.path[0], road.path[1], road.carCount);
+}
+
+void deleteHeapNode(RoadNode* node){
+      node->~RoadNode();
+      MemoryAccounting::released(MEMORY_HEAP, sizeof(RoadNode));
+      ::operator delete(node);
+}
+}
 
 CongestionMaxHeap::CongestionMaxHeap(){
       root = NULL;
 }
 
-void CongestionMaxHeap::makeHeap(RoadNode* hashTableArray, int size){
-      for(int i = 0; i < size; i++){
-       
-            RoadNode* newNode = &hashTableArray[i];
-       
-            if (newNode->carCount > 0){
+CongestionMaxHeap::~CongestionMaxHeap(){
+      destroy(root);
+}
 
-                  insert(newNode);
+void CongestionMaxHeap::destroy(RoadNode* node){
+      if (node == NULL)
+            return;
+      destroy(node->left);
+      destroy(node->right);
+      deleteHeapNode(node);
+}
 
-                  while(newNode->right != NULL){
+void CongestionMaxHeap::makeHeap(RoadNode* hashTableArray, int size){
+      PROFILE_SCOPE(PROFILE_HEAP);
+      destroy(root);
+      root = NULL;
 
-                        newNode = newNode->right;
-                        if (newNode->carCount > 0)
-                              insert(newNode);
-                        
-                  }
+      for(int i = 0; i < size; i++){
 
+            // insert a copy of every road of the chain, the heap relinks its nodes
+            for (RoadNode* road = &hashTableArray[i]; road != NULL; road = road->right){
+                  if (road->carCount > 0)
+                        insert(newHeapNode(*road));
             }
       }
 }
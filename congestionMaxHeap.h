@@ -24,6 +24,13 @@ class CongestionMaxHeap{
          * @param root The root node of the heap/subtree.
          */
         void inorder(RoadNode* root);
+
+        /**
+         * @brief Deletes the nodes of a heap/subtree.
+         * 
+         * @param node The root node of the heap/subtree.
+         */
+        void destroy(RoadNode* node);
     public:
         /**
          * @brief Construct a new Congestion Max Heap object
@@ -32,9 +39,17 @@ class CongestionMaxHeap{
          * 
          */
         CongestionMaxHeap();
+        /**
+         * @brief Destroy the Congestion Max Heap object and its nodes
+         * 
+         */
+        ~CongestionMaxHeap();
         /**
          * @brief Makes a max heap from the roads in the hashtable array
          * 
+         * The heap holds copies of the roads, so the hash table (and its collision chains) is left
+         * untouched and the heap can be rebuilt whenever the counts change.
+         * 
          * @param hashTableArray hashTableArray is from the congestion monitoring class
          * @param size size of the hashtable array
          */
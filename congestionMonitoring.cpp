@@ -1,4 +1,7 @@
 # include "congestionMonitoring.h"
+# include "linkModel.h"
+# include "profiler.h"
+# include "tracer.h"
 # include <iostream>
 # include <string>
 // private functions
@@ -93,6 +96,7 @@ CongestionMonitoring::CongestionMonitoring(Vehicle* vehiclesHead) : hashTableSiz
 
 
 void CongestionMonitoring::makeHashTable(Vehicle* vehiclesHead){
+    PROFILE_SCOPE(PROFILE_CONGESTION);
 
     // first we need to check if the hash table is empty and make it empty if it is not
     this->deleteTable();
@@ -102,7 +106,7 @@ void CongestionMonitoring::makeHashTable(Vehicle* vehiclesHead){
 
     while(temp) {
         char p[] = {'\0', '\0'};
-        if (temp->presetPath) {
+        if (temp->presetPath && temp->currentIntersectionInPath + 1 < temp->pathLength) {
             p[0] = temp->path[temp->currentIntersectionInPath][0];
             p[1] = temp->path[temp->currentIntersectionInPath+1][0];
         }
@@ -122,6 +126,25 @@ void CongestionMonitoring::makeHashTable(Vehicle* vehiclesHead){
     }
 }
 
+void CongestionMonitoring::makeHashTable(const LinkModel& links) {
+    PROFILE_SCOPE(PROFILE_CONGESTION);
+    TRACE_SCOPE("congestionTable", "congestion");
+    this->deleteTable();
+
+    const CompactGraph& graph = links.getGraph();
+    for (int link = 0; link < links.getLinkCount(); link++) {
+        int count = links.getQueueLength(link);
+        const std::string& start = graph.names[graph.edgeSource[link]];
+        const std::string& end = graph.names[graph.edgeTarget[link]];
+        if (count == 0 || start.size() != 1 || end.size() != 1) continue;
+        if (start[0] < 'A' || start[0] > 'Z' || end[0] < 'A' || end[0] > 'Z') continue;
+
+        // addToTable counts the first vehicle of a road, the others are added at once
+        addToTable(hashFunction(start[0], end[0]), start[0], end[0]);
+        findRoadNode(start[0], end[0])->carCount = count;
+    }
+}
+
 void CongestionMonitoring::updateHashTable(Vehicle* prevPos, Vehicle* currentPos) {
 }
 
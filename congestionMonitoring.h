@@ -6,6 +6,8 @@
 # include "RoadNode.h"
 const int HASH_TABLE_SIZE = 100;
 
+class LinkModel;
+
 /**
  * @class CongestionMonitoring
  * @brief A class for tracking the number of vehicles on a road using a hash table.
@@ -83,6 +85,15 @@ class CongestionMonitoring {
          * @param vehiclesHead Pointer to the head of the linked list of vehicles.
          */
         void makeHashTable(Vehicle* vehiclesHead);
+        /**
+         * @brief Creates the hash table from the queues of a link model.
+         * 
+         * Each road gets the number of vehicles currently queued on it. Roads whose intersections
+         * are not single letters A-Z are not tracked.
+         * 
+         * @param links The link model the vehicles move through.
+         */
+        void makeHashTable(const LinkModel& links);
            /**
          * @brief Updates the hash table with the new position of a vehicle.
          * 
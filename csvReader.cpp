@@ -0,0 +1,201 @@
+#include "csvReader.h"
+#include "parallelFor.h"
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool CsvField::equals(const char* text) const {
+    return std::strlen(text) == size && std::memcmp(data, text, size) == 0;
+}
+
+bool CsvField::toInt(int& value) const {
+    const char* p = data;
+    const char* last = data + size;
+    while (p < last && (*p == ' ' || *p == '\t'))
+        p++;
+    while (last > p && (last[-1] == ' ' || last[-1] == '\t'))
+        last--;
+    bool negative = false;
+    if (p < last && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    if (p == last)
+        return false;
+
+    long long magnitude = 0;
+    for (; p < last; p++) {
+        unsigned digit = static_cast<unsigned>(*p - '0');
+        if (digit > 9)
+            return false;
+        magnitude = magnitude * 10 + digit;
+        if (magnitude > static_cast<long long>(INT_MAX) + 1)
+            return false;
+    }
+    if (negative)
+        magnitude = -magnitude;
+    if (magnitude > INT_MAX)
+        return false;
+    value = static_cast<int>(magnitude);
+    return true;
+}
+
+bool CsvField::toDouble(double& value) const {
+    // strtod needs a terminated string: numbers are short, so copy to the stack
+    char text[64];
+    const char* p = data;
+    const char* last = data + size;
+    while (p < last && (*p == ' ' || *p == '\t'))
+        p++;
+    while (last > p && (last[-1] == ' ' || last[-1] == '\t'))
+        last--;
+    if (p == last || last - p >= static_cast<std::ptrdiff_t>(sizeof(text)))
+        return false;
+    std::memcpy(text, p, last - p);
+    text[last - p] = '\0';
+    char* end;
+    double parsed = std::strtod(text, &end);
+    if (end != text + (last - p))
+        return false;
+    value = parsed;
+    return true;
+}
+
+CsvChunk::CsvChunk() : position(nullptr), end(nullptr) {}
+
+CsvChunk::CsvChunk(const char* begin, const char* end) : position(begin), end(end) {}
+
+bool CsvChunk::nextRow(std::vector<CsvField>& fields) {
+    fields.clear();
+    while (position < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+        if (!lineEnd)
+            lineEnd = end;
+        const char* next = lineEnd < end ? lineEnd + 1 : end;
+        if (lineEnd > position && lineEnd[-1] == '\r')
+            lineEnd--;
+        if (lineEnd == position) {
+            position = next; // empty line
+            continue;
+        }
+
+        const char* field = position;
+        for (const char* p = position; p < lineEnd; p++) {
+            if (*p == ',') {
+                fields.push_back(CsvField(field, p - field));
+                field = p + 1;
+            }
+        }
+        fields.push_back(CsvField(field, lineEnd - field));
+        position = next;
+        return true;
+    }
+    return false;
+}
+
+void CsvChunk::skipRow() {
+    std::vector<CsvField> fields;
+    nextRow(fields);
+}
+
+std::size_t CsvChunk::remaining() const {
+    return position < end ? end - position : 0;
+}
+
+std::vector<CsvChunk> CsvChunk::split(int count) const {
+    std::vector<CsvChunk> chunks;
+    std::size_t size = remaining();
+    if (count < 1)
+        count = 1;
+    const char* begin = position;
+    for (int c = 1; c <= count && begin < end; c++) {
+        // move the cut forward to the start of the next row
+        const char* cut = c == count ? end : position + size / count * c;
+        if (cut < begin)
+            cut = begin;
+        if (cut < end) {
+            const char* newline = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+            cut = newline ? newline + 1 : end;
+        }
+        chunks.push_back(CsvChunk(begin, cut));
+        begin = cut;
+    }
+    return chunks;
+}
+
+CsvReader::CsvReader() : data(nullptr), length(0), mapped(false) {}
+
+CsvReader::~CsvReader() {
+    close();
+}
+
+bool CsvReader::open(const std::string& filename) {
+    close();
+    int descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (descriptor == -1) {
+        std::cerr << "Error: Unable to open file " << filename << std::endl;
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+        void* mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapping != MAP_FAILED) {
+            // rows are read front to back: let the kernel read ahead aggressively
+            madvise(mapping, status.st_size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+            length = status.st_size;
+            mapped = true;
+        }
+    }
+    if (!mapped) {
+        char block[1 << 16];
+        ssize_t read;
+        while ((read = ::read(descriptor, block, sizeof(block))) > 0)
+            buffer.insert(buffer.end(), block, block + read);
+        data = buffer.empty() ? "" : buffer.data();
+        length = buffer.size();
+    }
+    ::close(descriptor);
+    rest = CsvChunk(data, data + length);
+    return true;
+}
+
+void CsvReader::close() {
+    if (mapped)
+        munmap(const_cast<char*>(data), length);
+    data = nullptr;
+    length = 0;
+    mapped = false;
+    buffer.clear();
+    rest = CsvChunk();
+}
+
+bool CsvReader::isOpen() const {
+    return data != nullptr;
+}
+
+std::size_t CsvReader::size() const {
+    return length;
+}
+
+bool CsvReader::nextRow(std::vector<CsvField>& fields) {
+    return rest.nextRow(fields);
+}
+
+void CsvReader::skipRow() {
+    rest.skipRow();
+}
+
+std::vector<CsvChunk> CsvReader::split(int count) {
+    if (count < 1)
+        count = rest.remaining() >= PARALLEL_BYTES ? defaultThreadCount() : 1;
+    std::vector<CsvChunk> chunks = rest.split(count);
+    rest = CsvChunk();
+    return chunks;
+}
@@ -0,0 +1,193 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @struct CsvField
+ * @brief One field of a CSV row: a view of the characters in the reader's buffer, without a copy.
+ *
+ * A field is valid while the CsvReader it came from is open.
+ */
+struct CsvField {
+    const char* data;  /**< First character of the field (not terminated) */
+    std::size_t size;  /**< Number of characters */
+
+    CsvField() : data(""), size(0) {}
+    CsvField(const char* data, std::size_t size) : data(data), size(size) {}
+
+    /**
+     * @brief Copies the field into a string.
+     * @return std::string
+     */
+    std::string str() const { return std::string(data, size); }
+
+    /**
+     * @brief Checks whether the field has no characters.
+     * @return true if the field is empty, false otherwise.
+     */
+    bool empty() const { return size == 0; }
+
+    /**
+     * @brief Compares the field with a string.
+     * @param text A null-terminated string.
+     * @return true if the field holds exactly text, false otherwise.
+     */
+    bool equals(const char* text) const;
+
+    /**
+     * @brief Parses the field as a decimal integer.
+     *
+     * Spaces around the number and a leading sign are accepted; anything else, including a number
+     * that does not fit in an int, is not.
+     * @param value Receives the number.
+     * @return true if the field is an integer, false otherwise (value is then unchanged).
+     */
+    bool toInt(int& value) const;
+
+    /**
+     * @brief Parses the field as a decimal floating-point number.
+     *
+     * Spaces around the number are accepted; anything else is not.
+     * @param value Receives the number.
+     * @return true if the field is a number, false otherwise (value is then unchanged).
+     */
+    bool toDouble(double& value) const;
+};
+
+/**
+ * @class CsvChunk
+ * @brief A range of whole rows of a CSV file, which can be parsed independently of the other ranges.
+ *
+ * Rows end with "\n" or "\r\n" and their fields are separated by commas (quoting is not supported,
+ * as no dataset file uses it); empty lines are skipped.
+ */
+class CsvChunk {
+public:
+    /**
+     * @brief Constructs an empty chunk.
+     */
+    CsvChunk();
+
+    /**
+     * @brief Constructs a chunk of the characters [begin, end).
+     * @param begin The first character of the first row.
+     * @param end One past the last character of the last row.
+     */
+    CsvChunk(const char* begin, const char* end);
+
+    /**
+     * @brief Splits the next row into fields.
+     * @param fields Receives the fields of the row (cleared first).
+     * @return true if a row was read, false at the end of the chunk.
+     */
+    bool nextRow(std::vector<CsvField>& fields);
+
+    /**
+     * @brief Skips the next row.
+     */
+    void skipRow();
+
+    /**
+     * @brief Gets the number of characters not read yet.
+     * @return std::size_t
+     */
+    std::size_t remaining() const;
+
+    /**
+     * @brief Splits the characters not read yet into chunks of about equal size that start at row boundaries.
+     * @param count The number of chunks wanted.
+     * @return The chunks in file order; fewer than count if there are fewer characters than chunks.
+     */
+    std::vector<CsvChunk> split(int count) const;
+
+private:
+    const char* position;
+    const char* end;
+};
+
+/**
+ * @class CsvReader
+ * @brief Reads a CSV file through a read-only memory mapping, handing out fields as views into it.
+ *
+ * The rows are read in order with nextRow(), or the remaining rows are split() into chunks to be
+ * parsed on several threads. Nothing is copied or allocated per row, so reading is limited by the
+ * disk or the page cache; the caller copies only the fields it keeps.
+ */
+class CsvReader {
+public:
+    /**
+     * @brief Files of at least this size are worth parsing on several threads.
+     */
+    static const std::size_t PARALLEL_BYTES = 8 << 20;
+
+    /**
+     * @brief Constructs a reader with no file open.
+     */
+    CsvReader();
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~CsvReader();
+
+    /**
+     * @brief Opens and maps a file, closing any file open before.
+     * @param filename The file to read.
+     * @return true on success, false if the file could not be opened (an error is printed).
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Unmaps the file; the fields handed out become invalid.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether a file is open.
+     * @return true if a file is open, false otherwise.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Gets the size of the open file in bytes.
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Splits the next row into fields.
+     * @param fields Receives the fields of the row (cleared first).
+     * @return true if a row was read, false at the end of the file.
+     */
+    bool nextRow(std::vector<CsvField>& fields);
+
+    /**
+     * @brief Skips the next row (e.g. the header).
+     */
+    void skipRow();
+
+    /**
+     * @brief Splits the rows not read yet into chunks for parsing in parallel.
+     *
+     * The reader itself is left at the end of the file.
+     * @param count The number of chunks wanted; 0 gives one chunk per hardware thread for files of
+     * at least PARALLEL_BYTES and a single chunk otherwise.
+     * @return The chunks in file order.
+     */
+    std::vector<CsvChunk> split(int count = 0);
+
+private:
+    const char* data;
+    std::size_t length;
+    bool mapped;               /**< data is a memory mapping, not a copy held in buffer */
+    std::vector<char> buffer;  /**< Contents of files that cannot be mapped (e.g. empty files or pipes) */
+    CsvChunk rest;             /**< Rows not read yet */
+
+    CsvReader(const CsvReader&);
+    CsvReader& operator=(const CsvReader&);
+};
+
+#endif // CSV_READER_H
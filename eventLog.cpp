@@ -0,0 +1,212 @@
+#include "eventLog.h"
+#include <iostream>
+#include "checkpoint.h"
+
+EventLog::EventLog() : events(nullptr), recorded(0), checkpoints(0) {}
+
+EventLog::~EventLog() {
+    close();
+}
+
+std::string EventLog::checkpointName(const std::string& base, int number) {
+    return base + "." + std::to_string(number) + ".ckpt";
+}
+
+bool EventLog::open(const std::string& base) {
+    close();
+    std::string indexName = base + ".index";
+    std::FILE* index = std::fopen(indexName.c_str(), "wb");
+    if (!index) {
+        std::cerr << "Error: Unable to open file " << indexName << std::endl;
+        return false;
+    }
+    std::fclose(index);
+    events = std::fopen((base + ".events").c_str(), "wb");
+    if (!events) {
+        std::cerr << "Error: Unable to open file " << base << ".events" << std::endl;
+        return false;
+    }
+    this->base = base;
+    buffer.reserve(BLOCK_EVENTS);
+    recorded = 0;
+    checkpoints = 0;
+    return true;
+}
+
+void EventLog::close() {
+    if (!events)
+        return;
+    flush();
+    std::fclose(events);
+    events = nullptr;
+}
+
+bool EventLog::isOpen() const {
+    return events != nullptr;
+}
+
+void EventLog::record(int time, LoggedEventType type, int a, int b, int value) {
+    if (!events)
+        return;
+    LoggedEvent event;
+    event.time = time;
+    event.type = static_cast<uint16_t>(type);
+    event.value = static_cast<uint16_t>(value);
+    event.a = a;
+    event.b = b;
+    buffer.push_back(event);
+    recorded++;
+    if (buffer.size() == BLOCK_EVENTS)
+        flush();
+}
+
+void EventLog::flush() {
+    if (!events || buffer.empty())
+        return;
+    if (std::fwrite(buffer.data(), sizeof(LoggedEvent), buffer.size(), events) != buffer.size())
+        std::cerr << "Error: Unable to write to " << base << ".events" << std::endl;
+    std::fflush(events);
+    buffer.clear();
+}
+
+bool EventLog::checkpoint(int time, Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                          CongestionMonitoring& ht, Accident_roads& accidentManager) {
+    if (!events)
+        return false;
+    flush();
+    if (!Checkpoint::save(checkpointName(base, checkpoints), cityGraph, vehicles, traffic, ht, accidentManager))
+        return false;
+
+    // the index entry is written last, so a replay never finds a checkpoint that is not complete
+    IndexEntry entry;
+    entry.time = time;
+    entry.events = recorded;
+    std::string indexName = base + ".index";
+    std::FILE* index = std::fopen(indexName.c_str(), "ab");
+    bool ok = index && std::fwrite(&entry, sizeof(entry), 1, index) == 1;
+    if (index)
+        ok = std::fclose(index) == 0 && ok;
+    if (!ok) {
+        std::cerr << "Error: Unable to write to " << indexName << std::endl;
+        return false;
+    }
+    checkpoints++;
+    return true;
+}
+
+long long EventLog::getRecordedEvents() const {
+    return recorded;
+}
+
+bool EventLog::replay(const std::string& base, int time, Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                      CongestionMonitoring& ht, Accident_roads& accidentManager, long long* applied) {
+    if (applied)
+        *applied = 0;
+
+    // latest checkpoint at or before the requested time
+    std::string indexName = base + ".index";
+    std::FILE* index = std::fopen(indexName.c_str(), "rb");
+    if (!index) {
+        std::cerr << "Error: Unable to open file " << indexName << std::endl;
+        return false;
+    }
+    IndexEntry entry;
+    IndexEntry start = IndexEntry();
+    int number = -1;
+    for (int i = 0; std::fread(&entry, sizeof(entry), 1, index) == 1; i++) {
+        if (entry.time > time)
+            break;
+        start = entry;
+        number = i;
+    }
+    std::fclose(index);
+    if (number == -1) {
+        std::cerr << "Error: " << base << " has no checkpoint at or before time " << time << std::endl;
+        return false;
+    }
+    if (!Checkpoint::restore(checkpointName(base, number), cityGraph, vehicles, traffic, ht, accidentManager))
+        return false;
+
+    // the log refers to vehicles, signals and intersections by their position in their lists
+    std::vector<Vehicle*> vehicleAt;
+    for (Vehicle* v = vehicles.getHead(); v; v = v->next)
+        vehicleAt.push_back(v);
+    std::vector<TrafficSignal*> signalAt;
+    for (TrafficSignal* s = traffic.getHeadSignal(); s; s = s->next)
+        signalAt.push_back(s);
+    std::vector<std::string> names;
+    for (VertexNode* v = cityGraph.headVertex; v; v = v->next)
+        names.push_back(v->vertex->name);
+    const int vehicleCount = static_cast<int>(vehicleAt.size());
+    const int signalCount = static_cast<int>(signalAt.size());
+    const int intersectionCount = static_cast<int>(names.size());
+    static const char* const STATES[3] = {"red", "yellow", "green"};
+    const std::size_t PREFETCH_DISTANCE = 16;
+
+    std::FILE* file = std::fopen((base + ".events").c_str(), "rb");
+    if (!file || std::fseek(file, static_cast<long>(start.events * sizeof(LoggedEvent)), SEEK_SET) != 0) {
+        std::cerr << "Error: Unable to read " << base << ".events" << std::endl;
+        if (file)
+            std::fclose(file);
+        return false;
+    }
+    std::vector<LoggedEvent> block(BLOCK_EVENTS);
+    long long count = 0;
+    bool done = false;
+    while (!done) {
+        std::size_t read = std::fread(block.data(), sizeof(LoggedEvent), block.size(), file);
+        if (read == 0)
+            break;
+        for (std::size_t i = 0; i < read; i++) {
+            // vehicles are scattered over the heap: fetch the vehicles of the coming moves, then their paths
+            if (i + PREFETCH_DISTANCE < read && block[i + PREFETCH_DISTANCE].type == LOG_VEHICLE_MOVE &&
+                static_cast<uint32_t>(block[i + PREFETCH_DISTANCE].a) < static_cast<uint32_t>(vehicleCount))
+                __builtin_prefetch(vehicleAt[block[i + PREFETCH_DISTANCE].a]);
+            if (i + PREFETCH_DISTANCE / 2 < read && block[i + PREFETCH_DISTANCE / 2].type == LOG_VEHICLE_MOVE &&
+                static_cast<uint32_t>(block[i + PREFETCH_DISTANCE / 2].a) < static_cast<uint32_t>(vehicleCount)) {
+                const Vehicle* ahead = vehicleAt[block[i + PREFETCH_DISTANCE / 2].a];
+                __builtin_prefetch(ahead->path.data() + ahead->currentIntersectionInPath);
+            }
+            const LoggedEvent& event = block[i];
+            if (event.time > time) {
+                done = true;
+                break;
+            }
+            switch (event.type) {
+                case LOG_VEHICLE_MOVE:
+                    if (event.a >= 0 && event.a < vehicleCount)
+                        vehicleAt[event.a]->moveForward();
+                    break;
+                case LOG_SIGNAL_STATE:
+                    if (event.a >= 0 && event.a < signalCount) {
+                        signalAt[event.a]->state = STATES[event.value < 3 ? event.value : 0];
+                        signalAt[event.a]->temp = event.b;
+                    }
+                    break;
+                case LOG_SIGNAL_TIMING:
+                    if (event.a >= 0 && event.a < signalCount) {
+                        signalAt[event.a]->duration = event.b;
+                        signalAt[event.a]->greenApproach = std::string(1, static_cast<char>(event.value));
+                    }
+                    break;
+                case LOG_SIGNAL_APPROACH:
+                    if (event.a >= 0 && event.a < signalCount && event.b < intersectionCount)
+                        signalAt[event.a]->greenApproach = event.b < 0 ? "-" : names[event.b];
+                    break;
+                default:
+                    // road events name two intersections
+                    if (event.a < 0 || event.a >= intersectionCount || event.b < 0 || event.b >= intersectionCount)
+                        break;
+                    if (event.type == LOG_ROAD_BLOCKED)
+                        accidentManager.blockRoad(names[event.a], names[event.b], cityGraph, false);
+                    else if (event.type == LOG_ROAD_CLEARED)
+                        accidentManager.clearRoad(names[event.a], names[event.b], cityGraph);
+            }
+            count++;
+        }
+    }
+    std::fclose(file);
+    if (applied)
+        *applied = count;
+    return true;
+}
@@ -0,0 +1,155 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "vehicles.h"
+#include "trafficLightManagement.h"
+#include "congestionMonitoring.h"
+#include "accidents.h"
+
+/**
+ * @enum LoggedEventType
+ * @brief The state changes recorded by an EventLog.
+ *
+ * Only changes made by the SimulationEngine are recorded. The values 6 and 7 are unused.
+ */
+enum LoggedEventType {
+    LOG_VEHICLE_MOVE = 1,    /**< Vehicle a moved to the next intersection of its path */
+    LOG_SIGNAL_STATE,        /**< Signal a changed to state `value` (0 red, 1 yellow, 2 green) at time b */
+    LOG_SIGNAL_TIMING,       /**< Signal a got green time b; `value` is the first character of the served approach */
+    LOG_ROAD_BLOCKED,        /**< The road from intersection a to b was blocked */
+    LOG_ROAD_CLEARED,        /**< The road from intersection a to b was reopened */
+    LOG_SIGNAL_APPROACH = 8  /**< Signal a serves the road from intersection b (-1 if none); follows its LOG_SIGNAL_TIMING */
+};
+
+/**
+ * @struct LoggedEvent
+ * @brief One 16-byte record of an event log.
+ *
+ * Vehicles, signals and intersections are identified by their position in the Vehicles list, the
+ * signal list and the graph's vertex list, i.e. by their index in a Checkpoint taken with the log.
+ */
+struct LoggedEvent {
+    int32_t time;    /**< Simulated time of the event in seconds */
+    uint16_t type;   /**< A LoggedEventType */
+    uint16_t value;  /**< Signal state or served approach, depending on the type */
+    int32_t a;       /**< Vehicle, signal or start intersection */
+    int32_t b;       /**< State start time, green time or end intersection */
+};
+
+/**
+ * @class EventLog
+ * @brief Append-only binary log of every state change of a simulation, with replay to any time.
+ *
+ * A log named base is made of three files: base.events holds the LoggedEvent records in time order,
+ * base.N.ckpt the N-th checkpoint taken with checkpoint(), and base.index one entry per checkpoint
+ * with its time and the number of events recorded before it. Replaying to a time restores the last
+ * checkpoint taken at or before it, seeks the events file straight to the records that follow the
+ * checkpoint and applies them in large blocks up to the requested time.
+ *
+ * Records are buffered and written a block at a time; the buffer is flushed by checkpoint(),
+ * flush() and close().
+ */
+class EventLog {
+public:
+    /**
+     * @brief Constructs a closed log.
+     */
+    EventLog();
+
+    /**
+     * @brief Closes the log.
+     */
+    ~EventLog();
+
+    /**
+     * @brief Starts a new log, replacing any log with the same name.
+     * @param base The name of the log; the files are base.events, base.index and base.N.ckpt.
+     * @return true on success, false if the files could not be created.
+     */
+    bool open(const std::string& base);
+
+    /**
+     * @brief Flushes and closes the log.
+     */
+    void close();
+
+    /**
+     * @brief Checks if the log is open for recording.
+     * @return bool
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Appends an event. Events must be recorded in non-decreasing time order.
+     * @param time The simulated time in seconds.
+     * @param type The kind of event.
+     * @param a See LoggedEventType.
+     * @param b See LoggedEventType.
+     * @param value See LoggedEventType.
+     */
+    void record(int time, LoggedEventType type, int a, int b = 0, int value = 0);
+
+    /**
+     * @brief Writes a checkpoint of the simulation state that replays can start from.
+     *
+     * Every event of the checkpoint's time must have been recorded already.
+     * @param time The simulated time of the state in seconds.
+     * @return true on success, false if the checkpoint or the index could not be written.
+     */
+    bool checkpoint(int time, Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                    CongestionMonitoring& ht, Accident_roads& accidentManager);
+
+    /**
+     * @brief Writes the buffered events to the events file.
+     */
+    void flush();
+
+    /**
+     * @brief Gets the number of events recorded since open().
+     * @return long long
+     */
+    long long getRecordedEvents() const;
+
+    /**
+     * @brief Rebuilds the simulation state at a given time from a log.
+     *
+     * The congestion counts are those of the checkpoint replay started from; they are derived from
+     * the vehicle positions and not logged.
+     * @param base The name of the log.
+     * @param time The simulated time to rebuild in seconds.
+     * @param applied Receives the number of events applied after the checkpoint (may be nullptr).
+     * @return true on success, false if the log has no checkpoint at or before time or cannot be read.
+     */
+    static bool replay(const std::string& base, int time, Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                       CongestionMonitoring& ht, Accident_roads& accidentManager, long long* applied = nullptr);
+
+private:
+    static const std::size_t BLOCK_EVENTS = 1 << 16;  /**< Events written or read at once */
+
+    /**
+     * @struct IndexEntry
+     * @brief Where the events following a checkpoint start.
+     */
+    struct IndexEntry {
+        int64_t time;    /**< Time of the checkpoint */
+        int64_t events;  /**< Number of events recorded before the checkpoint */
+    };
+
+    std::string base;                 /**< Name of the open log */
+    std::FILE* events;                /**< Events file (nullptr if closed) */
+    std::vector<LoggedEvent> buffer;  /**< Events not written yet */
+    long long recorded;               /**< Events recorded since open() */
+    int checkpoints;                  /**< Checkpoints taken since open() */
+
+    static std::string checkpointName(const std::string& base, int number);
+
+    EventLog(const EventLog&);
+    EventLog& operator=(const EventLog&);
+};
+
+#endif // EVENT_LOG_H
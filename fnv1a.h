@@ -0,0 +1,39 @@
+#ifndef FNV1A_H
+#define FNV1A_H
+
+#include <cstddef>
+#include <cstdint>
+
+/** Starting value of a 64-bit FNV-1a hash */
+const uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ULL;
+
+/**
+ * @brief Adds a run of bytes to a 64-bit FNV-1a hash.
+ *
+ * Hashing two runs one after the other gives the same value as hashing them as one run.
+ * @param hash The hash to update, starting at FNV1A_OFFSET_BASIS.
+ * @param data The bytes to add.
+ * @param length The number of bytes.
+ */
+inline void fnv1a(uint64_t& hash, const void* data, std::size_t length) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+/**
+ * @brief Returns the 64-bit FNV-1a hash of a run of bytes.
+ *
+ * @param data The bytes to hash.
+ * @param length The number of bytes.
+ * @return The hash.
+ */
+inline uint64_t fnv1a(const void* data, std::size_t length) {
+    uint64_t hash = FNV1A_OFFSET_BASIS;
+    fnv1a(hash, data, length);
+    return hash;
+}
+
+#endif // FNV1A_H
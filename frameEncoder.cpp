@@ -0,0 +1,130 @@
+#include "frameEncoder.h"
+#include "parallelFor.h"
+#include "tracer.h"
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <utility>
+#include <sys/stat.h>
+
+FrameEncoder::FrameEncoder()
+    : rawStream(false), stream(nullptr), submitted(0), nextToWrite(0), stopping(false), failed(false) {}
+
+FrameEncoder::~FrameEncoder() {
+    close();
+}
+
+bool FrameEncoder::open(const std::string& output, int threads) {
+    close();
+    this->output = output;
+    std::string::size_type dot = output.find_last_of("./");
+    std::string extension = dot != std::string::npos && output[dot] == '.' ? output.substr(dot) : "";
+    rawStream = extension == ".rgba" || extension == ".raw";
+    if (rawStream) {
+        stream = std::fopen(output.c_str(), "wb");
+        if (!stream) {
+            std::cerr << "Error: Unable to open file " << output << std::endl;
+            return false;
+        }
+    } else if (mkdir(output.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cerr << "Error: Unable to create directory " << output << std::endl;
+        return false;
+    }
+
+    submitted = 0;
+    nextToWrite = 0;
+    stopping = false;
+    failed = false;
+    if (threads < 1)
+        threads = defaultThreadCount();
+    for (int t = 0; t < threads; t++)
+        workers.push_back(std::thread(&FrameEncoder::work, this));
+    return true;
+}
+
+void FrameEncoder::submit(const sf::Image& image) {
+    Job job;
+    sf::Vector2u size = image.getSize();
+    job.width = size.x;
+    job.height = size.y;
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    if (pixels)
+        job.pixels.assign(pixels, pixels + static_cast<std::size_t>(size.x) * size.y * 4);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (workers.empty())
+        return;
+    while (jobs.size() >= QUEUED_PER_WORKER * workers.size())
+        space.wait(lock);
+    job.number = submitted++;
+    jobs.push_back(std::move(job));
+    queued.notify_one();
+}
+
+bool FrameEncoder::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queued.notify_all();
+    }
+    for (std::size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+    workers.clear();
+    if (stream && std::fclose(stream) != 0 && !failed) {
+        std::cerr << "Error: Unable to write file " << output << std::endl;
+        failed = true;
+    }
+    stream = nullptr;
+    return !failed;
+}
+
+long long FrameEncoder::getFrameCount() const {
+    return submitted;
+}
+
+void FrameEncoder::work() {
+    Tracer::setThreadName("encoder");
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (jobs.empty() && !stopping)
+                queued.wait(lock);
+            if (jobs.empty())
+                return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            space.notify_one();
+        }
+
+        TRACE_SCOPE("writeFrame", "export");
+        if (rawStream) {
+            // frames are appended in order: wait for the previous frame to be written
+            std::unique_lock<std::mutex> lock(mutex);
+            while (nextToWrite != job.number)
+                written.wait(lock);
+            lock.unlock();
+            std::size_t bytes = job.pixels.size();
+            bool ok = bytes == 0 || std::fwrite(job.pixels.data(), 1, bytes, stream) == bytes;
+            lock.lock();
+            if (!ok && !failed) {
+                std::cerr << "Error: Unable to write file " << output << std::endl;
+                failed = true;
+            }
+            nextToWrite++;
+            written.notify_all();
+        } else {
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame_%06lld.png", job.number);
+            sf::Image image;
+            if (!job.pixels.empty())
+                image.create(job.width, job.height, job.pixels.data());
+            if (job.pixels.empty() || !image.saveToFile(output + name)) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failed)
+                    std::cerr << "Error: Unable to write file " << output + name << std::endl;
+                failed = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef FRAME_ENCODER_H
+#define FRAME_ENCODER_H
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class FrameEncoder
+ * @brief Writes rendered frames to disk on a pool of background threads.
+ *
+ * Frames are either encoded as numbered PNG images (frame_000000.png, frame_000001.png, ...) in a
+ * directory, each worker encoding a different frame, or appended to a raw video stream: width x height
+ * RGBA pixels per frame, 8 bits per channel, no header, in submission order (e.g. for
+ * "ffmpeg -f rawvideo -pix_fmt rgba -s 800x800 -i frames.rgba out.mp4").
+ *
+ * submit() only queues the frame, so the caller goes on while the frames are written; it waits only
+ * when the queue already holds a few frames per worker, which bounds the memory held by frames that
+ * the disk cannot keep up with.
+ */
+class FrameEncoder {
+public:
+    /**
+     * @brief Constructs an encoder with no output open.
+     */
+    FrameEncoder();
+
+    /**
+     * @brief Writes the frames still queued and stops the workers.
+     */
+    ~FrameEncoder();
+
+    /**
+     * @brief Opens an output and starts the workers.
+     * @param output A file name ending in .rgba or .raw for a raw video stream (replaced if it exists),
+     * otherwise a directory for an image sequence (created if it does not exist).
+     * @param threads The number of worker threads (values below 1 use defaultThreadCount()).
+     * @return true on success, false if the output could not be created (an error is printed).
+     */
+    bool open(const std::string& output, int threads);
+
+    /**
+     * @brief Queues a frame to be written after the frames submitted before.
+     * @param image The frame; all frames of a raw stream must have the same size.
+     */
+    void submit(const sf::Image& image);
+
+    /**
+     * @brief Waits until every queued frame is written, then stops the workers and closes the output.
+     * @return true if every frame was written, false otherwise (an error is printed).
+     */
+    bool close();
+
+    /**
+     * @brief Gets the number of frames submitted since open().
+     * @return long long
+     */
+    long long getFrameCount() const;
+
+private:
+    /**
+     * @struct Job
+     * @brief A frame waiting for a worker.
+     */
+    struct Job {
+        long long number;                /**< Position of the frame in the output */
+        unsigned width, height;
+        std::vector<sf::Uint8> pixels;   /**< RGBA, row by row */
+    };
+
+    static const std::size_t QUEUED_PER_WORKER = 2;  /**< submit() waits while more frames than this per worker are queued */
+
+    std::string output;
+    bool rawStream;                      /**< Raw video stream rather than an image sequence */
+    std::FILE* stream;                   /**< The raw video stream */
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable queued;      /**< Signalled when a job is queued or the encoder stops */
+    std::condition_variable space;       /**< Signalled when a worker takes a job */
+    std::condition_variable written;     /**< Signalled when a frame of the raw stream is written */
+    std::deque<Job> jobs;
+    long long submitted;                 /**< Frames submitted so far */
+    long long nextToWrite;               /**< Next frame of the raw stream, which is written in order */
+    bool stopping;
+    bool failed;                         /**< A frame could not be written */
+
+    void work();
+
+    FrameEncoder(const FrameEncoder&);
+    FrameEncoder& operator=(const FrameEncoder&);
+};
+
+#endif // FRAME_ENCODER_H
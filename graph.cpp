@@ -1,8 +1,11 @@
 #include "graph.h"
-#include <fstream>
-#include<sstream>
+#include "csvReader.h"
+#include "parallelFor.h"
+#include "profiler.h"
 #include <iostream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 using namespace std;
 
 // Vertex class definition
@@ -35,10 +38,14 @@ EdgeNode::EdgeNode(Edge* edge) : edge(edge), next(nullptr) {}
 VertexNode::VertexNode(Vertex* vertex) : vertex(vertex), next(nullptr) {}
 
 // Graph constructor
-Graph::Graph() : headVertex(nullptr) {}
+Graph::Graph() : headVertex(nullptr), topologyVersion(0) {}
 
 // Graph destructor
 Graph::~Graph() {
+    clear();
+}
+
+void Graph::clear() {
     // Delete all vertices and edges from memory
     VertexNode* current = headVertex;
     while (current) {
@@ -56,6 +63,8 @@ Graph::~Graph() {
         delete temp->vertex;  // Delete the vertex itself
         delete temp;          // Delete the vertex node
     }
+    headVertex = nullptr;
+    topologyVersion++;
 }
 
 // Add a vertex to the graph
@@ -77,6 +86,7 @@ void Graph::addVertex(const std::string& name) {
         }
         current->next = newNode; // Add at the end
     }
+    topologyVersion++;
 }
 
 
@@ -114,6 +124,7 @@ void Graph::removeVertex(const string& name) {
             }
             delete current->vertex;
             delete current;
+            topologyVersion++;
             cout << "Intersection " << name << " removed successfully." << endl;
             return;
         }
@@ -146,8 +157,7 @@ void Graph::addEdge(const std::string& start, const std::string& end, int travel
         }
         current->next = newEdgeNode;
     }
-
-    
+    topologyVersion++;
 }
 void Graph::removeEdge(const string& start, const string& end) {
     Vertex* startVertex = findVertex(start);
@@ -168,6 +178,7 @@ void Graph::removeEdge(const string& start, const string& end) {
             }
             delete current->edge;
             delete current;
+            topologyVersion++;
             cout << "Road between " << start << " and " << end << " removed successfully." << endl;
             return;
         }
@@ -177,40 +188,67 @@ void Graph::removeEdge(const string& start, const string& end) {
     cout << "Road not found!" << endl;
 }
 void Graph::loadRoadData(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << std::endl;
+    PROFILE_SCOPE(PROFILE_LOADING);
+    CsvReader reader;
+    if (!reader.open(filename))
         return;
-    }
-
-    std::string line;
-    // Skip the header line
-    std::getline(file, line);
+    reader.skipRow(); // header
 
-    // Reading each subsequent line in the CSV file
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string start, end;
+    // parse the rows (in parallel for large files), then add them in file order
+    struct Road {
+        CsvField start, end;
         int travelTime;
-
-        // Extract the values (comma-separated)
-        std::getline(ss, start, ',');
-        std::getline(ss, end, ',');
-        ss >> travelTime;
-
-        // Add vertices if they don't exist
-        if (!findVertex(start)) {
-            addVertex(start);
-        }
-        if (!findVertex(end)) {
-            addVertex(end);
+    };
+    std::vector<CsvChunk> chunks = reader.split();
+    std::vector<std::vector<Road> > roads(chunks.size());
+    parallelFor(static_cast<int>(chunks.size()), static_cast<int>(chunks.size()), [&](int begin, int end) {
+        std::vector<CsvField> fields;
+        for (int c = begin; c < end; c++) {
+            while (chunks[c].nextRow(fields)) {
+                Road road;
+                if (fields.size() < 3 || !fields[2].toInt(road.travelTime))
+                    continue;
+                road.start = fields[0];
+                road.end = fields[1];
+                roads[c].push_back(road);
+            }
         }
-
-        // Add the edge between the two vertices
-        addEdge(start, end, travelTime);
+    });
+
+    // every vertex by name and the end of the vertex list, so each row costs constant time
+    std::unordered_map<std::string, Vertex*> vertices;
+    VertexNode* last = nullptr;
+    for (VertexNode* node = headVertex; node; node = node->next) {
+        vertices[node->vertex->name] = node->vertex;
+        last = node;
     }
+    std::string name;
+    for (size_t c = 0; c < roads.size(); c++) {
+        for (size_t r = 0; r < roads[c].size(); r++) {
+            Vertex* ends[2];
+            const CsvField* fields[2] = {&roads[c][r].start, &roads[c][r].end};
+            for (int i = 0; i < 2; i++) {
+                name.assign(fields[i]->data, fields[i]->size);
+                Vertex*& vertex = vertices[name];
+                if (!vertex) {
+                    vertex = new Vertex(name);
+                    VertexNode* node = new VertexNode(vertex);
+                    (last ? last->next : headVertex) = node;
+                    last = node;
+                    topologyVersion++;
+                }
+                ends[i] = vertex;
+            }
 
-    file.close();
+            // roads are added at the end of the start's list, as addEdge does
+            EdgeNode* edgeNode = new EdgeNode(new Edge(ends[1], roads[c][r].travelTime));
+            EdgeNode** link = &ends[0]->edges;
+            while (*link)
+                link = &(*link)->next;
+            *link = edgeNode;
+            topologyVersion++;
+        }
+    }
 }
 void Graph::displayRoadStatuses() {
     VertexNode* currentVertexNode = headVertex;
@@ -250,6 +288,7 @@ void Graph::addEdgeToVertex(Vertex* vertex, Edge* edge) {
     EdgeNode* newEdgeNode = new EdgeNode(edge);
     newEdgeNode->next = vertex->edges;
     vertex->edges = newEdgeNode;
+    topologyVersion++;
 }
 void Graph::markEdgesAsUnderRepaired(const std::string& intersection1, const std::string& intersection2, bool isUnderRepaired) {
     Vertex* v1 = findVertex(intersection1);
@@ -444,3 +483,7 @@ void Graph::getAllEdges(std::string edges[][3], int& count) {
         currentVertexNode = currentVertexNode->next; // Move to the next vertex
     }
 }
+
+int Graph::getTopologyVersion() const {
+    return topologyVersion;
+}
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <iostream>
+#include "memoryAccounting.h"
 using namespace std;
 
 // Forward declaration of the Accident_roads class
@@ -15,7 +16,7 @@ class Accident_roads;
  * The Vertex class stores the details of an intersection (such as its name and blockage status)
  * and maintains a list of outgoing edges representing the roads connecting the intersection to others.
  */
-class Vertex {
+class Vertex : public MemoryTracked<MEMORY_GRAPH> {
 public:
     std::string name;         /**< Intersection name */
     
@@ -36,7 +37,7 @@ public:
  * An Edge object stores information about a road between two intersections, including the 
  * destination intersection and the travel time between them.
  */
-class Edge {
+class Edge : public MemoryTracked<MEMORY_GRAPH> {
 public:
     Vertex* destination;      /**< Destination vertex (intersection) */
     int travelTime;           /**< Travel time to the destination */
@@ -82,7 +83,7 @@ public:
  * An EdgeNode is used to store an Edge in the adjacency list of a vertex. It also maintains 
  * a pointer to the next EdgeNode in the list, allowing multiple edges to be linked together.
  */
-class EdgeNode {
+class EdgeNode : public MemoryTracked<MEMORY_GRAPH> {
 public:
     Edge* edge;              /**< The edge */
     EdgeNode* next;          /**< Pointer to the next edge */
@@ -101,7 +102,7 @@ public:
  * A VertexNode is used to store a Vertex in the adjacency list of the graph. It also maintains 
  * a pointer to the next VertexNode, allowing multiple vertices to be linked together in the graph.
  */
-class VertexNode {
+class VertexNode : public MemoryTracked<MEMORY_GRAPH> {
 public:
     Vertex* vertex;          /**< The vertex */
     VertexNode* next;        /**< Pointer to the next vertex */
@@ -124,6 +125,7 @@ public:
 class Graph {
 public:
     VertexNode* headVertex;  /**< Head of the linked list for vertices */
+    int topologyVersion;     /**< Incremented whenever an intersection or road is added or removed */
 
     /**
      * @brief Constructs an empty Graph object.
@@ -135,6 +137,11 @@ public:
      */
     ~Graph();
 
+    /**
+     * @brief Removes every vertex and edge from the graph.
+     */
+    void clear();
+
     /**
      * @brief Adds a vertex (intersection) to the graph.
      * @param name The name of the new intersection.
@@ -255,6 +262,15 @@ public:
      * @param count The number of edges found.
      */
     void getAllEdges(std::string edges[][3], int& count);
+
+    /**
+     * @brief Gets the current topology version of the graph.
+     *
+     * Structures derived from the road network (controllers, layouts, ...) compare this value
+     * against the version they were built from to know when they have to be rebuilt.
+     * @return The number of structural changes made to the graph so far.
+     */
+    int getTopologyVersion() const;
 };
 
 #endif // GRAPH_H
@@ -0,0 +1,66 @@
+#include "graphCoarsening.h"
+
+void coarsen(CoarseningLevel& fine, CoarseningLevel& coarse, const std::vector<int>& order) {
+    int n = fine.size();
+    bool weighted = !fine.weight.empty();
+
+    // heavy-edge matching: each vertex is merged with its unmatched neighbour sharing the heaviest edge
+    std::vector<int> match(n, -1);
+    fine.coarseOf.assign(n, -1);
+    int coarseCount = 0;
+    for (int i = 0; i < n; i++) {
+        int u = order[i];
+        if (match[u] != -1)
+            continue;
+        int best = u, bestWeight = 0;
+        for (int k = fine.offset[u]; k < fine.offset[u + 1]; k++) {
+            int v = fine.neighbour[k];
+            int w = weighted ? fine.weight[k] : 1;
+            if (match[v] == -1 && v != u && w > bestWeight) {
+                best = v;
+                bestWeight = w;
+            }
+        }
+        match[u] = best;
+        match[best] = u;
+        fine.coarseOf[u] = coarseCount;
+        fine.coarseOf[best] = coarseCount;
+        coarseCount++;
+    }
+
+    // build the coarse graph, merging the edges of matched pairs
+    coarse.offset.assign(1, 0);
+    coarse.neighbour.clear();
+    coarse.weight.clear();
+    coarse.vertexWeight.assign(fine.vertexWeight.empty() ? 0 : coarseCount, 0);
+    std::vector<int> members(coarseCount * 2, -1);
+    for (int v = 0; v < n; v++) {
+        int c = fine.coarseOf[v];
+        if (!fine.vertexWeight.empty())
+            coarse.vertexWeight[c] += fine.vertexWeight[v];
+        members[c * 2 + (members[c * 2] == -1 ? 0 : 1)] = v;
+    }
+    std::vector<int> slot(coarseCount, -1);  // position of each neighbour in the current vertex's list
+    for (int c = 0; c < coarseCount; c++) {
+        int start = static_cast<int>(coarse.neighbour.size());
+        for (int m = 0; m < 2; m++) {
+            int v = members[c * 2 + m];
+            if (v == -1)
+                continue;
+            for (int k = fine.offset[v]; k < fine.offset[v + 1]; k++) {
+                int d = fine.coarseOf[fine.neighbour[k]];
+                if (d == c)
+                    continue;
+                if (slot[d] < start) {
+                    slot[d] = static_cast<int>(coarse.neighbour.size());
+                    coarse.neighbour.push_back(d);
+                    if (weighted)
+                        coarse.weight.push_back(fine.weight[k]);
+                } else if (weighted) {
+                    coarse.weight[slot[d]] += fine.weight[k];
+                }
+            }
+        }
+        coarse.offset.push_back(static_cast<int>(coarse.neighbour.size()));
+    }
+}
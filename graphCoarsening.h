@@ -0,0 +1,35 @@
+#ifndef GRAPH_COARSENING_H
+#define GRAPH_COARSENING_H
+
+#include <vector>
+
+/**
+ * @struct CoarseningLevel
+ * @brief An undirected graph in CSR form, one per level of a multilevel algorithm.
+ *
+ * The weights are optional: without edge weights every edge weighs 1, and the coarser levels of a
+ * graph without weights have none either.
+ */
+struct CoarseningLevel {
+    std::vector<int> offset;        /**< First neighbour of each vertex (size n + 1) */
+    std::vector<int> neighbour;     /**< Neighbours of every vertex */
+    std::vector<int> weight;        /**< Weight of the edge to each neighbour (empty if unweighted) */
+    std::vector<int> vertexWeight;  /**< Number of original vertices merged into each vertex (empty if not counted) */
+    std::vector<int> coarseOf;      /**< Vertex of the next coarser level each vertex is merged into */
+
+    int size() const { return static_cast<int>(offset.size()) - 1; }
+};
+
+/**
+ * @brief Builds the next coarser level of a graph by heavy-edge matching.
+ *
+ * The vertices are visited in the given order, and each unmatched one is merged with its unmatched
+ * neighbour sharing the heaviest edge (the first one on ties), or kept alone if it has none. The
+ * edges of a merged pair are combined and their weights added.
+ * @param fine The level to coarsen; receives coarseOf.
+ * @param coarse Receives the coarser level.
+ * @param order The order to visit the vertices in (a permutation of 0 .. fine.size() - 1).
+ */
+void coarsen(CoarseningLevel& fine, CoarseningLevel& coarse, const std::vector<int>& order);
+
+#endif // GRAPH_COARSENING_H
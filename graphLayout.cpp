@@ -0,0 +1,435 @@
+#include "graphLayout.h"
+#include "csvReader.h"
+#include "fnv1a.h"
+#include "graphCoarsening.h"
+#include "parallelFor.h"
+#include "threadTeam.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <sys/stat.h>
+
+namespace {
+const char MAGIC[8] = {'S', 'T', 'M', 'S', 'L', 'A', 'Y', 'T'};
+const float THETA = 0.8f;         // a cell this small for its distance acts as one body
+const float GRAVITY = 0.02f;      // pull towards the centre, so disconnected parts stay in view
+const float MIN_CELL = 1e-4f;     // intersections closer than this share a cell
+const int COARSEST = 50;          // coarsening stops below this many intersections
+const int MIN_REFINEMENTS = 30;   // iterations at each finer level, at least (or iterations/4 if more)
+const float REFINE_TEMPERATURE = 2.0f;  // the largest move at each finer level, in road lengths
+
+/**
+ * Barnes-Hut quadtree: each cell holds the number of intersections in it and their centre of mass.
+ */
+class QuadTree {
+public:
+    struct Cell {
+        float left, top, size;  // the square covered
+        float massX, massY;     // sum of the positions, then centre of mass
+        int mass;               // number of intersections
+        int child;              // first of the 4 children, -1 for a leaf
+        int body;               // the intersection of a leaf, -1 if empty
+    };
+
+    void build(const std::vector<float>& x, const std::vector<float>& y) {
+        std::size_t n = x.size();
+        float minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+        for (std::size_t i = 1; i < n; i++) {
+            minX = std::min(minX, x[i]);
+            maxX = std::max(maxX, x[i]);
+            minY = std::min(minY, y[i]);
+            maxY = std::max(maxY, y[i]);
+        }
+        cells.clear();
+        cells.reserve(2 * n + 1);
+        cells.push_back(makeCell(minX, minY, std::max(maxX - minX, maxY - minY) + MIN_CELL));
+        for (std::size_t i = 0; i < n; i++)
+            insert(static_cast<int>(i), x[i], y[i], x, y);
+        for (std::size_t c = 0; c < cells.size(); c++) {
+            if (cells[c].mass > 0) {
+                cells[c].massX /= cells[c].mass;
+                cells[c].massY /= cells[c].mass;
+            }
+        }
+    }
+
+    // repulsion k^2 / d from every other intersection, distant groups taken as one body
+    void repulsion(int body, float px, float py, float k2, float& fx, float& fy, std::vector<int>& stack) const {
+        stack.clear();
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Cell& cell = cells[stack.back()];
+            stack.pop_back();
+            if (cell.mass == 0 || (cell.child < 0 && cell.body == body && cell.mass == 1))
+                continue;
+            float dx = px - cell.massX;
+            float dy = py - cell.massY;
+            float d2 = dx * dx + dy * dy;
+            if (cell.child >= 0 && cell.size * cell.size >= THETA * THETA * d2) {
+                for (int q = 0; q < 4; q++)
+                    stack.push_back(cell.child + q);
+                continue;
+            }
+            if (d2 < 1e-8f) {
+                // same place (e.g. coincident intersections): push apart in a direction set by the index
+                dx = std::cos(static_cast<float>(body));
+                dy = std::sin(static_cast<float>(body));
+                d2 = 1;
+            }
+            float force = cell.mass * k2 / d2;
+            fx += dx * force;
+            fy += dy * force;
+        }
+    }
+
+private:
+    std::vector<Cell> cells;
+
+    static Cell makeCell(float left, float top, float size) {
+        Cell cell = {left, top, size, 0, 0, 0, -1, -1};
+        return cell;
+    }
+
+    int quadrant(const Cell& cell, float px, float py) const {
+        float half = cell.size / 2;
+        return (px >= cell.left + half ? 1 : 0) + (py >= cell.top + half ? 2 : 0);
+    }
+
+    void insert(int body, float px, float py, const std::vector<float>& x, const std::vector<float>& y) {
+        int c = 0;
+        for (;;) {
+            cells[c].mass++;
+            cells[c].massX += px;
+            cells[c].massY += py;
+            if (cells[c].child >= 0) {
+                c = cells[c].child + quadrant(cells[c], px, py);
+                continue;
+            }
+            if (cells[c].body == -1) {
+                cells[c].body = body;
+                return;
+            }
+            if (cells[c].size < MIN_CELL)
+                return; // counted in the mass of the leaf
+
+            // split the leaf and move its intersection down
+            int old = cells[c].body;
+            float half = cells[c].size / 2;
+            int first = static_cast<int>(cells.size());
+            for (int q = 0; q < 4; q++)
+                cells.push_back(makeCell(cells[c].left + (q & 1 ? half : 0), cells[c].top + (q & 2 ? half : 0), half));
+            cells[c].child = first;
+            cells[c].body = -1;
+            Cell& moved = cells[first + quadrant(cells[c], x[old], y[old])];
+            moved.mass = 1;
+            moved.massX = x[old];
+            moved.massY = y[old];
+            moved.body = old;
+            c = first + quadrant(cells[c], px, py);
+        }
+    }
+};
+
+// one unweighted level per coarsening step of the force-directed layout
+typedef CoarseningLevel Level;
+
+// Fruchterman-Reingold iterations with ideal road length 1: roads pull their ends together,
+// all intersections push each other apart, and the moves are capped by a cooling temperature
+void relax(const Level& level, std::vector<float>& x, std::vector<float>& y, int iterations, float startTemperature,
+           ThreadTeam* team, std::vector<std::vector<int> >& stacks) {
+    int n = level.size();
+    int memberCount = team ? static_cast<int>(stacks.size()) : 1;
+    std::vector<float> nextX(n), nextY(n);
+    QuadTree tree;
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        float temperature = startTemperature * (1 - static_cast<float>(iteration) / iterations) + 0.01f;
+        float centreX = 0, centreY = 0;
+        for (int i = 0; i < n; i++) {
+            centreX += x[i];
+            centreY += y[i];
+        }
+        centreX /= n;
+        centreY /= n;
+        tree.build(x, y);
+
+        std::function<void(int)> move = [&](int member) {
+            int chunk = (n + memberCount - 1) / memberCount;
+            int begin = member * chunk;
+            int end = begin + chunk < n ? begin + chunk : n;
+            for (int i = begin; i < end; i++) {
+                float fx = 0, fy = 0;
+                tree.repulsion(i, x[i], y[i], 1, fx, fy, stacks[member]);
+                for (int j = level.offset[i]; j < level.offset[i + 1]; j++) {
+                    // attraction d^2 along the road
+                    float dx = x[level.neighbour[j]] - x[i];
+                    float dy = y[level.neighbour[j]] - y[i];
+                    float d = std::sqrt(dx * dx + dy * dy);
+                    fx += dx * d;
+                    fy += dy * d;
+                }
+                fx -= GRAVITY * (x[i] - centreX);
+                fy -= GRAVITY * (y[i] - centreY);
+
+                float length = std::sqrt(fx * fx + fy * fy);
+                float step = length > temperature ? temperature / length : 1;
+                nextX[i] = x[i] + fx * step;
+                nextY[i] = y[i] + fy * step;
+            }
+        };
+        if (team)
+            team->run(move);
+        else
+            move(0);
+        x.swap(nextX);
+        y.swap(nextY);
+    }
+}
+
+}
+
+GraphLayout::GraphLayout() : threads(1), iterations(300) {}
+
+void GraphLayout::setThreadCount(int threads) {
+    this->threads = threads < 1 ? defaultThreadCount() : threads;
+}
+
+void GraphLayout::setIterations(int iterations) {
+    this->iterations = iterations < 0 ? 0 : iterations;
+}
+
+void GraphLayout::setCacheDirectory(const std::string& directory) {
+    cacheDirectory = directory;
+}
+
+uint64_t GraphLayout::hashGraph(const CompactGraph& graph) {
+    uint64_t hash = FNV1A_OFFSET_BASIS;
+    for (std::size_t i = 0; i < graph.names.size(); i++) {
+        uint64_t length = graph.names[i].size();
+        fnv1a(hash, &length, sizeof(length));
+        fnv1a(hash, graph.names[i].data(), graph.names[i].size());
+    }
+    if (!graph.edgeOffset.empty())
+        fnv1a(hash, graph.edgeOffset.data(), graph.edgeOffset.size() * sizeof(int));
+    if (!graph.edgeTarget.empty())
+        fnv1a(hash, graph.edgeTarget.data(), graph.edgeTarget.size() * sizeof(int));
+    return hash;
+}
+
+GraphLayout::Method GraphLayout::compute(const CompactGraph& graph, const std::string& coordinatesFile) {
+    struct stat status;
+    if (!coordinatesFile.empty() && stat(coordinatesFile.c_str(), &status) == 0 && loadCoordinates(graph, coordinatesFile))
+        return GEOGRAPHIC;
+
+    uint64_t hash = hashGraph(graph);
+    std::string filename = cacheFile(hash);
+    if (!filename.empty() && loadCache(filename, hash, graph.names.size()))
+        return CACHED;
+    forceDirected(graph);
+    if (!filename.empty())
+        saveCache(filename, hash);
+    return FORCE_DIRECTED;
+}
+
+bool GraphLayout::loadCoordinates(const CompactGraph& graph, const std::string& filename) {
+    CsvReader reader;
+    if (!reader.open(filename))
+        return false;
+    std::size_t n = graph.names.size();
+    std::vector<float> px(n), py(n);
+    std::vector<char> found(n, 0);
+    std::size_t foundCount = 0;
+
+    std::unordered_map<std::string, int> indexOf;
+    indexOf.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+        indexOf[graph.names[i]] = static_cast<int>(i);
+
+    std::vector<CsvField> fields;
+    reader.skipRow();
+    while (reader.nextRow(fields)) {
+        double fieldX, fieldY;
+        if (fields.size() < 3 || !fields[1].toDouble(fieldX) || !fields[2].toDouble(fieldY))
+            continue;
+        std::unordered_map<std::string, int>::const_iterator at = indexOf.find(fields[0].str());
+        if (at == indexOf.end() || found[at->second])
+            continue;
+        int i = at->second;
+        found[i] = 1;
+        foundCount++;
+        px[i] = static_cast<float>(fieldX);
+        py[i] = static_cast<float>(-fieldY); // north up
+    }
+    if (foundCount != n || n == 0)
+        return false;
+    x.swap(px);
+    y.swap(py);
+    return true;
+}
+
+void GraphLayout::forceDirected(const CompactGraph& graph) {
+    int n = graph.getIntersectionCount();
+    x.assign(n, 0);
+    y.assign(n, 0);
+    if (n < 2)
+        return;
+
+    // Neighbours in both directions, so one-way roads pull both of their ends
+    std::vector<Level> hierarchy(1);
+    Level& finest = hierarchy[0];
+    finest.offset.assign(n + 1, 0);
+    finest.neighbour.resize(2 * graph.edgeTarget.size());
+    for (int i = 0; i < n; i++) {
+        for (int e = graph.edgeOffset[i]; e < graph.edgeOffset[i + 1]; e++) {
+            finest.offset[i + 1]++;
+            finest.offset[graph.edgeTarget[e] + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++)
+        finest.offset[i + 1] += finest.offset[i];
+    std::vector<int> fill(finest.offset.begin(), finest.offset.end() - 1);
+    for (int i = 0; i < n; i++) {
+        for (int e = graph.edgeOffset[i]; e < graph.edgeOffset[i + 1]; e++) {
+            finest.neighbour[fill[i]++] = graph.edgeTarget[e];
+            finest.neighbour[fill[graph.edgeTarget[e]]++] = i;
+        }
+    }
+
+    // coarsen until the graph is small or stops shrinking
+    // in index order, so the result is deterministic
+    while (hierarchy.back().size() > COARSEST) {
+        Level coarse;
+        std::vector<int> order(hierarchy.back().size());
+        for (int i = 0; i < hierarchy.back().size(); i++)
+            order[i] = i;
+        coarsen(hierarchy.back(), coarse, order);
+        if (coarse.size() > hierarchy.back().size() * 9 / 10)
+            break;
+        hierarchy.push_back(coarse);
+    }
+
+    int memberCount = threads < n ? threads : 1;
+    std::unique_ptr<ThreadTeam> team(memberCount > 1 ? new ThreadTeam(memberCount) : nullptr);
+    std::vector<std::vector<int> > stacks(memberCount);
+
+    // Lay out the coarsest level from a sunflower spiral (ideal road length k = 1), the same for every run
+    const Level& coarsest = hierarchy.back();
+    int count = coarsest.size();
+    std::vector<float> px(count), py(count);
+    const float goldenAngle = 2.39996323f;
+    for (int i = 0; i < count; i++) {
+        float radius = std::sqrt(static_cast<float>(i) + 0.5f);
+        px[i] = radius * std::cos(i * goldenAngle);
+        py[i] = radius * std::sin(i * goldenAngle);
+    }
+    relax(coarsest, px, py, iterations, std::sqrt(static_cast<float>(count)) / 10, team.get(), stacks);
+
+    // then place each level's intersections where their merged intersection was, spread to the level's
+    // size, and only refine locally
+    int refinements = std::max(iterations / 4, std::min(iterations, MIN_REFINEMENTS));
+    for (int level = static_cast<int>(hierarchy.size()) - 2; level >= 0; level--) {
+        const Level& fine = hierarchy[level];
+        int fineCount = fine.size();
+        float spread = std::sqrt(static_cast<float>(fineCount) / count);
+        std::vector<float> fx(fineCount), fy(fineCount);
+        for (int i = 0; i < fineCount; i++) {
+            int parent = fine.coarseOf[i];
+            // the two merged intersections start a little apart, in a direction set by the index
+            fx[i] = px[parent] * spread + 0.1f * std::cos(static_cast<float>(i));
+            fy[i] = py[parent] * spread + 0.1f * std::sin(static_cast<float>(i));
+        }
+        px.swap(fx);
+        py.swap(fy);
+        count = fineCount;
+        relax(fine, px, py, refinements, REFINE_TEMPERATURE, team.get(), stacks);
+    }
+    x.swap(px);
+    y.swap(py);
+}
+
+void GraphLayout::fit(float left, float top, float width, float height) {
+    if (x.empty())
+        return;
+    float minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+    for (std::size_t i = 1; i < x.size(); i++) {
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+    }
+    float spanX = maxX - minX, spanY = maxY - minY;
+    float scale = 1;
+    if (spanX > 0 || spanY > 0)
+        scale = std::min(spanX > 0 ? width / spanX : height / spanY, spanY > 0 ? height / spanY : width / spanX);
+    // centred in the rectangle
+    float offsetX = left + (width - spanX * scale) / 2;
+    float offsetY = top + (height - spanY * scale) / 2;
+    for (std::size_t i = 0; i < x.size(); i++) {
+        x[i] = offsetX + (x[i] - minX) * scale;
+        y[i] = offsetY + (y[i] - minY) * scale;
+    }
+}
+
+std::string GraphLayout::cacheFile(uint64_t hash) const {
+    if (cacheDirectory.empty())
+        return "";
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx.bin", static_cast<unsigned long long>(hash));
+    return cacheDirectory + name;
+}
+
+bool GraphLayout::loadCache(const std::string& filename, uint64_t hash, std::size_t count) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file)
+        return false;
+    CacheHeader header;
+    std::vector<float> px(count), py(count);
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 && std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+              header.version == VERSION && header.iterations == static_cast<uint32_t>(iterations) &&
+              header.hash == hash && header.count == count &&
+              (count == 0 || (std::fread(px.data(), sizeof(float), count, file) == count &&
+                              std::fread(py.data(), sizeof(float), count, file) == count));
+    std::fclose(file);
+    if (!ok)
+        return false;
+    x.swap(px);
+    y.swap(py);
+    return true;
+}
+
+bool GraphLayout::saveCache(const std::string& filename, uint64_t hash) const {
+    if (mkdir(cacheDirectory.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cerr << "Error: Unable to create directory " << cacheDirectory << std::endl;
+        return false;
+    }
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.iterations = iterations;
+    header.hash = hash;
+    header.count = x.size();
+
+    // written next to the target and renamed, so a failed write never leaves half a layout
+    std::string temporary = filename + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Unable to open file " << temporary << std::endl;
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (x.empty() || (std::fwrite(x.data(), sizeof(float), x.size(), file) == x.size() &&
+                             std::fwrite(y.data(), sizeof(float), y.size(), file) == y.size()));
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::cerr << "Error: Unable to write file " << filename << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,122 @@
+#ifndef GRAPH_LAYOUT_H
+#define GRAPH_LAYOUT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "compactGraph.h"
+
+/**
+ * @class GraphLayout
+ * @brief Places the intersections of a road network in the plane for drawing.
+ *
+ * compute() uses the intersections' coordinates when a file gives them for every intersection
+ * (the intersections.csv written by CityGenerator: Intersection,X,Y), and otherwise a force-directed
+ * layout: roads pull their ends together and all intersections push each other apart, the repulsion
+ * being approximated with a Barnes-Hut quadtree (O(n log n) per iteration instead of O(n^2)) and
+ * computed on several threads. The layout is multilevel: the network is coarsened by merging matched
+ * neighbours, the coarsest one laid out in full, and each finer level started from the coarser one
+ * and only refined, which untangles large networks in few iterations. The force-directed result is
+ * deterministic and is cached in a file named after a hash of the network, so a large network is
+ * laid out once; the cache is ignored if the network or the iteration count differ.
+ */
+class GraphLayout {
+public:
+    /**
+     * @brief How the positions were obtained by compute().
+     */
+    enum Method {
+        GEOGRAPHIC,      /**< Read from the coordinates file */
+        CACHED,          /**< Read from the cache */
+        FORCE_DIRECTED   /**< Computed (and cached) */
+    };
+
+    std::vector<float> x;  /**< Horizontal position of each intersection */
+    std::vector<float> y;  /**< Vertical position of each intersection, growing downwards as on screen */
+
+    /**
+     * @brief Constructs a layout with 1 thread, 300 iterations and no cache.
+     */
+    GraphLayout();
+
+    /**
+     * @brief Sets the number of threads computing the forces (values below 1 use defaultThreadCount()).
+     * @param threads The number of threads.
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * @brief Sets the number of iterations of the force-directed layout.
+     * @param iterations The number of iterations.
+     */
+    void setIterations(int iterations);
+
+    /**
+     * @brief Sets the directory of the layout cache, created when needed.
+     * @param directory The directory, or "" to disable the cache.
+     */
+    void setCacheDirectory(const std::string& directory);
+
+    /**
+     * @brief Lays out a road network: geographic if possible, else from the cache, else force-directed.
+     * @param graph The road network.
+     * @param coordinatesFile CSV file of intersection coordinates; "" or a missing file skips it.
+     * @return The method that gave the positions.
+     */
+    Method compute(const CompactGraph& graph, const std::string& coordinatesFile);
+
+    /**
+     * @brief Reads the positions from a coordinates file.
+     * @param graph The road network.
+     * @param filename CSV file with a header row and rows of name,X,Y (Y growing upwards).
+     * @return true if every intersection has coordinates, false otherwise (the positions are then unchanged).
+     */
+    bool loadCoordinates(const CompactGraph& graph, const std::string& filename);
+
+    /**
+     * @brief Computes a force-directed layout, ignoring the cache.
+     * @param graph The road network.
+     */
+    void forceDirected(const CompactGraph& graph);
+
+    /**
+     * @brief Scales and moves the positions to fit a rectangle, keeping their proportions.
+     * @param left The left side of the rectangle.
+     * @param top The top side of the rectangle.
+     * @param width The width of the rectangle.
+     * @param height The height of the rectangle.
+     */
+    void fit(float left, float top, float width, float height);
+
+    /**
+     * @brief Hashes the intersection names and the roads of a network.
+     * @param graph The road network.
+     * @return The hash, equal for equal networks.
+     */
+    static uint64_t hashGraph(const CompactGraph& graph);
+
+private:
+    static const uint32_t VERSION = 1;  /**< Format and algorithm version of the cache files */
+
+    /**
+     * @struct CacheHeader
+     * @brief The start of a cache file, followed by x and y of every intersection.
+     */
+    struct CacheHeader {
+        char magic[8];        /**< "STMSLAYT" */
+        uint32_t version;     /**< VERSION */
+        uint32_t iterations;  /**< Iterations the layout was computed with */
+        uint64_t hash;        /**< hashGraph() of the network */
+        uint64_t count;       /**< Number of intersections */
+    };
+
+    int threads;
+    int iterations;
+    std::string cacheDirectory;
+
+    std::string cacheFile(uint64_t hash) const;
+    bool loadCache(const std::string& filename, uint64_t hash, std::size_t count);
+    bool saveCache(const std::string& filename, uint64_t hash) const;
+};
+
+#endif // GRAPH_LAYOUT_H
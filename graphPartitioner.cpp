@@ -0,0 +1,207 @@
+#include "graphPartitioner.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <random>
+
+GraphPartitioner::GraphPartitioner(double imbalance, int refinementPasses, unsigned int seed)
+    : imbalance(imbalance < 1.0 ? 1.0 : imbalance), refinementPasses(refinementPasses), seed(seed),
+      edgeCut(0), achievedImbalance(1.0), levels(0) {}
+
+std::vector<int> GraphPartitioner::partition(const CompactGraph& graph, int regions) {
+    int n = graph.getIntersectionCount();
+    edgeCut = 0;
+    achievedImbalance = 1.0;
+    levels = 0;
+    if (regions <= 1 || n <= regions) {
+        std::vector<int> regionOf(n, 0);
+        for (int v = 0; v < n && regions > 1; v++)
+            regionOf[v] = v;
+        return regionOf;
+    }
+
+    // finest level: the network without directions or self loops, parallel roads merged
+    std::vector<Level> hierarchy(1);
+    Level& finest = hierarchy[0];
+    {
+        std::vector<std::vector<std::pair<int, int> > > adjacency(n);
+        for (int e = 0; e < graph.getEdgeCount(); e++) {
+            int u = graph.edgeSource[e], v = graph.edgeTarget[e];
+            if (u == v || v < 0)
+                continue;
+            adjacency[u].push_back(std::make_pair(v, 1));
+            adjacency[v].push_back(std::make_pair(u, 1));
+        }
+        finest.offset.push_back(0);
+        for (int u = 0; u < n; u++) {
+            std::sort(adjacency[u].begin(), adjacency[u].end());
+            for (size_t i = 0; i < adjacency[u].size(); i++) {
+                if (!finest.neighbour.empty() && finest.offset.back() < static_cast<int>(finest.neighbour.size()) &&
+                    finest.neighbour.back() == adjacency[u][i].first) {
+                    finest.weight.back() += adjacency[u][i].second;
+                } else {
+                    finest.neighbour.push_back(adjacency[u][i].first);
+                    finest.weight.push_back(adjacency[u][i].second);
+                }
+            }
+            finest.offset.push_back(static_cast<int>(finest.neighbour.size()));
+        }
+        finest.vertexWeight.assign(n, 1);
+    }
+
+    // coarsen until the graph is small or stops shrinking
+    int target = std::max(regions * 15, 64);
+    while (hierarchy.back().size() > target) {
+        Level coarse;
+        coarsen(hierarchy.back(), coarse);
+        if (coarse.size() > hierarchy.back().size() * 9 / 10)
+            break;
+        hierarchy.push_back(coarse);
+    }
+    levels = static_cast<int>(hierarchy.size());
+
+    // split the coarsest level, then project and refine back to the finest one
+    std::vector<int> regionOf;
+    initialPartition(hierarchy.back(), regions, regionOf);
+    refine(hierarchy.back(), regions, regionOf);
+    for (int level = levels - 2; level >= 0; level--) {
+        const Level& fine = hierarchy[level];
+        std::vector<int> projected(fine.size());
+        for (int v = 0; v < fine.size(); v++)
+            projected[v] = regionOf[fine.coarseOf[v]];
+        regionOf.swap(projected);
+        refine(fine, regions, regionOf);
+    }
+
+    // statistics on the road network itself
+    std::vector<int> regionSize(regions, 0);
+    for (int v = 0; v < n; v++)
+        regionSize[regionOf[v]]++;
+    for (int e = 0; e < graph.getEdgeCount(); e++) {
+        if (graph.edgeTarget[e] >= 0 && regionOf[graph.edgeSource[e]] != regionOf[graph.edgeTarget[e]])
+            edgeCut++;
+    }
+    achievedImbalance = *std::max_element(regionSize.begin(), regionSize.end()) / (static_cast<double>(n) / regions);
+    return regionOf;
+}
+
+void GraphPartitioner::coarsen(Level& fine, Level& coarse) {
+    int n = fine.size();
+    std::vector<int> order(n);
+    for (int v = 0; v < n; v++)
+        order[v] = v;
+    std::mt19937 rng(seed + static_cast<unsigned int>(n));
+    std::shuffle(order.begin(), order.end(), rng);
+
+    ::coarsen(fine, coarse, order);
+}
+
+void GraphPartitioner::initialPartition(const Level& level, int regions, std::vector<int>& regionOf) {
+    int n = level.size();
+    int total = 0;
+    for (int v = 0; v < n; v++)
+        total += level.vertexWeight[v];
+
+    // grow each region breadth-first from the lowest unassigned vertex until it has its share
+    regionOf.assign(n, -1);
+    int assignedWeight = 0, next = 0;
+    for (int r = 0; r < regions - 1; r++) {
+        int share = static_cast<int>((static_cast<long long>(total) * (r + 1)) / regions) - assignedWeight;
+        int weight = 0;
+        std::queue<int> frontier;
+        while (weight < share) {
+            if (frontier.empty()) {
+                while (next < n && regionOf[next] != -1)
+                    next++;
+                if (next == n)
+                    break;
+                regionOf[next] = r;
+                weight += level.vertexWeight[next];
+                frontier.push(next);
+                continue;
+            }
+            int u = frontier.front();
+            frontier.pop();
+            for (int k = level.offset[u]; k < level.offset[u + 1] && weight < share; k++) {
+                int v = level.neighbour[k];
+                if (regionOf[v] != -1)
+                    continue;
+                regionOf[v] = r;
+                weight += level.vertexWeight[v];
+                frontier.push(v);
+            }
+        }
+        assignedWeight += weight;
+    }
+    for (int v = 0; v < n; v++) {
+        if (regionOf[v] == -1)
+            regionOf[v] = regions - 1;
+    }
+}
+
+void GraphPartitioner::refine(const Level& level, int regions, std::vector<int>& regionOf) {
+    int n = level.size();
+    std::vector<long long> regionWeight(regions, 0);
+    long long total = 0;
+    for (int v = 0; v < n; v++) {
+        regionWeight[regionOf[v]] += level.vertexWeight[v];
+        total += level.vertexWeight[v];
+    }
+    long long maxWeight = static_cast<long long>(std::ceil(imbalance * total / regions));
+
+    std::vector<int> connection(regions, 0);
+    std::vector<int> touched;
+    for (int pass = 0; pass < refinementPasses; pass++) {
+        int moves = 0;
+        for (int u = 0; u < n; u++) {
+            int own = regionOf[u];
+            touched.clear();
+            for (int k = level.offset[u]; k < level.offset[u + 1]; k++) {
+                int r = regionOf[level.neighbour[k]];
+                if (connection[r] == 0)
+                    touched.push_back(r);
+                connection[r] += level.weight[k];
+            }
+
+            // best region to move to: highest gain, and an overweight region always gives vertices away
+            int best = own;
+            int bestGain = 0;
+            bool overweight = regionWeight[own] > maxWeight;
+            for (size_t i = 0; i < touched.size(); i++) {
+                int r = touched[i];
+                if (r == own || regionWeight[r] + level.vertexWeight[u] > maxWeight)
+                    continue;
+                int gain = connection[r] - connection[own];
+                bool better = best == own ? (gain > 0 || (gain == 0 && regionWeight[r] + level.vertexWeight[u] < regionWeight[own]) || overweight)
+                                          : (gain > bestGain || (gain == bestGain && r < best));
+                if (better) {
+                    best = r;
+                    bestGain = gain;
+                }
+            }
+            for (size_t i = 0; i < touched.size(); i++)
+                connection[touched[i]] = 0;
+
+            if (best != own) {
+                regionOf[u] = best;
+                regionWeight[own] -= level.vertexWeight[u];
+                regionWeight[best] += level.vertexWeight[u];
+                moves++;
+            }
+        }
+        if (moves == 0)
+            break;
+    }
+}
+
+int GraphPartitioner::getEdgeCut() const {
+    return edgeCut;
+}
+
+double GraphPartitioner::getImbalance() const {
+    return achievedImbalance;
+}
+
+int GraphPartitioner::getLevels() const {
+    return levels;
+}
@@ -0,0 +1,70 @@
+#ifndef GRAPH_PARTITIONER_H
+#define GRAPH_PARTITIONER_H
+
+#include <vector>
+#include "compactGraph.h"
+#include "graphCoarsening.h"
+
+/**
+ * @class GraphPartitioner
+ * @brief Multilevel partitioner splitting the road network into regions of similar size.
+ *
+ * The network is treated as undirected (a two-way road weighs twice a one-way road). It is coarsened
+ * by repeatedly merging each intersection with the neighbour it shares the heaviest roads with
+ * (heavy-edge matching), the coarsest graph is split by growing regions breadth-first, and the split
+ * is projected back level by level, moving boundary intersections to the region they are most
+ * connected to as long as no region grows past the allowed imbalance. The result only depends on the
+ * graph, the number of regions and the seed.
+ */
+class GraphPartitioner {
+public:
+    /**
+     * @brief Constructs a partitioner.
+     * @param imbalance Largest allowed region size relative to the average (e.g. 1.05 for +5%).
+     * @param refinementPasses Boundary refinement passes per level.
+     * @param seed Seed of the order intersections are matched in.
+     */
+    GraphPartitioner(double imbalance = 1.05, int refinementPasses = 4, unsigned int seed = 1);
+
+    /**
+     * @brief Splits the intersections of a network into regions.
+     * @param graph The road network.
+     * @param regions The number of regions (at least 1).
+     * @return The region (0 .. regions - 1) of each intersection.
+     */
+    std::vector<int> partition(const CompactGraph& graph, int regions);
+
+    /**
+     * @brief Gets the number of roads between two regions in the last partition.
+     * @return int
+     */
+    int getEdgeCut() const;
+
+    /**
+     * @brief Gets the size of the largest region relative to the average in the last partition.
+     * @return double
+     */
+    double getImbalance() const;
+
+    /**
+     * @brief Gets the number of coarsening levels of the last partition.
+     * @return int
+     */
+    int getLevels() const;
+
+private:
+    typedef CoarseningLevel Level;  /**< One weighted level per coarsening step */
+
+    double imbalance;
+    int refinementPasses;
+    unsigned int seed;
+    int edgeCut;
+    double achievedImbalance;
+    int levels;
+
+    void coarsen(Level& fine, Level& coarse);
+    void initialPartition(const Level& level, int regions, std::vector<int>& regionOf);
+    void refine(const Level& level, int regions, std::vector<int>& regionOf);
+};
+
+#endif // GRAPH_PARTITIONER_H
@@ -0,0 +1,182 @@
+#include "greenWave.h"
+#include "parallelFor.h"
+#include <iostream>
+
+GreenWaveOptimizer::GreenWaveOptimizer(int minCycle, int maxCycle, int cycleStep, int crossTime) {
+    this->minCycle = minCycle > 0 ? minCycle : 1;
+    this->maxCycle = maxCycle > this->minCycle ? maxCycle : this->minCycle;
+    this->cycleStep = cycleStep > 0 ? cycleStep : 1;
+    this->crossTime = crossTime > 0 ? crossTime : 0;
+}
+
+bool GreenWaveOptimizer::setCorridor(Graph& graph, const std::vector<std::string>& corridor) {
+    intersections.clear();
+    outboundTravel.clear();
+    inboundTravel.clear();
+    requestedGreen.clear();
+
+    for (size_t i = 0; i + 1 < corridor.size(); i++) {
+        int forward = graph.getEdgeWeight(corridor[i], corridor[i + 1]);
+        if (forward == -1) {
+            std::cerr << "Error: No road from " << corridor[i] << " to " << corridor[i + 1] << std::endl;
+            intersections.clear();
+            outboundTravel.clear();
+            inboundTravel.clear();
+            return false;
+        }
+        int backward = graph.getEdgeWeight(corridor[i + 1], corridor[i]);
+        outboundTravel.push_back(forward);
+        inboundTravel.push_back(backward == -1 ? forward : backward);
+    }
+    intersections = corridor;
+    requestedGreen.assign(corridor.size(), 30);
+    return !corridor.empty();
+}
+
+void GreenWaveOptimizer::setGreenTime(int index, int seconds) {
+    if (index >= 0 && index < static_cast<int>(requestedGreen.size()) && seconds > 0)
+        requestedGreen[index] = seconds;
+}
+
+int GreenWaveOptimizer::bandwidth(const std::vector<int>& arrival, const std::vector<int>& offsets,
+                                  const std::vector<int>& greens, int cycle) const {
+    // a vehicle leaving the first signal at time t (within the cycle) passes signal i on green
+    // when (t + arrival[i] - offsets[i]) mod cycle < greens[i]; count, for every t, the signals it passes
+    int n = static_cast<int>(offsets.size());
+    std::vector<int> delta(cycle + 1, 0);
+    for (int i = 0; i < n; i++) {
+        int start = ((offsets[i] - arrival[i]) % cycle + cycle) % cycle;
+        int end = start + greens[i];
+        if (end <= cycle) {
+            delta[start]++;
+            delta[end]--;
+        } else {
+            delta[start]++;
+            delta[cycle]--;
+            delta[0]++;
+            delta[end - cycle]--;
+        }
+    }
+
+    // longest circular run of departure times passing every signal on green
+    std::vector<bool> open(cycle);
+    int count = 0, openTotal = 0;
+    for (int t = 0; t < cycle; t++) {
+        count += delta[t];
+        open[t] = count == n;
+        if (open[t])
+            openTotal++;
+    }
+    if (openTotal == cycle)
+        return cycle;
+
+    int best = 0, run = 0;
+    for (int t = 0; t < 2 * cycle; t++) {
+        run = open[t % cycle] ? run + 1 : 0;
+        if (run > best)
+            best = run;
+    }
+    return best;
+}
+
+CorridorPlan GreenWaveOptimizer::optimizeCycle(int cycle) const {
+    int n = static_cast<int>(intersections.size());
+
+    std::vector<int> greens(n);
+    for (int i = 0; i < n; i++) {
+        int available = cycle - crossTime > 1 ? cycle - crossTime : 1;
+        greens[i] = requestedGreen[i] < available ? requestedGreen[i] : available;
+    }
+
+    // arrival times of the outbound band (from the first signal) and the inbound band (from the last one)
+    std::vector<int> outArrival(n, 0), inArrival(n, 0);
+    for (int i = 1; i < n; i++)
+        outArrival[i] = outArrival[i - 1] + outboundTravel[i - 1];
+    for (int i = n - 2; i >= 0; i--)
+        inArrival[i] = inArrival[i + 1] + inboundTravel[i];
+
+    CorridorPlan best;
+    int bestScore = -1;
+
+    // start once from a perfect outbound and once from a perfect inbound progression
+    for (int seed = 0; seed < 2; seed++) {
+        std::vector<int> offsets(n);
+        for (int i = 0; i < n; i++)
+            offsets[i] = (seed == 0 ? outArrival[i] : inArrival[i]) % cycle;
+
+        int score = bandwidth(outArrival, offsets, greens, cycle) + bandwidth(inArrival, offsets, greens, cycle);
+
+        // coordinate descent: only relative offsets matter, so the first signal stays fixed
+        bool improved = true;
+        for (int pass = 0; pass < 4 && improved; pass++) {
+            improved = false;
+            for (int i = 1; i < n; i++) {
+                int keep = offsets[i];
+                for (int candidate = 0; candidate < cycle; candidate++) {
+                    offsets[i] = candidate;
+                    int candidateScore = bandwidth(outArrival, offsets, greens, cycle) + bandwidth(inArrival, offsets, greens, cycle);
+                    if (candidateScore > score) {
+                        score = candidateScore;
+                        keep = candidate;
+                        improved = true;
+                    }
+                }
+                offsets[i] = keep;
+            }
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            best.offsets = offsets;
+            best.outboundBandwidth = bandwidth(outArrival, offsets, greens, cycle);
+            best.inboundBandwidth = bandwidth(inArrival, offsets, greens, cycle);
+        }
+    }
+
+    // express offsets relative to the first signal
+    for (int i = n - 1; i >= 0; i--)
+        best.offsets[i] = ((best.offsets[i] - best.offsets[0]) % cycle + cycle) % cycle;
+
+    best.intersections = intersections;
+    best.greenTimes = greens;
+    best.cycleLength = cycle;
+    return best;
+}
+
+CorridorPlan GreenWaveOptimizer::optimize(int threadCount) const {
+    if (intersections.empty())
+        return CorridorPlan();
+
+    std::vector<int> cycles;
+    for (int cycle = minCycle; cycle <= maxCycle; cycle += cycleStep)
+        cycles.push_back(cycle);
+
+    std::vector<CorridorPlan> plans(cycles.size());
+    parallelFor(static_cast<int>(cycles.size()), threadCount, [&](int begin, int end) {
+        for (int i = begin; i < end; i++)
+            plans[i] = optimizeCycle(cycles[i]);
+    });
+
+    // widest total bandwidth wins, ties go to the shorter cycle (earlier in the list)
+    int best = 0;
+    for (size_t i = 1; i < plans.size(); i++) {
+        int score = plans[i].outboundBandwidth + plans[i].inboundBandwidth;
+        int bestScore = plans[best].outboundBandwidth + plans[best].inboundBandwidth;
+        if (score > bestScore)
+            best = static_cast<int>(i);
+    }
+    return plans[best];
+}
+
+void GreenWaveOptimizer::printPlan(const CorridorPlan& plan) {
+    if (plan.cycleLength == 0) {
+        std::cout << "No corridor plan available." << std::endl;
+        return;
+    }
+    std::cout << "Cycle Length: " << plan.cycleLength << "s, Outbound Bandwidth: " << plan.outboundBandwidth
+              << "s, Inbound Bandwidth: " << plan.inboundBandwidth << "s" << std::endl;
+    for (size_t i = 0; i < plan.intersections.size(); i++) {
+        std::cout << "Intersection " << plan.intersections[i] << " Offset: " << plan.offsets[i]
+                  << "s Green Time: " << plan.greenTimes[i] << "s" << std::endl;
+    }
+}
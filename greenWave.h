@@ -0,0 +1,121 @@
+#ifndef GREEN_WAVE_H
+#define GREEN_WAVE_H
+
+#include <string>
+#include <vector>
+#include "graph.h"
+
+/**
+ * @struct CorridorPlan
+ * @brief Coordinated signal timings for the intersections of an arterial corridor.
+ *
+ * All signals of the corridor share the same cycle length. The offset of a signal is the time,
+ * within the cycle, at which its green phase starts.
+ */
+struct CorridorPlan {
+    std::vector<std::string> intersections; //< corridor intersections in travel order
+    std::vector<int> offsets; //< start of the green phase of each signal within the cycle, in seconds
+    std::vector<int> greenTimes; //< green time of each signal along the corridor, in seconds
+    int cycleLength; //< common cycle length in seconds (0 if no plan could be computed)
+    int outboundBandwidth; //< width of the green band travelling along the corridor, in seconds
+    int inboundBandwidth; //< width of the green band travelling against the corridor, in seconds
+
+    /**
+     * @brief Constructs an empty plan.
+     */
+    CorridorPlan() : cycleLength(0), outboundBandwidth(0), inboundBandwidth(0) {}
+};
+
+/**
+ * @class GreenWaveOptimizer
+ * @brief Computes signal offsets that maximize the green bandwidth along an arterial corridor.
+ *
+ * For every candidate cycle length the offsets start from a perfect outbound progression
+ * (each green starts when a platoon released at the first signal arrives, using Edge::travelTime)
+ * and are then improved one signal at a time to maximize the sum of the outbound and inbound
+ * bandwidths. Candidate cycle lengths are searched on several threads; the best plan wins, with
+ * ties going to the shorter cycle so results do not depend on the thread count.
+ */
+class GreenWaveOptimizer {
+private:
+    int minCycle;  //< shortest cycle length searched, in seconds
+    int maxCycle;  //< longest cycle length searched, in seconds
+    int cycleStep; //< step between two candidate cycle lengths, in seconds
+    int crossTime; //< part of every cycle reserved for cross traffic and transitions, in seconds
+
+    std::vector<std::string> intersections; //< corridor intersections in travel order
+    std::vector<int> outboundTravel; //< travel time from intersection i to i + 1
+    std::vector<int> inboundTravel;  //< travel time from intersection i + 1 to i
+    std::vector<int> requestedGreen; //< green time requested by each signal
+
+    /**
+     * @brief Computes the width of the longest green band through the corridor.
+     *
+     * @param arrival Arrival time of the band at each signal, relative to its departure.
+     * @param offsets Green start of each signal within the cycle.
+     * @param greens Green time of each signal.
+     * @param cycle Cycle length.
+     * @return The band width in seconds.
+     */
+    int bandwidth(const std::vector<int>& arrival, const std::vector<int>& offsets,
+                  const std::vector<int>& greens, int cycle) const;
+
+    /**
+     * @brief Finds the best offsets for one cycle length.
+     *
+     * @param cycle The cycle length to evaluate.
+     * @return The best plan found for this cycle length.
+     */
+    CorridorPlan optimizeCycle(int cycle) const;
+
+public:
+    /**
+     * @brief Constructs an optimizer searching cycle lengths in [minCycle, maxCycle].
+     *
+     * @param minCycle The shortest cycle length, in seconds.
+     * @param maxCycle The longest cycle length, in seconds.
+     * @param cycleStep The step between two candidate cycle lengths, in seconds.
+     * @param crossTime The part of every cycle reserved for cross traffic and yellow times, in seconds.
+     */
+    GreenWaveOptimizer(int minCycle = 60, int maxCycle = 150, int cycleStep = 5, int crossTime = 20);
+
+    /**
+     * @brief Sets the corridor to optimize.
+     *
+     * Consecutive intersections must be connected by a road; the road in the opposite direction is
+     * used for the inbound band when it exists, otherwise the outbound travel time is reused.
+     *
+     * @param graph The road network.
+     * @param corridor The corridor intersections in travel order.
+     * @return true if the corridor is valid, false otherwise.
+     */
+    bool setCorridor(Graph& graph, const std::vector<std::string>& corridor);
+
+    /**
+     * @brief Sets the green time requested by a signal of the corridor.
+     *
+     * The green time used in a plan is capped at the cycle length minus the cross time.
+     * Signals default to 30 seconds.
+     *
+     * @param index The position of the signal in the corridor.
+     * @param seconds The requested green time.
+     */
+    void setGreenTime(int index, int seconds);
+
+    /**
+     * @brief Searches every candidate cycle length and returns the plan with the widest bandwidth.
+     *
+     * @param threadCount The number of threads to use (0 uses every hardware thread).
+     * @return The best plan, or an empty plan (cycleLength 0) if no corridor is set.
+     */
+    CorridorPlan optimize(int threadCount = 0) const;
+
+    /**
+     * @brief Prints a plan on the console.
+     *
+     * @param plan The plan to print.
+     */
+    static void printPlan(const CorridorPlan& plan);
+};
+
+#endif // GREEN_WAVE_H
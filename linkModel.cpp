@@ -0,0 +1,232 @@
+#include "linkModel.h"
+#include "tracer.h"
+#include <algorithm>
+#include <cmath>
+
+LinkModel::LinkModel(double vehiclesPerTravelSecond, int saturationFlow)
+    : graph(nullptr), vehiclesPerTravelSecond(vehiclesPerTravelSecond > 0 ? vehiclesPerTravelSecond : 1.0),
+      saturationFlow(saturationFlow > 0 ? saturationFlow : 1), vehicleCount(0), regions(1), threads(1) {}
+
+void LinkModel::build(const CompactGraph& graph) {
+    this->graph = &graph;
+    int links = graph.getEdgeCount();
+    queues.assign(links, Queue());
+
+    int32_t total = 0;
+    for (int e = 0; e < links; e++) {
+        int travel = std::max(1, graph.travelTime[e]);
+        queues[e].offset = total;
+        queues[e].capacity = std::max(1, static_cast<int>(std::ceil(travel * vehiclesPerTravelSecond)));
+        total += queues[e].capacity;
+    }
+    entries.assign(total, Entry());
+
+    setRegions(std::vector<int>(graph.getIntersectionCount(), 0), 1);
+    clear();
+}
+
+void LinkModel::setRegions(const std::vector<int>& regionOf, int regions) {
+    this->regions = regions > 0 ? regions : 1;
+    regionLinks.assign(this->regions, std::vector<int32_t>());
+    for (int e = 0; e < getLinkCount(); e++) {
+        queues[e].region = regionOf[graph->edgeTarget[e]];
+        regionLinks[queues[e].region].push_back(e);
+    }
+    mailboxes.assign(this->regions * this->regions, std::vector<Crossing>());
+    outputs.assign(this->regions, RegionOutput());
+}
+
+void LinkModel::setThreadCount(int threads) {
+    threads = threads > 0 ? threads : 1;
+    if (threads == this->threads)
+        return;
+    this->threads = threads;
+    team.reset(threads > 1 ? new ThreadTeam(threads) : nullptr);
+}
+
+int LinkModel::getRegionCount() const {
+    return regions;
+}
+
+int LinkModel::getThreadCount() const {
+    return threads;
+}
+
+void LinkModel::clear() {
+    for (size_t e = 0; e < queues.size(); e++) {
+        queues[e].head = 0;
+        queues[e].length = 0;
+    }
+    vehicleCount = 0;
+}
+
+bool LinkModel::hasRoom(int link) const {
+    return queues[link].length < queues[link].capacity;
+}
+
+bool LinkModel::enter(int link, int vehicle, int time) {
+    if (!hasRoom(link))
+        return false;
+    Entry entry;
+    entry.vehicle = vehicle;
+    entry.exitTime = time + std::max(1, graph->travelTime[link]);
+    push(link, entry);
+    vehicleCount++;
+    return true;
+}
+
+void LinkModel::push(int link, const Entry& entry) {
+    Queue& queue = queues[link];
+    int position = queue.head + queue.length;
+    if (position >= queue.capacity)
+        position -= queue.capacity;
+    entries[queue.offset + position] = entry;
+    queue.length++;
+}
+
+int LinkModel::step(int time, const std::vector<unsigned char>& greenAt, VehicleStore& store,
+                    std::vector<int>& moved, std::vector<int>& finished) {
+    int links = getLinkCount();
+    int members = threads;
+
+    // lengths at the start of the step decide which roads have room
+    forEachMember([&](int member) {
+        TRACE_SCOPE("measureRoom", "movement");
+        int chunk = (links + members - 1) / members;
+        int begin = std::min(links, member * chunk), end = std::min(links, begin + chunk);
+        for (int e = begin; e < end; e++)
+            queues[e].room = queues[e].capacity - queues[e].length;
+    });
+
+    // every region serves its roads, posting vehicles bound for other regions
+    forEachMember([&](int member) {
+        TRACE_SCOPE("serveRegions", "movement");
+        for (int region = member; region < regions; region += members)
+            serveRegion(region, time, greenAt, store);
+    });
+
+    // every region takes in the vehicles posted to it, in order of the posting region
+    forEachMember([&](int member) {
+        TRACE_SCOPE("deliverCrossings", "movement");
+        for (int region = member; region < regions; region += members) {
+            for (int from = 0; from < regions; from++) {
+                std::vector<Crossing>& mailbox = mailboxes[from * regions + region];
+                for (size_t i = 0; i < mailbox.size(); i++)
+                    push(mailbox[i].link, mailbox[i].entry);
+                mailbox.clear();
+            }
+        }
+    });
+
+    int crossed = 0;
+    size_t finishedStart = finished.size();
+    for (int region = 0; region < regions; region++) {
+        RegionOutput& output = outputs[region];
+        moved.insert(moved.end(), output.moved.begin(), output.moved.end());
+        finished.insert(finished.end(), output.finished.begin(), output.finished.end());
+        crossed += output.crossed;
+    }
+    std::sort(finished.begin() + finishedStart, finished.end());
+    vehicleCount -= static_cast<int>(finished.size() - finishedStart);
+    return crossed;
+}
+
+void LinkModel::serveRegion(int region, int time, const std::vector<unsigned char>& greenAt, VehicleStore& store) {
+    RegionOutput& output = outputs[region];
+    output.moved.clear();
+    output.finished.clear();
+    int crossed = 0;
+
+    const std::vector<int32_t>& owned = regionLinks[region];
+    for (size_t i = 0; i < owned.size(); i++) {
+        int e = owned[i];
+        Queue& queue = queues[e];
+        if (queue.length == 0)
+            continue;
+        int target = graph->edgeTarget[e];
+        if (!greenAt[target])
+            continue;
+
+        for (int served = 0; served < saturationFlow && queue.length > 0; served++) {
+            const Entry& head = entries[queue.offset + queue.head];
+            if (head.exitTime > time)
+                break;
+            int slot = head.vehicle;
+
+            // the intersection after the end of this road on the vehicle's path
+            int length;
+            const int32_t* path = store.getPath(slot, length);
+            int position = store.getPathPosition(slot);
+            int after = position + 2 < length ? path[position + 2] : -1;
+
+            int next = -1;
+            if (after != -1) {
+                next = graph->findEdge(target, after);
+                // the head of the queue waits, and holds back the vehicles behind it
+                if (next == -1 || (graph->edgeFlags[next] & CompactGraph::EDGE_BLOCKED) || queues[next].room <= 0)
+                    break;
+            }
+
+            queue.head = queue.head + 1 == queue.capacity ? 0 : queue.head + 1;
+            queue.length--;
+            store.advance(slot);
+            if (next == -1) {
+                output.finished.push_back(slot);
+            } else {
+                Entry entry;
+                entry.vehicle = slot;
+                entry.exitTime = time + std::max(1, graph->travelTime[next]);
+                queues[next].room--;
+                int owner = queues[next].region;
+                if (owner == region) {
+                    push(next, entry);
+                } else {
+                    Crossing crossing;
+                    crossing.link = next;
+                    crossing.entry = entry;
+                    mailboxes[region * regions + owner].push_back(crossing);
+                }
+                store.setCurrentEdge(slot, next);
+                output.moved.push_back(slot);
+            }
+            crossed++;
+        }
+    }
+    output.crossed = crossed;
+}
+
+void LinkModel::forEachMember(const std::function<void(int)>& job) {
+    if (team)
+        team->run(job);
+    else
+        job(0);
+}
+
+int LinkModel::getQueueLength(int link) const {
+    return queues[link].length;
+}
+
+int LinkModel::getCapacity(int link) const {
+    return queues[link].capacity;
+}
+
+int LinkModel::getLinkCount() const {
+    return static_cast<int>(queues.size());
+}
+
+int LinkModel::getVehicleCount() const {
+    return vehicleCount;
+}
+
+const CompactGraph& LinkModel::getGraph() const {
+    return *graph;
+}
+
+std::size_t LinkModel::memoryUsage() const {
+    std::size_t bytes = queues.capacity() * sizeof(Queue) + entries.capacity() * sizeof(Entry);
+    for (size_t r = 0; r < regionLinks.size(); r++)
+        bytes += regionLinks[r].capacity() * sizeof(int32_t);
+    for (size_t m = 0; m < mailboxes.size(); m++)
+        bytes += mailboxes[m].capacity() * sizeof(Crossing);
+    return bytes;
+}
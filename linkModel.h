@@ -0,0 +1,221 @@
+#ifndef LINK_MODEL_H
+#define LINK_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "compactGraph.h"
+#include "threadTeam.h"
+#include "vehicleStore.h"
+
+/**
+ * @class LinkModel
+ * @brief Mesoscopic queueing model of the roads of a CompactGraph.
+ *
+ * Every road (link) is a FIFO of the vehicles on it, each with the earliest time it may leave the
+ * road (entry time + travel time). A road holds at most its capacity, which grows with its travel
+ * time; a vehicle may only enter a road that has room (spillback), so full roads hold back the
+ * vehicles upstream of them. The vehicle at the head of a road leaves once its exit time has passed,
+ * the signal at the end of the road is green and the next road of its path has room and is not
+ * blocked; at most saturationFlow vehicles leave a road per step.
+ *
+ * A step is synchronous: room on a road is judged from its length at the start of the step, so
+ * vehicles leaving a road during a step only make room for the next one. Within a step the roads
+ * are served in index order.
+ *
+ * The queues of all roads live in one array of (vehicle, exit time) entries, each road owning a
+ * ring buffer [offset, offset + capacity) of it, and vehicles are VehicleStore slots, so a step
+ * touches a few contiguous arrays whatever the number of vehicles. The bookkeeping of a road fits in
+ * one Queue record, so sending a vehicle onto a road costs a single cache miss.
+ *
+ * The network may be split into regions (see GraphPartitioner) stepped by a team of threads. A road
+ * belongs to the region of the intersection it ends at, and only that region's thread dequeues from
+ * it. A vehicle entering a road of another region is posted to the mailbox of that pair of regions
+ * and enqueued by the receiving region after a barrier; each mailbox has a single writer and a single
+ * reader that never run at the same time, so no locks are taken. Every road is only ever fed from the
+ * one intersection it starts at, so the result of a step is the same for any partition and any
+ * number of threads. Only the road queues are partitioned: the VehicleStore is shared (a slot is only
+ * written by the region whose road the vehicle is leaving) and the signals are updated by the caller.
+ */
+class LinkModel {
+public:
+    /**
+     * @brief Constructs an empty model.
+     * @param vehiclesPerTravelSecond Capacity of a road per second of travel time (at least 1 vehicle per road).
+     * @param saturationFlow Maximum number of vehicles leaving a road per step while green.
+     */
+    LinkModel(double vehiclesPerTravelSecond = 1.0, int saturationFlow = 1);
+
+    /**
+     * @brief Sizes the queues for the roads of a network and empties them.
+     * @param graph The road network; it must outlive the model.
+     */
+    void build(const CompactGraph& graph);
+
+    /**
+     * @brief Splits the network into regions stepped in parallel; call after build(), which resets it to one region.
+     * @param regionOf The region of each intersection, in [0, regions).
+     * @param regions The number of regions.
+     */
+    void setRegions(const std::vector<int>& regionOf, int regions);
+
+    /**
+     * @brief Sets the number of threads stepping the regions. Default 1.
+     * @param threads The number of threads, including the caller (values below 1 use 1).
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * @brief Gets the number of regions.
+     * @return int
+     */
+    int getRegionCount() const;
+
+    /**
+     * @brief Gets the number of threads stepping the regions.
+     * @return int
+     */
+    int getThreadCount() const;
+
+    /**
+     * @brief Empties every queue.
+     */
+    void clear();
+
+    /**
+     * @brief Checks if a road can take one more vehicle.
+     * @param link The index of the road.
+     * @return true if the road is not full, false otherwise.
+     */
+    bool hasRoom(int link) const;
+
+    /**
+     * @brief Puts a vehicle at the end of a road's queue.
+     * @param link The index of the road.
+     * @param vehicle The VehicleStore slot of the vehicle.
+     * @param time The current time in seconds; the vehicle may leave after the road's travel time.
+     * @return true if the vehicle entered, false if the road is full.
+     */
+    bool enter(int link, int vehicle, int time);
+
+    /**
+     * @brief Moves the vehicles that can leave their road at a given time.
+     *
+     * Each vehicle that leaves its road is advanced in the store: it enters the next road of its
+     * path (its current edge is set to it) or, at the end of its path, leaves the network (its
+     * current edge is set to VehicleStore::NO_EDGE). The vehicles that moved are listed in no
+     * particular order, the ones that finished by slot.
+     * @param time The current time in seconds.
+     * @param greenAt For each intersection, non-zero if vehicles may cross it.
+     * @param store The vehicles.
+     * @param moved Receives the slots of the vehicles that entered a new road.
+     * @param finished Receives the slots of the vehicles that reached the end of their path.
+     * @return The number of vehicles that crossed an intersection.
+     */
+    int step(int time, const std::vector<unsigned char>& greenAt, VehicleStore& store,
+             std::vector<int>& moved, std::vector<int>& finished);
+
+    /**
+     * @brief Gets the number of vehicles on a road.
+     * @param link The index of the road.
+     * @return int
+     */
+    int getQueueLength(int link) const;
+
+    /**
+     * @brief Gets the maximum number of vehicles on a road.
+     * @param link The index of the road.
+     * @return int
+     */
+    int getCapacity(int link) const;
+
+    /**
+     * @brief Gets the number of roads.
+     * @return int
+     */
+    int getLinkCount() const;
+
+    /**
+     * @brief Gets the number of vehicles on all roads.
+     * @return int
+     */
+    int getVehicleCount() const;
+
+    /**
+     * @brief Gets the road network the model was built for.
+     * @return const CompactGraph&
+     */
+    const CompactGraph& getGraph() const;
+
+    /**
+     * @brief Gets the memory used by the queues (allocated capacity).
+     * @return std::size_t Bytes.
+     */
+    std::size_t memoryUsage() const;
+
+private:
+    /**
+     * @struct Entry
+     * @brief A vehicle in a road's queue.
+     */
+    struct Entry {
+        int32_t vehicle;   /**< VehicleStore slot */
+        int32_t exitTime;  /**< Earliest time the vehicle may leave the road */
+    };
+
+    /**
+     * @struct Crossing
+     * @brief A vehicle entering a road of another region, posted to that region's mailbox.
+     */
+    struct Crossing {
+        int32_t link;   /**< Road entered */
+        Entry entry;    /**< Vehicle and exit time */
+    };
+
+    /**
+     * @struct Queue
+     * @brief The ring buffer and step bookkeeping of a road.
+     */
+    struct Queue {
+        int32_t offset;    /**< Start of the ring buffer in entries */
+        int32_t capacity;  /**< Size of the ring buffer */
+        int32_t head;      /**< Position of the first vehicle in the ring buffer */
+        int32_t length;    /**< Number of vehicles on the road */
+        int32_t room;      /**< Vehicles the road can still take in the current step */
+        int32_t region;    /**< Region owning the road */
+    };
+
+    /**
+     * @struct RegionOutput
+     * @brief What the thread of a region produced during a step.
+     */
+    struct RegionOutput {
+        std::vector<int> moved;     /**< Vehicles that entered a new road */
+        std::vector<int> finished;  /**< Vehicles that reached the end of their path */
+        int crossed;                /**< Vehicles that crossed an intersection */
+    };
+
+    const CompactGraph* graph;           /**< Road network (nullptr until build()) */
+    double vehiclesPerTravelSecond;      /**< Capacity per second of travel time */
+    int saturationFlow;                  /**< Vehicles leaving a road per step */
+
+    std::vector<Queue> queues;           /**< Queue of each road */
+    std::vector<Entry> entries;          /**< Ring buffers of every road */
+    int vehicleCount;                    /**< Vehicles on all roads */
+
+
+    int regions;                                        /**< Number of regions */
+    std::vector<std::vector<int32_t> > regionLinks;     /**< Roads of each region, in index order */
+    std::vector<std::vector<Crossing> > mailboxes;      /**< Crossings from region s to region d at s * regions + d */
+    std::vector<RegionOutput> outputs;                  /**< Output of each region for the current step */
+    std::unique_ptr<ThreadTeam> team;                   /**< Workers stepping the regions (nullptr for one thread) */
+    int threads;                                        /**< Number of threads stepping the regions */
+
+    void push(int link, const Entry& entry);
+    void serveRegion(int region, int time, const std::vector<unsigned char>& greenAt, VehicleStore& store);
+    void forEachMember(const std::function<void(int)>& job);
+};
+
+#endif // LINK_MODEL_H
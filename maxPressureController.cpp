@@ -0,0 +1,207 @@
+#include "maxPressureController.h"
+#include "linkModel.h"
+#include "parallelFor.h"
+#include <iostream>
+
+MaxPressureController::MaxPressureController(int minGreen, int maxGreen, int secondsPerVehicle) {
+      // the bounds should be positive and ordered
+      this->minGreen = minGreen > 0 ? minGreen : 1;
+      this->maxGreen = maxGreen > this->minGreen ? maxGreen : this->minGreen;
+      this->secondsPerVehicle = secondsPerVehicle > 0 ? secondsPerVehicle : 1;
+      finalized = false;
+      warnedUntracked = false;
+}
+
+void MaxPressureController::clear() {
+      names.clear();
+      indexOf.clear();
+      roadFrom.clear();
+      roadTo.clear();
+      queue.clear();
+      linkOf.clear();
+      finalized = false;
+      warnedUntracked = false;
+}
+
+int MaxPressureController::addIntersection(const std::string& name) {
+      std::unordered_map<std::string, int>::iterator found = indexOf.find(name);
+      if (found != indexOf.end())
+            return found->second;
+
+      int index = static_cast<int>(names.size());
+      names.push_back(name);
+      indexOf[name] = index;
+      finalized = false;
+      return index;
+}
+
+int MaxPressureController::addRoad(int from, int to) {
+      roadFrom.push_back(from);
+      roadTo.push_back(to);
+      queue.push_back(0);
+      linkOf.clear();
+      finalized = false;
+      return static_cast<int>(roadFrom.size()) - 1;
+}
+
+void MaxPressureController::build(Graph& graph) {
+      clear();
+      for (VertexNode* v = graph.headVertex; v; v = v->next)
+            addIntersection(v->vertex->name);
+
+      for (VertexNode* v = graph.headVertex; v; v = v->next) {
+            int from = indexOf[v->vertex->name];
+            for (EdgeNode* e = v->vertex->edges; e; e = e->next)
+                  addRoad(from, addIntersection(e->edge->destination->name));
+      }
+      finalize();
+}
+
+void MaxPressureController::finalize() {
+      int intersections = static_cast<int>(names.size());
+      int roads = static_cast<int>(roadFrom.size());
+
+      // counting sort of the roads by downstream (incoming lists) and upstream (outgoing lists) intersection
+      inOffset.assign(intersections + 1, 0);
+      outOffset.assign(intersections + 1, 0);
+      for (int r = 0; r < roads; r++) {
+            inOffset[roadTo[r] + 1]++;
+            outOffset[roadFrom[r] + 1]++;
+      }
+      for (int i = 0; i < intersections; i++) {
+            inOffset[i + 1] += inOffset[i];
+            outOffset[i + 1] += outOffset[i];
+      }
+
+      inRoads.resize(roads);
+      outRoads.resize(roads);
+      std::vector<int> inFill(inOffset.begin(), inOffset.end() - 1);
+      std::vector<int> outFill(outOffset.begin(), outOffset.end() - 1);
+      for (int r = 0; r < roads; r++) {
+            inRoads[inFill[roadTo[r]]++] = r;
+            outRoads[outFill[roadFrom[r]]++] = r;
+      }
+
+      servedRoad.assign(intersections, -1);
+      pressure.assign(intersections, 0);
+      greenTime.assign(intersections, minGreen);
+      finalized = true;
+}
+
+void MaxPressureController::setQueue(int road, int vehicles) {
+      if (road >= 0 && road < static_cast<int>(queue.size()))
+            queue[road] = vehicles > 0 ? vehicles : 0;
+}
+
+void MaxPressureController::loadQueues(CongestionMonitoring& ht) {
+      int untracked = 0;
+      for (size_t r = 0; r < queue.size(); r++) {
+            const std::string& from = names[roadFrom[r]];
+            const std::string& to = names[roadTo[r]];
+            queue[r] = 0;
+
+            // the congestion table is keyed by single-letter intersection ids
+            if (from.size() != 1 || to.size() != 1 || from[0] < 'A' || from[0] > 'Z' || to[0] < 'A' || to[0] > 'Z') {
+                  untracked++;
+                  continue;
+            }
+            RoadNode* node = ht.findRoadNode(from[0], to[0]);
+            if (node)
+                  queue[r] = node->carCount;
+      }
+      if (untracked > 0 && !warnedUntracked) {
+            std::cerr << "Warning: " << untracked << " roads join intersections that are not single letters A-Z; "
+                      << "the congestion table does not track them and their queues count as empty" << std::endl;
+            warnedUntracked = true;
+      }
+}
+
+void MaxPressureController::loadQueues(const LinkModel& links) {
+      const CompactGraph& graph = links.getGraph();
+      // the roads of both networks are matched once, until the controller is rebuilt
+      if (linkOf.size() != queue.size()) {
+            linkOf.assign(queue.size(), -1);
+            for (size_t r = 0; r < queue.size(); r++) {
+                  int from = graph.findIntersection(names[roadFrom[r]]);
+                  int to = graph.findIntersection(names[roadTo[r]]);
+                  if (from != -1 && to != -1)
+                        linkOf[r] = graph.findEdge(from, to);
+            }
+      }
+      for (size_t r = 0; r < queue.size(); r++)
+            queue[r] = linkOf[r] == -1 ? 0 : links.getQueueLength(linkOf[r]);
+}
+
+void MaxPressureController::evaluate(int begin, int end) {
+      for (int i = begin; i < end; i++) {
+            int outSum = 0;
+            int outCount = outOffset[i + 1] - outOffset[i];
+            for (int k = outOffset[i]; k < outOffset[i + 1]; k++)
+                  outSum += queue[outRoads[k]];
+
+            int bestRoad = -1;
+            int bestPressure = 0;
+            for (int k = inOffset[i]; k < inOffset[i + 1]; k++) {
+                  int road = inRoads[k];
+                  int upstream = roadFrom[road];
+
+                  // vehicles on this road can leave towards every outgoing road except the U-turn
+                  int downstreamSum = outSum;
+                  int downstreamCount = outCount;
+                  for (int j = outOffset[i]; j < outOffset[i + 1]; j++) {
+                        if (roadTo[outRoads[j]] == upstream) {
+                              downstreamSum -= queue[outRoads[j]];
+                              downstreamCount--;
+                        }
+                  }
+
+                  int downstream = downstreamCount > 0 ? (downstreamSum + downstreamCount / 2) / downstreamCount : 0;
+                  int roadPressure = queue[road] - downstream;
+                  if (bestRoad == -1 || roadPressure > bestPressure) {
+                        bestRoad = road;
+                        bestPressure = roadPressure;
+                  }
+            }
+
+            int green = minGreen + (bestPressure > 0 ? bestPressure * secondsPerVehicle : 0);
+            servedRoad[i] = bestRoad;
+            pressure[i] = bestPressure;
+            greenTime[i] = green < maxGreen ? green : maxGreen;
+      }
+}
+
+void MaxPressureController::runControlCycle(int threadCount) {
+      if (!finalized)
+            finalize();
+      parallelFor(static_cast<int>(names.size()), threadCount, [this](int begin, int end) {
+            evaluate(begin, end);
+      });
+}
+
+int MaxPressureController::getIntersectionCount() const {
+      return static_cast<int>(names.size());
+}
+
+int MaxPressureController::getRoadCount() const {
+      return static_cast<int>(roadFrom.size());
+}
+
+const std::string& MaxPressureController::getName(int intersection) const {
+      return names[intersection];
+}
+
+int MaxPressureController::getRoadFrom(int road) const {
+      return roadFrom[road];
+}
+
+int MaxPressureController::getGreenTime(int intersection) const {
+      return greenTime[intersection];
+}
+
+int MaxPressureController::getServedRoad(int intersection) const {
+      return servedRoad[intersection];
+}
+
+int MaxPressureController::getPressure(int intersection) const {
+      return pressure[intersection];
+}
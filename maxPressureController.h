@@ -0,0 +1,178 @@
+#ifndef MAX_PRESSURE_CONTROLLER_H
+#define MAX_PRESSURE_CONTROLLER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "graph.h"
+#include "congestionMonitoring.h"
+
+class LinkModel;
+
+/**
+ * @class MaxPressureController
+ * @brief Adaptive signal controller based on the max-pressure policy.
+ *
+ * Every incoming road of an intersection is a phase. The pressure of a phase is the queue on the
+ * incoming road minus the average queue on the roads leaving the intersection (the U-turn back to
+ * the upstream intersection is ignored). Each control cycle the phase with the highest pressure is
+ * served and the green time of the intersection grows with that pressure, bounded by
+ * [minGreen, maxGreen], so durations can never run away.
+ *
+ * The network is stored as flat arrays indexed by intersection and road so that all intersections
+ * can be evaluated independently, in parallel, during a control cycle.
+ */
+class MaxPressureController {
+      private:
+            int minGreen; //< lower bound of the green time in seconds
+            int maxGreen; //< upper bound of the green time in seconds
+            int secondsPerVehicle; //< extra green time granted per vehicle of pressure
+            bool finalized; //< whether the incoming/outgoing road lists are up to date
+
+            std::vector<std::string> names; //< intersection names indexed by intersection
+            std::unordered_map<std::string, int> indexOf; //< intersection name -> index
+            std::vector<int> roadFrom; //< upstream intersection of each road
+            std::vector<int> roadTo; //< downstream intersection of each road
+            std::vector<int> queue; //< vehicles queued on each road
+            std::vector<int> linkOf; //< link model road of each road (-1 if none), filled by the first loadQueues(links)
+            bool warnedUntracked; //< whether loadQueues(ht) already reported roads the table does not track
+
+            std::vector<int> inOffset; //< start of each intersection's incoming roads in inRoads
+            std::vector<int> inRoads; //< incoming roads grouped by intersection
+            std::vector<int> outOffset; //< start of each intersection's outgoing roads in outRoads
+            std::vector<int> outRoads; //< outgoing roads grouped by intersection
+
+            std::vector<int> servedRoad; //< road given green in the last cycle (-1 if none)
+            std::vector<int> pressure; //< pressure of the served phase in the last cycle
+            std::vector<int> greenTime; //< green time chosen in the last cycle
+
+            /**
+             * @brief Groups the roads by their downstream and upstream intersections.
+             */
+            void finalize();
+
+            /**
+             * @brief Evaluates the intersections in [begin, end).
+             */
+            void evaluate(int begin, int end);
+
+      public:
+            /**
+             * @brief Constructs an empty controller.
+             *
+             * @param minGreen The shortest green time that can be assigned, in seconds.
+             * @param maxGreen The longest green time that can be assigned, in seconds.
+             * @param secondsPerVehicle The green time added per vehicle of pressure, in seconds.
+             */
+            MaxPressureController(int minGreen = 10, int maxGreen = 90, int secondsPerVehicle = 2);
+
+            /**
+             * @brief Removes every intersection and road.
+             */
+            void clear();
+
+            /**
+             * @brief Adds an intersection, or returns the existing one with the same name.
+             *
+             * @param name The name of the intersection.
+             * @return The index of the intersection.
+             */
+            int addIntersection(const std::string& name);
+
+            /**
+             * @brief Adds a directed road between two intersections.
+             *
+             * @param from The index of the upstream intersection.
+             * @param to The index of the downstream intersection.
+             * @return The index of the road.
+             */
+            int addRoad(int from, int to);
+
+            /**
+             * @brief Rebuilds the controller's network from the city graph.
+             *
+             * @param graph The road network.
+             */
+            void build(Graph& graph);
+
+            /**
+             * @brief Sets the number of vehicles queued on a road.
+             *
+             * @param road The index of the road.
+             * @param vehicles The number of queued vehicles.
+             */
+            void setQueue(int road, int vehicles);
+
+            /**
+             * @brief Reads the queue of every road from the congestion monitoring hash table.
+             *
+             * The table only tracks roads between single-letter intersections; the other roads get an
+             * empty queue and a warning is printed once per network.
+             *
+             * @param ht The congestion monitoring hash table.
+             */
+            void loadQueues(CongestionMonitoring& ht);
+
+            /**
+             * @brief Reads the queue of every road from a link model, matching roads by intersection names.
+             *
+             * @param links The link model the vehicles move through, built on the same network.
+             */
+            void loadQueues(const LinkModel& links);
+
+            /**
+             * @brief Runs one control cycle, evaluating all intersections in parallel.
+             *
+             * @param threadCount The number of threads to use (0 uses every hardware thread).
+             */
+            void runControlCycle(int threadCount = 0);
+
+            /**
+             * @brief Gets the number of intersections.
+             * @return int
+             */
+            int getIntersectionCount() const;
+
+            /**
+             * @brief Gets the number of roads.
+             * @return int
+             */
+            int getRoadCount() const;
+
+            /**
+             * @brief Gets the name of an intersection.
+             * @param intersection The index of the intersection.
+             * @return const std::string&
+             */
+            const std::string& getName(int intersection) const;
+
+            /**
+             * @brief Gets the upstream intersection of a road.
+             * @param road The index of the road.
+             * @return int
+             */
+            int getRoadFrom(int road) const;
+
+            /**
+             * @brief Gets the green time chosen for an intersection in the last cycle.
+             * @param intersection The index of the intersection.
+             * @return int Green time in seconds.
+             */
+            int getGreenTime(int intersection) const;
+
+            /**
+             * @brief Gets the road served at an intersection in the last cycle.
+             * @param intersection The index of the intersection.
+             * @return int The index of the road, or -1 if the intersection has no incoming road.
+             */
+            int getServedRoad(int intersection) const;
+
+            /**
+             * @brief Gets the pressure of the phase served at an intersection in the last cycle.
+             * @param intersection The index of the intersection.
+             * @return int
+             */
+            int getPressure(int intersection) const;
+};
+
+#endif // MAX_PRESSURE_CONTROLLER_H
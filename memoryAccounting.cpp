@@ -0,0 +1,96 @@
+#include "memoryAccounting.h"
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+const char* const SUBSYSTEM_NAMES[MEMORY_SUBSYSTEM_COUNT] = {
+    "graph", "vehicles", "congestion", "heap", "signals", "accidents", "gps"
+};
+
+struct SubsystemCounters {
+    std::atomic<long long> liveBytes;
+    std::atomic<long long> peakBytes;
+    std::atomic<long long> liveAllocations;
+    std::atomic<long long> totalAllocations;
+};
+
+// zero-initialized before any object can be allocated, even by a static constructor
+SubsystemCounters counters[MEMORY_SUBSYSTEM_COUNT];
+}
+
+void MemoryAccounting::allocated(MemorySubsystem subsystem, std::size_t bytes) {
+    SubsystemCounters& counter = counters[subsystem];
+    long long live = counter.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + static_cast<long long>(bytes);
+    counter.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    counter.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    long long peak = counter.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !counter.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void MemoryAccounting::released(MemorySubsystem subsystem, std::size_t bytes) {
+    SubsystemCounters& counter = counters[subsystem];
+    counter.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    counter.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoryStats MemoryAccounting::getStats(MemorySubsystem subsystem) {
+    const SubsystemCounters& counter = counters[subsystem];
+    MemoryStats stats;
+    stats.liveBytes = counter.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+    stats.liveAllocations = counter.liveAllocations.load(std::memory_order_relaxed);
+    stats.totalAllocations = counter.totalAllocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* MemoryAccounting::getSubsystemName(MemorySubsystem subsystem) {
+    return subsystem >= 0 && subsystem < MEMORY_SUBSYSTEM_COUNT ? SUBSYSTEM_NAMES[subsystem] : "unknown";
+}
+
+void MemoryAccounting::printSummary() {
+    std::cout << std::left << std::setw(12) << "Subsystem" << std::right << std::setw(14) << "Live KiB"
+              << std::setw(14) << "Peak KiB" << std::setw(12) << "Live" << std::setw(14) << "Allocations" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    MemoryStats total = {0, 0, 0, 0};
+    for (int s = 0; s < MEMORY_SUBSYSTEM_COUNT; s++) {
+        MemoryStats stats = getStats(static_cast<MemorySubsystem>(s));
+        total.liveBytes += stats.liveBytes;
+        total.peakBytes += stats.peakBytes;
+        total.liveAllocations += stats.liveAllocations;
+        total.totalAllocations += stats.totalAllocations;
+        std::cout << std::left << std::setw(12) << SUBSYSTEM_NAMES[s] << std::right
+                  << std::setw(14) << stats.liveBytes / 1024.0 << std::setw(14) << stats.peakBytes / 1024.0
+                  << std::setw(12) << stats.liveAllocations << std::setw(14) << stats.totalAllocations << std::endl;
+    }
+    // the peaks of different subsystems need not coincide, so their sum is an upper bound
+    std::cout << std::left << std::setw(12) << "total" << std::right
+              << std::setw(14) << total.liveBytes / 1024.0 << std::setw(14) << total.peakBytes / 1024.0
+              << std::setw(12) << total.liveAllocations << std::setw(14) << total.totalAllocations << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+bool MemoryAccounting::writeJson(const std::string& filename) {
+    std::ofstream file(filename.c_str());
+    if (!file) {
+        std::cerr << "Error: Unable to open file " << filename << std::endl;
+        return false;
+    }
+    file << "{\n  \"subsystems\": [\n";
+    for (int s = 0; s < MEMORY_SUBSYSTEM_COUNT; s++) {
+        MemoryStats stats = getStats(static_cast<MemorySubsystem>(s));
+        file << "    {\"name\": \"" << SUBSYSTEM_NAMES[s] << "\", \"liveBytes\": " << stats.liveBytes
+             << ", \"peakBytes\": " << stats.peakBytes << ", \"liveAllocations\": " << stats.liveAllocations
+             << ", \"totalAllocations\": " << stats.totalAllocations << "}"
+             << (s + 1 < MEMORY_SUBSYSTEM_COUNT ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    file.close();
+    if (!file) {
+        std::cerr << "Error: Unable to write file " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
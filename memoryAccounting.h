@@ -0,0 +1,169 @@
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <cstddef>
+#include <new>
+#include <string>
+
+/**
+ * @brief The subsystems whose heap memory is accounted.
+ */
+enum MemorySubsystem {
+    MEMORY_GRAPH,         /**< Intersections, roads and their list nodes */
+    MEMORY_VEHICLES,      /**< Vehicles, their paths and the ID index */
+    MEMORY_CONGESTION,    /**< Chained nodes of the congestion hash table */
+    MEMORY_HEAP,          /**< Nodes and queues of the congestion max heap */
+    MEMORY_SIGNALS,       /**< Traffic signals */
+    MEMORY_ACCIDENTS,     /**< Blocked and under repair road lists */
+    MEMORY_GPS,           /**< Cached paths */
+    MEMORY_SUBSYSTEM_COUNT
+};
+
+/**
+ * @struct MemoryStats
+ * @brief The heap usage of one subsystem.
+ */
+struct MemoryStats {
+    long long liveBytes;          /**< Bytes allocated and not yet released */
+    long long peakBytes;          /**< Highest liveBytes so far */
+    long long liveAllocations;    /**< Blocks allocated and not yet released */
+    long long totalAllocations;   /**< Blocks allocated so far */
+};
+
+/**
+ * @class MemoryAccounting
+ * @brief Counts the heap memory held by each subsystem.
+ *
+ * The structures of a subsystem report their allocations either by deriving from MemoryTracked
+ * (for nodes created with new) or by using a TrackingAllocator (for standard containers). Counts
+ * are relaxed atomics, so any thread may allocate without locks. The bytes are those requested:
+ * allocator overhead, the characters of plain std::string members (names and IDs) and objects
+ * embedded in another (such as the fixed congestion table) are not counted.
+ */
+class MemoryAccounting {
+public:
+    /**
+     * @brief Adds a block to a subsystem.
+     * @param subsystem The subsystem.
+     * @param bytes The size of the block.
+     */
+    static void allocated(MemorySubsystem subsystem, std::size_t bytes);
+
+    /**
+     * @brief Removes a block from a subsystem.
+     * @param subsystem The subsystem.
+     * @param bytes The size of the block, as given to allocated().
+     */
+    static void released(MemorySubsystem subsystem, std::size_t bytes);
+
+    /**
+     * @brief Gets the heap usage of a subsystem.
+     * @param subsystem The subsystem.
+     * @return MemoryStats
+     */
+    static MemoryStats getStats(MemorySubsystem subsystem);
+
+    /**
+     * @brief Gets the name of a subsystem, as printed and in the JSON dump.
+     * @param subsystem The subsystem.
+     * @return const char*
+     */
+    static const char* getSubsystemName(MemorySubsystem subsystem);
+
+    /**
+     * @brief Prints a table of live bytes, peak bytes, live and total allocations per subsystem.
+     */
+    static void printSummary();
+
+    /**
+     * @brief Writes the heap usage of every subsystem as JSON.
+     * @param filename The file to write.
+     * @return true on success, false otherwise (an error is printed).
+     */
+    static bool writeJson(const std::string& filename);
+};
+
+/**
+ * @class MemoryTracked
+ * @brief Base class that accounts every object of the derived class created with new in a subsystem.
+ *
+ * It adds no data member and no virtual function, so the derived class keeps its size and layout.
+ */
+template <MemorySubsystem S>
+class MemoryTracked {
+public:
+    static void* operator new(std::size_t size) {
+        void* block = ::operator new(size);
+        MemoryAccounting::allocated(S, size);
+        return block;
+    }
+
+    static void* operator new[](std::size_t size) {
+        void* block = ::operator new[](size);
+        MemoryAccounting::allocated(S, size);
+        return block;
+    }
+
+    static void operator delete(void* block, std::size_t size) {
+        if (block == nullptr)
+            return;
+        MemoryAccounting::released(S, size);
+        ::operator delete(block);
+    }
+
+    static void operator delete[](void* block, std::size_t size) {
+        if (block == nullptr)
+            return;
+        MemoryAccounting::released(S, size);
+        ::operator delete[](block);
+    }
+};
+
+/**
+ * @class TrackingAllocator
+ * @brief A standard allocator that accounts the storage of a container in a subsystem.
+ */
+template <typename T, MemorySubsystem S>
+class TrackingAllocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind {
+        typedef TrackingAllocator<U, S> other;
+    };
+
+    TrackingAllocator() {}
+
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U, S>&) {}
+
+    T* allocate(std::size_t count) {
+        T* block = static_cast<T*>(::operator new(count * sizeof(T)));
+        MemoryAccounting::allocated(S, count * sizeof(T));
+        return block;
+    }
+
+    void deallocate(T* block, std::size_t count) {
+        MemoryAccounting::released(S, count * sizeof(T));
+        ::operator delete(block);
+    }
+};
+
+template <typename T, typename U, MemorySubsystem S>
+bool operator==(const TrackingAllocator<T, S>&, const TrackingAllocator<U, S>&) {
+    return true;
+}
+
+template <typename T, typename U, MemorySubsystem S>
+bool operator!=(const TrackingAllocator<T, S>&, const TrackingAllocator<U, S>&) {
+    return false;
+}
+
+#endif // MEMORY_ACCOUNTING_H
@@ -0,0 +1,109 @@
+#include "metrics.h"
+#include <iostream>
+#include <sstream>
+
+Histogram::Histogram(const std::vector<double>& bounds)
+    : bounds(bounds), counts(new std::atomic<long long>[bounds.size() + 1]), count(0), sum(0) {
+    for (std::size_t b = 0; b <= bounds.size(); b++)
+        counts[b].store(0, std::memory_order_relaxed);
+}
+
+void Histogram::observe(double value) {
+    std::size_t bucket = 0;
+    while (bucket < bounds.size() && value > bounds[bucket])
+        bucket++;
+    counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    double total = sum.load(std::memory_order_relaxed);
+    while (!sum.compare_exchange_weak(total, total + value, std::memory_order_relaxed)) {}
+}
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::add(const std::string& name, const std::string& help, Type type, bool& created) {
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        if (entries[i]->name != name)
+            continue;
+        if (entries[i]->type == type) {
+            created = false;
+            return *entries[i];
+        }
+        // a working metric for the caller, but the first registration keeps the name
+        std::cerr << "Error: Metric " << name << " is already registered with another type" << std::endl;
+        conflicts.push_back(std::unique_ptr<Entry>(new Entry));
+        conflicts.back()->type = type;
+        created = true;
+        return *conflicts.back();
+    }
+    entries.push_back(std::unique_ptr<Entry>(new Entry));
+    Entry& entry = *entries.back();
+    entry.name = name;
+    entry.help = help;
+    entry.type = type;
+    created = true;
+    return entry;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    bool created;
+    Entry& entry = add(name, help, COUNTER, created);
+    if (created)
+        entry.counter.reset(new Counter);
+    return *entry.counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    bool created;
+    Entry& entry = add(name, help, GAUGE, created);
+    if (created)
+        entry.gauge.reset(new Gauge);
+    return *entry.gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const std::vector<double>& bounds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    bool created;
+    Entry& entry = add(name, help, HISTOGRAM, created);
+    if (created)
+        entry.histogram.reset(new Histogram(bounds));
+    return *entry.histogram;
+}
+
+std::string MetricsRegistry::render() const {
+    std::ostringstream out;
+    out.precision(12);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        const Entry& entry = *entries[i];
+        out << "# HELP " << entry.name << " " << entry.help << "\n";
+        switch (entry.type) {
+            case COUNTER:
+                out << "# TYPE " << entry.name << " counter\n" << entry.name << " " << entry.counter->get() << "\n";
+                break;
+            case GAUGE:
+                out << "# TYPE " << entry.name << " gauge\n" << entry.name << " " << entry.gauge->get() << "\n";
+                break;
+            case HISTOGRAM: {
+                const Histogram& histogram = *entry.histogram;
+                out << "# TYPE " << entry.name << " histogram\n";
+                // buckets are cumulative in the exposition format
+                long long cumulative = 0;
+                for (std::size_t b = 0; b < histogram.getBounds().size(); b++) {
+                    cumulative += histogram.getBucketCount(b);
+                    out << entry.name << "_bucket{le=\"" << histogram.getBounds()[b] << "\"} " << cumulative << "\n";
+                }
+                cumulative += histogram.getBucketCount(histogram.getBounds().size());
+                out << entry.name << "_bucket{le=\"+Inf\"} " << cumulative << "\n";
+                out << entry.name << "_sum " << histogram.getSum() << "\n";
+                out << entry.name << "_count " << cumulative << "\n";
+                break;
+            }
+        }
+    }
+    return out.str();
+}
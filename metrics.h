@@ -0,0 +1,146 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class Counter
+ * @brief A count that only goes up, updated from any thread without locks.
+ */
+class Counter {
+public:
+    Counter() : value(0) {}
+    void increment(long long amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    long long get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<long long> value;
+};
+
+/**
+ * @class Gauge
+ * @brief A value that is set to the current level of something, from any thread without locks.
+ */
+class Gauge {
+public:
+    Gauge() : value(0) {}
+    void set(long long level) { value.store(level, std::memory_order_relaxed); }
+    long long get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<long long> value;
+};
+
+/**
+ * @class Histogram
+ * @brief Counts observations in buckets of fixed upper bounds, from any thread without locks.
+ */
+class Histogram {
+public:
+    /**
+     * @brief Constructs a histogram.
+     * @param bounds The upper bounds of the buckets, increasing; a last bucket takes larger values.
+     */
+    explicit Histogram(const std::vector<double>& bounds);
+
+    /**
+     * @brief Adds an observation.
+     * @param value The observed value.
+     */
+    void observe(double value);
+
+    const std::vector<double>& getBounds() const { return bounds; }
+
+    /**
+     * @brief Gets the number of observations of a bucket (not cumulative).
+     * @param bucket The bucket, from 0 to getBounds().size() (the last one is unbounded).
+     * @return long long
+     */
+    long long getBucketCount(std::size_t bucket) const { return counts[bucket].load(std::memory_order_relaxed); }
+
+    long long getCount() const { return count.load(std::memory_order_relaxed); }
+    double getSum() const { return sum.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<double> bounds;
+    std::unique_ptr<std::atomic<long long>[]> counts;
+    std::atomic<long long> count;
+    std::atomic<double> sum;
+};
+
+/**
+ * @class MetricsRegistry
+ * @brief The named metrics of the process, rendered in the Prometheus text exposition format.
+ *
+ * Metrics are registered once (usually by the constructor of the subsystem that updates them) and
+ * then updated through the returned reference, which stays valid for the life of the registry.
+ * Registering a name again returns the existing metric. Updates are atomic operations and never take
+ * the registry lock, so rendering a scrape on another thread does not block the simulation.
+ */
+class MetricsRegistry {
+public:
+    /**
+     * @brief Gets the registry of the process.
+     * @return MetricsRegistry&
+     */
+    static MetricsRegistry& global();
+
+    /**
+     * @brief Registers a counter.
+     * @param name The metric name, e.g. stms_route_queries_total.
+     * @param help The description shown with the metric.
+     * @return Counter&
+     */
+    Counter& counter(const std::string& name, const std::string& help);
+
+    /**
+     * @brief Registers a gauge.
+     * @param name The metric name.
+     * @param help The description shown with the metric.
+     * @return Gauge&
+     */
+    Gauge& gauge(const std::string& name, const std::string& help);
+
+    /**
+     * @brief Registers a histogram.
+     * @param name The metric name.
+     * @param help The description shown with the metric.
+     * @param bounds The upper bounds of the buckets, increasing (ignored if the name is registered).
+     * @return Histogram&
+     */
+    Histogram& histogram(const std::string& name, const std::string& help, const std::vector<double>& bounds);
+
+    /**
+     * @brief Renders every metric in the Prometheus text exposition format (version 0.0.4).
+     * @return std::string
+     */
+    std::string render() const;
+
+private:
+    enum Type { COUNTER, GAUGE, HISTOGRAM };
+
+    /**
+     * @struct Entry
+     * @brief A registered metric; exactly one of the pointers is set, according to type.
+     */
+    struct Entry {
+        std::string name;
+        std::string help;
+        Type type;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    mutable std::mutex mutex;                    /**< Guards entries, not the metric values */
+    std::vector<std::unique_ptr<Entry> > entries;
+    std::vector<std::unique_ptr<Entry> > conflicts;  /**< Names registered again with another type, not rendered */
+
+    Entry& add(const std::string& name, const std::string& help, Type type, bool& created);
+};
+
+#endif // METRICS_H
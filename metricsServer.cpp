@@ -0,0 +1,107 @@
+#include "metricsServer.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+MetricsServer::MetricsServer(const MetricsRegistry& registry)
+    : registry(registry), listener(-1), port(0), stopping(false) {}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(int port) {
+    stop();
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        std::cerr << "Error: Unable to create the metrics socket" << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    socklen_t length = sizeof(address);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 16) != 0 ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        std::cerr << "Error: Unable to listen on 127.0.0.1:" << port << std::endl;
+        close(listener);
+        listener = -1;
+        return false;
+    }
+    this->port = ntohs(address.sin_port);
+    stopping = false;
+    thread = std::thread(&MetricsServer::serve, this);
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (listener < 0)
+        return;
+    stopping = true;
+    thread.join();
+    close(listener);
+    listener = -1;
+    port = 0;
+}
+
+int MetricsServer::getPort() const {
+    return port;
+}
+
+void MetricsServer::serve() {
+    while (!stopping) {
+        pollfd ready = {listener, POLLIN, 0};
+        if (poll(&ready, 1, POLL_INTERVAL_MS) <= 0)
+            continue;
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0)
+            continue;
+        answer(client);
+        close(client);
+    }
+}
+
+void MetricsServer::answer(int client) {
+    // the request line is all that matters; read until the end of the headers
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        pollfd ready = {client, POLLIN, 0};
+        if (poll(&ready, 1, REQUEST_TIMEOUT_MS) <= 0)
+            return;
+        ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+        if (received <= 0)
+            break;
+        request.append(buffer, received);
+    }
+
+    std::string status, type, body;
+    if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 13, "GET /metrics?") == 0) {
+        status = "200 OK";
+        type = "text/plain; version=0.0.4; charset=utf-8";
+        body = registry.render();
+    } else {
+        status = "404 Not Found";
+        type = "text/plain; charset=utf-8";
+        body = "Not found: try /metrics\n";
+    }
+    std::string response = "HTTP/1.1 " + status + "\r\nContent-Type: " + type + "\r\nContent-Length: " +
+                           std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    std::size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t written = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0)
+            return;
+        sent += written;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef METRICS_SERVER_H
+#define METRICS_SERVER_H
+
+#include <atomic>
+#include <thread>
+#include "metrics.h"
+
+/**
+ * @class MetricsServer
+ * @brief Serves a MetricsRegistry over HTTP on the loopback interface, for Prometheus to scrape.
+ *
+ * GET /metrics returns the registry in the text exposition format; any other path gets 404. The
+ * server runs on a thread of its own and answers one request at a time, reading the metrics with
+ * atomic loads only, so a scrape never blocks the simulation. It listens on 127.0.0.1 only.
+ */
+class MetricsServer {
+public:
+    /**
+     * @brief Constructs a stopped server of a registry.
+     * @param registry The metrics to serve.
+     */
+    explicit MetricsServer(const MetricsRegistry& registry);
+
+    /**
+     * @brief Stops the server.
+     */
+    ~MetricsServer();
+
+    /**
+     * @brief Starts listening.
+     * @param port The TCP port on 127.0.0.1, or 0 for any free port (see getPort()).
+     * @return true on success, false otherwise (an error is printed).
+     */
+    bool start(int port);
+
+    /**
+     * @brief Stops listening and waits for the request being answered, if any.
+     */
+    void stop();
+
+    /**
+     * @brief Gets the port listened on.
+     * @return The port, or 0 if the server is stopped.
+     */
+    int getPort() const;
+
+private:
+    static const int POLL_INTERVAL_MS = 200;  /**< How often the server thread checks for stop() */
+    static const int REQUEST_TIMEOUT_MS = 2000;  /**< A client that sends no request in time is dropped */
+
+    const MetricsRegistry& registry;
+    int listener;              /**< Listening socket, -1 when stopped */
+    int port;
+    std::atomic<bool> stopping;
+    std::thread thread;
+
+    void serve();
+    void answer(int client);
+
+    MetricsServer(const MetricsServer&);
+    MetricsServer& operator=(const MetricsServer&);
+};
+
+#endif // METRICS_SERVER_H
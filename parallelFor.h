@@ -0,0 +1,51 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Returns the number of worker threads to use when the caller does not specify one.
+ *
+ * @return The number of hardware threads, or 1 if it cannot be determined.
+ */
+inline int defaultThreadCount() {
+    unsigned int count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : static_cast<int>(count);
+}
+
+/**
+ * @brief Splits the range [0, count) into contiguous chunks and processes them on separate threads.
+ *
+ * The calling thread processes the first chunk itself, so a thread count of 1 runs the body
+ * inline without starting any thread. The function returns once every chunk has been processed.
+ *
+ * @param count The number of items in the range.
+ * @param threadCount The number of threads to use (values below 1 use defaultThreadCount()).
+ * @param body Callable invoked as body(begin, end) for each chunk.
+ */
+template <typename Body>
+void parallelFor(int count, int threadCount, Body body) {
+    if (count <= 0)
+        return;
+    if (threadCount < 1)
+        threadCount = defaultThreadCount();
+    if (threadCount > count)
+        threadCount = count;
+
+    int chunk = (count + threadCount - 1) / threadCount;
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; t++) {
+        int begin = t * chunk;
+        int end = begin + chunk < count ? begin + chunk : count;
+        if (begin >= end)
+            break;
+        workers.push_back(std::thread(body, begin, end));
+    }
+    body(0, chunk < count ? chunk : count);
+
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+#endif // PARALLEL_FOR_H
@@ -0,0 +1,142 @@
+#include "profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+const int SUB_BUCKETS = 8;                   // buckets per power of two
+const int BUCKETS = SUB_BUCKETS * 62;        // enough for any positive long long
+
+const char* const PHASE_NAMES[PROFILE_PHASE_COUNT] = {
+    "loading", "routing", "congestion", "heap", "signals", "movement", "rendering"
+};
+
+struct PhaseCounters {
+    std::atomic<long long> count;
+    std::atomic<long long> totalNanos;
+    std::atomic<long long> maxNanos;
+    std::atomic<long long> buckets[BUCKETS];
+};
+
+// zero-initialized before any scope can be timed
+PhaseCounters counters[PROFILE_PHASE_COUNT];
+
+// values below SUB_BUCKETS have a bucket each, then each power of two is split in SUB_BUCKETS
+int bucketOf(long long nanos) {
+    if (nanos < SUB_BUCKETS)
+        return nanos < 0 ? 0 : static_cast<int>(nanos);
+    int exponent = 63 - __builtin_clzll(static_cast<unsigned long long>(nanos));
+    int sub = static_cast<int>((nanos >> (exponent - 3)) & (SUB_BUCKETS - 1));
+    return (exponent - 2) * SUB_BUCKETS + sub;
+}
+
+// middle of the values of a bucket
+long long bucketValue(int bucket) {
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+    int exponent = bucket / SUB_BUCKETS + 2;
+    long long low = static_cast<long long>(SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - 3);
+    return low + (1LL << (exponent - 3)) / 2;
+}
+
+long long percentile(const PhaseCounters& phase, long long count, long long maxNanos, double fraction) {
+    long long rank = static_cast<long long>(fraction * count + 0.999999);
+    if (rank < 1)
+        rank = 1;
+    long long seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+        seen += phase.buckets[b].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(bucketValue(b), maxNanos);
+    }
+    return maxNanos;
+}
+}
+
+bool Profiler::isEnabled() {
+#ifdef STMS_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::record(ProfilePhase phase, long long nanos) {
+    PhaseCounters& counter = counters[phase];
+    counter.count.fetch_add(1, std::memory_order_relaxed);
+    counter.totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+    counter.buckets[bucketOf(nanos)].fetch_add(1, std::memory_order_relaxed);
+    long long longest = counter.maxNanos.load(std::memory_order_relaxed);
+    while (nanos > longest && !counter.maxNanos.compare_exchange_weak(longest, nanos, std::memory_order_relaxed)) {}
+}
+
+PhaseStats Profiler::getStats(ProfilePhase phase) {
+    const PhaseCounters& counter = counters[phase];
+    PhaseStats stats;
+    stats.count = counter.count.load(std::memory_order_relaxed);
+    stats.totalNanos = counter.totalNanos.load(std::memory_order_relaxed);
+    stats.maxNanos = counter.maxNanos.load(std::memory_order_relaxed);
+    stats.p50Nanos = stats.count > 0 ? percentile(counter, stats.count, stats.maxNanos, 0.50) : 0;
+    stats.p99Nanos = stats.count > 0 ? percentile(counter, stats.count, stats.maxNanos, 0.99) : 0;
+    return stats;
+}
+
+const char* Profiler::getPhaseName(ProfilePhase phase) {
+    return phase >= 0 && phase < PROFILE_PHASE_COUNT ? PHASE_NAMES[phase] : "unknown";
+}
+
+void Profiler::reset() {
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        counters[p].count.store(0, std::memory_order_relaxed);
+        counters[p].totalNanos.store(0, std::memory_order_relaxed);
+        counters[p].maxNanos.store(0, std::memory_order_relaxed);
+        for (int b = 0; b < BUCKETS; b++)
+            counters[p].buckets[b].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::printSummary() {
+    if (!isEnabled()) {
+        std::cout << "Profiling is not compiled in: rebuild with make clean && make PROFILE=1" << std::endl;
+        return;
+    }
+    std::cout << std::left << std::setw(12) << "Phase" << std::right << std::setw(10) << "Count"
+              << std::setw(12) << "Total ms" << std::setw(12) << "Mean us" << std::setw(12) << "p50 us"
+              << std::setw(12) << "p99 us" << std::setw(12) << "Max us" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        PhaseStats stats = getStats(static_cast<ProfilePhase>(p));
+        std::cout << std::left << std::setw(12) << PHASE_NAMES[p] << std::right << std::setw(10) << stats.count
+                  << std::setw(12) << stats.totalNanos / 1e6
+                  << std::setw(12) << (stats.count > 0 ? stats.totalNanos / 1e3 / stats.count : 0.0)
+                  << std::setw(12) << stats.p50Nanos / 1e3 << std::setw(12) << stats.p99Nanos / 1e3
+                  << std::setw(12) << stats.maxNanos / 1e3 << std::endl;
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+bool Profiler::writeJson(const std::string& filename) {
+    std::ofstream file(filename.c_str());
+    if (!file) {
+        std::cerr << "Error: Unable to open file " << filename << std::endl;
+        return false;
+    }
+    file << "{\n  \"enabled\": " << (isEnabled() ? "true" : "false") << ",\n  \"phases\": [\n";
+    for (int p = 0; p < PROFILE_PHASE_COUNT; p++) {
+        PhaseStats stats = getStats(static_cast<ProfilePhase>(p));
+        file << "    {\"name\": \"" << PHASE_NAMES[p] << "\", \"count\": " << stats.count
+             << ", \"totalNs\": " << stats.totalNanos << ", \"p50Ns\": " << stats.p50Nanos
+             << ", \"p99Ns\": " << stats.p99Nanos << ", \"maxNs\": " << stats.maxNanos << "}"
+             << (p + 1 < PROFILE_PHASE_COUNT ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    file.close();
+    if (!file) {
+        std::cerr << "Error: Unable to write file " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <string>
+
+/**
+ * @brief The phases of a run that are timed when profiling is compiled in.
+ */
+enum ProfilePhase {
+    PROFILE_LOADING,      /**< Reading the road network and the vehicles */
+    PROFILE_ROUTING,      /**< Path searches */
+    PROFILE_CONGESTION,   /**< Rebuilding the congestion hash table */
+    PROFILE_HEAP,         /**< Rebuilding the congestion max heap */
+    PROFILE_SIGNALS,      /**< Adapting the signal timings to congestion */
+    PROFILE_MOVEMENT,     /**< Moving the vehicles along their roads */
+    PROFILE_RENDERING,    /**< Drawing a frame */
+    PROFILE_PHASE_COUNT
+};
+
+/**
+ * @struct PhaseStats
+ * @brief The aggregated timings of one phase.
+ */
+struct PhaseStats {
+    long long count;         /**< Number of timed scopes */
+    long long totalNanos;    /**< Sum of their durations */
+    long long p50Nanos;      /**< Median duration */
+    long long p99Nanos;      /**< 99th percentile duration */
+    long long maxNanos;      /**< Longest duration */
+};
+
+/**
+ * @class Profiler
+ * @brief Aggregates the durations of the timed scopes of each phase.
+ *
+ * The scopes are timed with PROFILE_SCOPE, which is compiled in only when STMS_PROFILE is defined
+ * (make PROFILE=1); otherwise it expands to nothing and the Profiler reports no samples. Each sample
+ * is added to per-phase atomic counters and to a log-linear histogram (8 buckets per power of two,
+ * so percentiles are within about 6% of the exact value), so any thread may record without locks.
+ * Durations are inclusive: a path search made while loading counts in both phases.
+ */
+class Profiler {
+public:
+    /**
+     * @brief Tells whether profiling was compiled in.
+     * @return true if STMS_PROFILE was defined.
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Adds a duration to a phase.
+     * @param phase The phase.
+     * @param nanos The duration in nanoseconds.
+     */
+    static void record(ProfilePhase phase, long long nanos);
+
+    /**
+     * @brief Gets the aggregated timings of a phase.
+     * @param phase The phase.
+     * @return PhaseStats
+     */
+    static PhaseStats getStats(ProfilePhase phase);
+
+    /**
+     * @brief Gets the name of a phase, as printed and in the JSON dump.
+     * @param phase The phase.
+     * @return const char*
+     */
+    static const char* getPhaseName(ProfilePhase phase);
+
+    /**
+     * @brief Discards every sample recorded so far.
+     */
+    static void reset();
+
+    /**
+     * @brief Prints a table of count, total, mean, p50, p99 and max per phase.
+     */
+    static void printSummary();
+
+    /**
+     * @brief Writes the aggregated timings as JSON.
+     * @param filename The file to write.
+     * @return true on success, false otherwise (an error is printed).
+     */
+    static bool writeJson(const std::string& filename);
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Records the time between its construction and its destruction in a phase.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(ProfilePhase phase) : phase(phase), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+        Profiler::record(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+private:
+    ProfilePhase phase;
+    std::chrono::steady_clock::time_point start;
+
+    ScopedTimer(const ScopedTimer&);
+    ScopedTimer& operator=(const ScopedTimer&);
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+// Times the rest of the enclosing scope in a phase; nothing at all unless STMS_PROFILE is defined
+#ifdef STMS_PROFILE
+#define PROFILE_SCOPE(phase) ScopedTimer PROFILE_CONCAT(profileTimer, __LINE__)(phase)
+#else
+#define PROFILE_SCOPE(phase) do {} while (0)
+#endif
+
+#endif // PROFILER_H
@@ -8,7 +8,7 @@
  * This class provides functionalities to create and manage a queue of RoadNode objects,
  * which can be used for various purposes such as managing road segments in a traffic system.
  */
-class RoadQueue{
+class RoadQueue : public MemoryTracked<MEMORY_HEAP> {
       private:
             RoadNode* head; ///< Pointer to the head of the queue
             RoadNode* tail; ///< Pointer to the tail of the queue
@@ -0,0 +1,270 @@
+#include "roadSnapshot.h"
+#include "fnv1a.h"
+#include "profiler.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+const char MAGIC[8] = {'S', 'T', 'M', 'S', 'R', 'O', 'A', 'D'};
+
+uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+template <typename T>
+bool writeArray(std::FILE* file, const T* values, uint64_t count) {
+    static const char padding[8] = {0};
+    uint64_t bytes = count * sizeof(T);
+    return (count == 0 || std::fwrite(values, sizeof(T), count, file) == count) &&
+           (align8(bytes) == bytes || std::fwrite(padding, 1, align8(bytes) - bytes, file) == align8(bytes) - bytes);
+}
+}
+
+RoadSnapshot::Layout::Layout(const Header& header) {
+    nameOffset = align8(sizeof(Header));
+    nameChars = nameOffset + align8((header.intersections + 1) * sizeof(uint64_t));
+    nameHash = nameChars + align8(header.nameBytes);
+    edgeOffset = nameHash + align8(header.hashSlots * sizeof(int32_t));
+    edgeTarget = edgeOffset + align8((header.intersections + 1) * sizeof(int32_t));
+    travelTime = edgeTarget + align8(header.edges * sizeof(int32_t));
+    edgeFlags = travelTime + align8(header.edges * sizeof(int32_t));
+    end = edgeFlags + align8(header.edges);
+}
+
+RoadSnapshot::RoadSnapshot()
+    : edgeOffset(nullptr), edgeTarget(nullptr), travelTime(nullptr), edgeFlags(nullptr), data(nullptr), length(0),
+      header(nullptr), nameOffset(nullptr), nameChars(nullptr), nameHash(nullptr) {}
+
+RoadSnapshot::~RoadSnapshot() {
+    close();
+}
+
+// FNV-1a
+bool RoadSnapshot::write(const std::string& filename, Graph& graph, const std::string& source) {
+    CompactGraph compact;
+    compact.build(graph);
+    return write(filename, compact, source);
+}
+
+bool RoadSnapshot::write(const std::string& filename, const CompactGraph& graph, const std::string& source) {
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(Header);
+    header.intersections = graph.getIntersectionCount();
+    header.edges = graph.getEdgeCount();
+    if (!source.empty()) {
+        struct stat status;
+        if (stat(source.c_str(), &status) != 0) {
+            std::cerr << "Error: Unable to open file " << source << std::endl;
+            return false;
+        }
+        header.sourceSize = status.st_size;
+        header.sourceTime = status.st_mtime;
+    }
+
+    std::vector<uint64_t> nameOffset(1, 0);
+    std::vector<char> nameChars;
+    for (std::size_t i = 0; i < graph.names.size(); i++) {
+        nameChars.insert(nameChars.end(), graph.names[i].begin(), graph.names[i].end());
+        nameOffset.push_back(nameChars.size());
+    }
+    header.nameBytes = nameChars.size();
+
+    // at most half full, so probes stay short
+    header.hashSlots = 1;
+    while (header.hashSlots < 2 * (header.intersections + 1))
+        header.hashSlots *= 2;
+    std::vector<int32_t> nameHash(header.hashSlots, -1);
+    for (std::size_t i = 0; i < graph.names.size(); i++) {
+        uint64_t slot = fnv1a(graph.names[i].data(), graph.names[i].size()) & (header.hashSlots - 1);
+        while (nameHash[slot] != -1)
+            slot = (slot + 1) & (header.hashSlots - 1);
+        nameHash[slot] = static_cast<int32_t>(i);
+    }
+    header.fileSize = Layout(header).end;
+
+    std::vector<int32_t> offsets(graph.edgeOffset.begin(), graph.edgeOffset.end());
+    if (offsets.empty())
+        offsets.push_back(0);
+    std::vector<int32_t> targets(graph.edgeTarget.begin(), graph.edgeTarget.end());
+    std::vector<int32_t> times(graph.travelTime.begin(), graph.travelTime.end());
+
+    // written next to the target and renamed, so a failed write never leaves half a snapshot
+    std::string temporary = filename + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Unable to open file " << temporary << std::endl;
+        return false;
+    }
+    bool ok = writeArray(file, &header, 1) &&
+              writeArray(file, nameOffset.data(), nameOffset.size()) &&
+              writeArray(file, nameChars.data(), nameChars.size()) &&
+              writeArray(file, nameHash.data(), nameHash.size()) &&
+              writeArray(file, offsets.data(), offsets.size()) &&
+              writeArray(file, targets.data(), targets.size()) &&
+              writeArray(file, times.data(), times.size()) &&
+              writeArray(file, graph.edgeFlags.data(), graph.edgeFlags.size());
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::cerr << "Error: Unable to write file " << filename << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool RoadSnapshot::open(const std::string& filename, bool reportMissing) {
+    close();
+    int descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (descriptor == -1) {
+        if (reportMissing || errno != ENOENT)
+            std::cerr << "Error: Unable to open file " << filename << std::endl;
+        return false;
+    }
+    struct stat status;
+    void* mapping = MAP_FAILED;
+    if (fstat(descriptor, &status) == 0 && static_cast<std::size_t>(status.st_size) >= sizeof(Header))
+        mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: " << filename << " is not a road network snapshot" << std::endl;
+        return false;
+    }
+    data = static_cast<const char*>(mapping);
+    length = status.st_size;
+    header = reinterpret_cast<const Header*>(data);
+
+    // only the header and the ends of the arrays are checked, the rest is used as it is
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->headerSize == sizeof(Header);
+    if (valid && header->version != VERSION) {
+        std::cerr << "Error: " << filename << " has snapshot format version " << header->version
+                  << ", this build reads version " << VERSION << std::endl;
+        close();
+        return false;
+    }
+    valid = valid && header->intersections < INT32_MAX && header->edges < INT32_MAX &&
+            header->hashSlots > header->intersections && (header->hashSlots & (header->hashSlots - 1)) == 0 &&
+            header->fileSize == length && Layout(*header).end == length;
+    if (valid) {
+        Layout layout(*header);
+        nameOffset = reinterpret_cast<const uint64_t*>(data + layout.nameOffset);
+        nameChars = data + layout.nameChars;
+        nameHash = reinterpret_cast<const int32_t*>(data + layout.nameHash);
+        edgeOffset = reinterpret_cast<const int32_t*>(data + layout.edgeOffset);
+        edgeTarget = reinterpret_cast<const int32_t*>(data + layout.edgeTarget);
+        travelTime = reinterpret_cast<const int32_t*>(data + layout.travelTime);
+        edgeFlags = reinterpret_cast<const uint8_t*>(data + layout.edgeFlags);
+        valid = nameOffset[0] == 0 && nameOffset[header->intersections] == header->nameBytes && edgeOffset[0] == 0 &&
+                static_cast<uint64_t>(edgeOffset[header->intersections]) == header->edges;
+    }
+    if (!valid) {
+        std::cerr << "Error: " << filename << " is not a road network snapshot or is truncated" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void RoadSnapshot::close() {
+    if (data)
+        munmap(const_cast<char*>(data), length);
+    data = nullptr;
+    length = 0;
+    header = nullptr;
+    nameOffset = nullptr;
+    nameChars = nullptr;
+    nameHash = nullptr;
+    edgeOffset = nullptr;
+    edgeTarget = nullptr;
+    travelTime = nullptr;
+    edgeFlags = nullptr;
+}
+
+bool RoadSnapshot::isOpen() const {
+    return data != nullptr;
+}
+
+bool RoadSnapshot::isCurrent(const std::string& source) const {
+    if (!data || header->sourceTime == 0)
+        return false;
+    struct stat status;
+    if (stat(source.c_str(), &status) != 0)
+        return errno == ENOENT;
+    return static_cast<uint64_t>(status.st_size) == header->sourceSize && status.st_mtime == header->sourceTime;
+}
+
+bool RoadSnapshot::copyTo(Graph& graph) const {
+    PROFILE_SCOPE(PROFILE_LOADING);
+    if (!data)
+        return false;
+    int n = getIntersectionCount();
+    for (int i = 0; i < n; i++) {
+        bool valid = edgeOffset[i] <= edgeOffset[i + 1] && nameOffset[i] <= nameOffset[i + 1];
+        for (int e = edgeOffset[i]; valid && e < edgeOffset[i + 1]; e++)
+            valid = edgeTarget[e] >= 0 && edgeTarget[e] < n;
+        if (!valid) {
+            std::cerr << "Error: the road network snapshot is damaged" << std::endl;
+            return false;
+        }
+    }
+
+    graph.clear();
+    std::vector<Vertex*> vertices(n);
+    VertexNode** link = &graph.headVertex;
+    for (int i = 0; i < n; i++) {
+        vertices[i] = new Vertex(std::string(nameChars + nameOffset[i], nameOffset[i + 1] - nameOffset[i]));
+        *link = new VertexNode(vertices[i]);
+        link = &(*link)->next;
+    }
+    for (int i = 0; i < n; i++) {
+        EdgeNode** edgeLink = &vertices[i]->edges;
+        for (int e = edgeOffset[i]; e < edgeOffset[i + 1]; e++) {
+            Edge* edge = new Edge(vertices[edgeTarget[e]], travelTime[e]);
+            edge->blocked = (edgeFlags[e] & CompactGraph::EDGE_BLOCKED) != 0;
+            edge->underRepaired = (edgeFlags[e] & CompactGraph::EDGE_UNDER_REPAIR) != 0;
+            *edgeLink = new EdgeNode(edge);
+            edgeLink = &(*edgeLink)->next;
+        }
+    }
+    // as many changes as adding every intersection and road one by one
+    graph.topologyVersion += n + getEdgeCount();
+    return true;
+}
+
+int RoadSnapshot::findIntersection(const std::string& name) const {
+    if (!data)
+        return -1;
+    uint64_t mask = header->hashSlots - 1;
+    for (uint64_t slot = fnv1a(name.data(), name.size()) & mask; nameHash[slot] != -1; slot = (slot + 1) & mask) {
+        int32_t i = nameHash[slot];
+        if (i < 0 || i >= getIntersectionCount())
+            return -1;
+        if (nameOffset[i + 1] - nameOffset[i] == name.size() &&
+            std::memcmp(nameChars + nameOffset[i], name.data(), name.size()) == 0)
+            return i;
+    }
+    return -1;
+}
+
+std::string RoadSnapshot::getName(int intersection) const {
+    if (!data || intersection < 0 || intersection >= getIntersectionCount())
+        return "";
+    return std::string(nameChars + nameOffset[intersection], nameOffset[intersection + 1] - nameOffset[intersection]);
+}
+
+int RoadSnapshot::getIntersectionCount() const {
+    return header ? static_cast<int>(header->intersections) : 0;
+}
+
+int RoadSnapshot::getEdgeCount() const {
+    return header ? static_cast<int>(header->edges) : 0;
+}
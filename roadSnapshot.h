@@ -0,0 +1,168 @@
+#ifndef ROAD_SNAPSHOT_H
+#define ROAD_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "graph.h"
+#include "compactGraph.h"
+
+/**
+ * @class RoadSnapshot
+ * @brief Binary road-network file that is used straight from a read-only memory mapping.
+ *
+ * The file holds a header (magic "STMSROAD", format version, counts, size and modification time of
+ * the CSV file it was converted from), the intersection names as a
+ * string table (one array of offsets and one of characters), an open-addressing hash table from name
+ * to intersection, the roads in CSR form (first road of each intersection, end intersection and
+ * travel time of each road) and the blocked / under-repair flags of each road, each array aligned to
+ * 8 bytes. Numbering follows CompactGraph: intersections in vertex list order, roads grouped by start
+ * intersection in adjacency list order.
+ *
+ * open() maps the file and checks the header and the array bounds, in constant time, so a network of
+ * any size is usable at once through the accessors and findIntersection(); copyTo() builds the linked
+ * Graph from it when the rest of the application needs one; isCurrent() tells whether the CSV file
+ * has changed since the conversion. Files of another format version are rejected, since the arrays
+ * are used in place.
+ */
+class RoadSnapshot {
+public:
+    static const uint32_t VERSION = 2;  /**< Format version written by this build */
+
+    /**
+     * @brief Constructs a snapshot with no file open.
+     */
+    RoadSnapshot();
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~RoadSnapshot();
+
+    /**
+     * @brief Writes the road network to a file.
+     * @param filename The file to write (replaced if it exists).
+     * @param graph The road network.
+     * @param source The CSV file the network was loaded from, recorded for isCurrent() (empty if none).
+     * @return true on success, false if the file could not be written or the source file not found.
+     */
+    static bool write(const std::string& filename, Graph& graph, const std::string& source = std::string());
+
+    /**
+     * @brief Writes an index-based copy of the road network to a file.
+     * @param filename The file to write (replaced if it exists).
+     * @param graph The road network.
+     * @param source The CSV file the network was loaded from, recorded for isCurrent() (empty if none).
+     * @return true on success, false if the file could not be written or the source file not found.
+     */
+    static bool write(const std::string& filename, const CompactGraph& graph, const std::string& source = std::string());
+
+    /**
+     * @brief Maps a snapshot file, closing any file open before.
+     * @param filename The file to read.
+     * @param reportMissing false to fail silently if the file does not exist (other errors are printed).
+     * @return true on success, false if the file is missing, truncated or of an unsupported version.
+     */
+    bool open(const std::string& filename, bool reportMissing = true);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether a file is open.
+     * @return true if a file is open, false otherwise.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Checks whether the open snapshot still matches the CSV file it was converted from.
+     *
+     * The size and modification time of the file are compared with those recorded by write(). A
+     * missing file does not make the snapshot stale, since the snapshot is then the only copy.
+     * @param source The CSV file.
+     * @return true if the file is unchanged or missing, false if it changed, the snapshot was written
+     * without a source file or no snapshot is open.
+     */
+    bool isCurrent(const std::string& source) const;
+
+    /**
+     * @brief Replaces the contents of a Graph with the road network of the snapshot.
+     *
+     * Every road is checked first, so a damaged file leaves the graph untouched.
+     * @param graph Receives the road network.
+     * @return true on success, false if no file is open or a road refers to a missing intersection.
+     */
+    bool copyTo(Graph& graph) const;
+
+    /**
+     * @brief Finds an intersection by name through the stored hash table.
+     * @param name The name of the intersection.
+     * @return The index of the intersection, or -1 if not found.
+     */
+    int findIntersection(const std::string& name) const;
+
+    /**
+     * @brief Gets the name of an intersection.
+     * @param intersection The index of the intersection.
+     * @return std::string
+     */
+    std::string getName(int intersection) const;
+
+    /**
+     * @brief Gets the number of intersections.
+     * @return int
+     */
+    int getIntersectionCount() const;
+
+    /**
+     * @brief Gets the number of roads.
+     * @return int
+     */
+    int getEdgeCount() const;
+
+    const int32_t* edgeOffset;   /**< First road of each intersection (getIntersectionCount() + 1 entries) */
+    const int32_t* edgeTarget;   /**< End intersection of each road */
+    const int32_t* travelTime;   /**< Travel time of each road */
+    const uint8_t* edgeFlags;    /**< CompactGraph::EDGE_BLOCKED / EDGE_UNDER_REPAIR flags of each road */
+
+private:
+    /**
+     * @struct Header
+     * @brief The start of a snapshot file; the arrays follow in the order of the fields below.
+     */
+    struct Header {
+        char magic[8];           /**< "STMSROAD" */
+        uint32_t version;        /**< Format version */
+        uint32_t headerSize;     /**< sizeof(Header), so a reader notices a mismatched layout */
+        uint64_t intersections;  /**< Number of intersections */
+        uint64_t edges;          /**< Number of roads */
+        uint64_t nameBytes;      /**< Length of the name characters */
+        uint64_t hashSlots;      /**< Size of the name hash table (a power of two) */
+        uint64_t fileSize;       /**< Size of the whole file */
+        uint64_t sourceSize;     /**< Size of the CSV file the network was converted from */
+        int64_t sourceTime;      /**< Modification time of that file in seconds since the epoch (0 if no source) */
+    };
+
+    /**
+     * @struct Layout
+     * @brief Byte offsets of the arrays of a file with the counts of a header.
+     */
+    struct Layout {
+        uint64_t nameOffset, nameChars, nameHash, edgeOffset, edgeTarget, travelTime, edgeFlags, end;
+        explicit Layout(const Header& header);
+    };
+
+    const char* data;
+    std::size_t length;
+    const Header* header;
+    const uint64_t* nameOffset;  /**< Name i is nameChars[nameOffset[i] .. nameOffset[i + 1]) */
+    const char* nameChars;
+    const int32_t* nameHash;     /**< Intersection of each hash slot, -1 if empty */
+
+    RoadSnapshot(const RoadSnapshot&);
+    RoadSnapshot& operator=(const RoadSnapshot&);
+};
+
+#endif // ROAD_SNAPSHOT_H
@@ -1,4 +1,6 @@
 #include "Route.h"
+#include "profiler.h"
+#include "tracer.h"
 #include "bits/stdc++.h"
 using namespace std;
 // Constructor
@@ -6,6 +8,15 @@ GPS::GPS(Graph* graph) : graph(graph) {
     for (int i = 0; i < MAX_VERTICES; ++i) {
         vertexNames[i] = "";
     }
+    MetricsRegistry& metrics = MetricsRegistry::global();
+    routeQueries = &metrics.counter("stms_route_queries_total", "Paths searched for or looked up in the path cache");
+    cacheLookups = &metrics.counter("stms_route_cache_lookups_total", "Path queries that may be answered from the path cache");
+    cacheHits = &metrics.counter("stms_route_cache_hits_total", "Path queries answered from the path cache");
+}
+
+void GPS::setPathCacheCapacity(std::size_t capacity) {
+    pathCacheCapacity = capacity;
+    pathCache.clear();
 }
 
 /**
@@ -226,6 +237,22 @@ void GPS::printAllPaths(const string& startName, const string& endName) {
 }
 
 string GPS::getPathAsString(const string& startName, const string& endName) {
+    PROFILE_SCOPE(PROFILE_ROUTING);
+    TRACE_SCOPE("route", "routing");
+    routeQueries->increment();
+    if (pathCacheVersion != graph->getTopologyVersion()) {
+        pathCache.clear();
+        pathCacheVersion = graph->getTopologyVersion();
+    }
+    string key = startName + '\n' + endName;
+    if (pathCacheCapacity > 0) {
+        cacheLookups->increment();
+        PathCache::const_iterator cached = pathCache.find(key);
+        if (cached != pathCache.end()) {
+            cacheHits->increment();
+            return string(cached->second.data(), cached->second.size());
+        }
+    }
     Vertex* start = graph->findVertex(startName);
     Vertex* end = graph->findVertex(endName);
 
@@ -254,15 +281,25 @@ string GPS::getPathAsString(const string& startName, const string& endName) {
         return ""; // Return an empty string to signify no paths found
     }
 
-    // Construct the first full path as a single concatenated string
+    // Construct the first full path as a single string, the vertex names separated by spaces
     string fullPath;
     for (int i = 0; i < MAX_VERTICES && !allPaths[0][i].empty(); ++i) {
-        fullPath += allPaths[0][i]; // Append the vertex name directly
+        if (i > 0)
+            fullPath += ' ';
+        fullPath += allPaths[0][i];
     }
 
+    if (pathCacheCapacity > 0) {
+        if (pathCache.size() >= pathCacheCapacity)
+            pathCache.clear();
+        pathCache[key] = CachedPath(fullPath.data(), fullPath.size());
+    }
     return fullPath;
 }
 string GPS::rerouteEmergencyVehicle(const string& startName, const string& endName) {
+    PROFILE_SCOPE(PROFILE_ROUTING);
+    TRACE_SCOPE("route", "routing");
+    routeQueries->increment();
     Vertex* start = graph->findVertex(startName);
     Vertex* end = graph->findVertex(endName);
 
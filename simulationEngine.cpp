@@ -0,0 +1,340 @@
+#include "simulationEngine.h"
+#include "graphPartitioner.h"
+#include "profiler.h"
+#include "tracer.h"
+#include <algorithm>
+#include <iostream>
+
+SimulationEngine::SimulationEngine(Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                                   CongestionMonitoring& ht, Accident_roads& accidentManager)
+    : cityGraph(cityGraph), vehicles(vehicles), traffic(traffic), ht(ht), accidentManager(accidentManager),
+      eventLog(nullptr), now(0), nextSequence(0), processedEvents(0), arrivedVehicles(0),
+      controlInterval(60), redTime(30), retryInterval(10), threadCount(1), tickTime(-1), tickStart(-1) {
+    MetricsRegistry& metrics = MetricsRegistry::global();
+    vehiclesInNetwork = &metrics.gauge("stms_vehicles_in_network", "Vehicles on the roads of the network");
+    congestionEvents = &metrics.gauge("stms_congestion_events", "Roads of the congestion table with more than 5 vehicles");
+    simulatedTime = &metrics.gauge("stms_simulated_seconds", "Simulated time of the last tick");
+    eventsProcessed = &metrics.counter("stms_events_processed_total", "Simulation events processed");
+    phaseChanges = &metrics.counter("stms_signal_phase_changes_total", "Traffic signal state changes");
+    const double bounds[] = {1e-5, 5e-5, 1e-4, 5e-4, 1e-3, 5e-3, 0.01, 0.05, 0.1, 0.5, 1};
+    tickLatency = &metrics.histogram("stms_tick_duration_seconds", "Wall time of the events of one simulated second",
+                                     std::vector<double>(bounds, bounds + sizeof(bounds) / sizeof(bounds[0])));
+}
+
+void SimulationEngine::setControlInterval(int seconds) {
+    controlInterval = seconds > 0 ? seconds : 0;
+}
+
+void SimulationEngine::setRedTime(int seconds) {
+    redTime = seconds > 0 ? seconds : 1;
+}
+
+void SimulationEngine::setRetryInterval(int seconds) {
+    retryInterval = seconds > 0 ? seconds : 1;
+}
+
+void SimulationEngine::setLinkCapacity(double vehiclesPerTravelSecond, int saturationFlow) {
+    links = LinkModel(vehiclesPerTravelSecond, saturationFlow);
+}
+
+void SimulationEngine::setThreadCount(int threads) {
+    threadCount = threads > 0 ? threads : 1;
+}
+
+int SimulationEngine::getThreadCount() const {
+    return threadCount;
+}
+
+void SimulationEngine::addObserver(SimulationObserver* observer) {
+    observers.push_back(observer);
+}
+
+void SimulationEngine::setEventLog(EventLog* log) {
+    eventLog = log;
+}
+
+void SimulationEngine::reset() {
+    events = std::priority_queue<SimulationEvent, std::vector<SimulationEvent>, Later>();
+    now = 0;
+    startTick();
+    nextSequence = 0;
+    processedEvents = 0;
+    arrivedVehicles = 0;
+
+    // index-based copies of the network and the vehicles; slot i is the i-th vehicle of the list
+    compact.build(cityGraph);
+    links.build(compact);
+    // one region of the network per thread
+    links.setThreadCount(threadCount);
+    if (threadCount > 1) {
+        GraphPartitioner partitioner;
+        links.setRegions(partitioner.partition(compact, threadCount), threadCount);
+    }
+    store = VehicleStore();
+    store.loadFrom(vehicles, compact);
+    vehicleOfSlot.clear();
+    for (Vehicle* vehicle = vehicles.getHead(); vehicle != nullptr; vehicle = vehicle->next)
+        vehicleOfSlot.push_back(vehicle);
+
+    // intersections without a signal never hold vehicles back
+    greenAt.assign(compact.getIntersectionCount(), 1);
+
+    for (int slot = 0; slot < store.size(); slot++) {
+        store.setCurrentEdge(slot, VehicleStore::NO_EDGE);
+        if (vehicleOfSlot[slot]->presetPath && store.nextIntersection(slot) != -1)
+            schedule(0, VEHICLE_DEPARTURE, vehicleOfSlot[slot], nullptr, slot);
+    }
+    signalNumber.clear();
+    loggedDuration.clear();
+    loggedApproach.clear();
+    for (TrafficSignal* signal = traffic.getHeadSignal(); signal != nullptr; signal = signal->next) {
+        schedule(0, SIGNAL_PHASE, nullptr, signal, compact.findIntersection(signal->intersectionId));
+        signalNumber[signal] = static_cast<int>(loggedDuration.size());
+        loggedDuration.push_back(signal->duration);
+        loggedApproach.push_back(signal->greenApproach);
+    }
+    schedule(0, LINK_UPDATE);
+    if (controlInterval > 0)
+        schedule(controlInterval, SIGNAL_CONTROL);
+    for (size_t i = 0; i < incidents.size(); i++) {
+        incidents[i].active = false;
+        schedule(incidents[i].time, INCIDENT, nullptr, nullptr, static_cast<int>(i));
+    }
+    ht.makeHashTable(links);
+}
+
+void SimulationEngine::scheduleIncident(int time, const std::string& start, const std::string& end, int duration) {
+    Incident incident;
+    incident.time = time;
+    incident.start = start;
+    incident.end = end;
+    incident.duration = duration > 0 ? duration : 0;
+    incident.active = false;
+    incidents.push_back(incident);
+    schedule(std::max(time, now), INCIDENT, nullptr, nullptr, static_cast<int>(incidents.size()) - 1);
+}
+
+void SimulationEngine::schedule(int time, SimulationEventType type, Vehicle* vehicle, TrafficSignal* signal, int index) {
+    SimulationEvent event;
+    event.time = time;
+    event.sequence = nextSequence++;
+    event.type = type;
+    event.vehicle = vehicle;
+    event.signal = signal;
+    event.index = index;
+    events.push(event);
+}
+
+bool SimulationEngine::step() {
+    if (events.empty())
+        return false;
+
+    SimulationEvent event = events.top();
+    events.pop();
+    if (tickTime != -1 && event.time != tickTime)
+        endTick();
+    tickTime = event.time;
+    now = event.time;
+
+    switch (event.type) {
+        case VEHICLE_DEPARTURE:
+            handleDeparture(event.index);
+            break;
+        case VEHICLE_ARRIVAL:
+            arrivedVehicles++;
+            break;
+        case LINK_UPDATE:
+            handleLinkUpdate();
+            break;
+        case SIGNAL_PHASE:
+            handleSignalPhase(event.signal, event.index);
+            break;
+        case SIGNAL_CONTROL: {
+            TRACE_SCOPE("signalControl", "signals");
+            ht.makeHashTable(links);
+            traffic.updateTrafficSignals(links, cityGraph);
+            congestionEvents->set(ht.numberOfCongestionEvents());
+            if (eventLog)
+                logSignalTimings();
+            schedule(now + controlInterval, SIGNAL_CONTROL);
+            break;
+        }
+        case INCIDENT:
+            handleIncident(event.index);
+            break;
+    }
+    processedEvents++;
+    eventsProcessed->increment();
+
+    for (size_t i = 0; i < observers.size(); i++)
+        observers[i]->onEvent(event);
+    return true;
+}
+
+long long SimulationEngine::run(int endTime, int stepSeconds) {
+    long long before = processedEvents;
+    startTick();
+    while (now < endTime) {
+        int boundary = stepSeconds > 0 ? std::min(now + stepSeconds, endTime) : endTime;
+        while (!events.empty() && events.top().time <= boundary)
+            step();
+        if (tickTime != -1)
+            endTick();
+        now = boundary;
+
+        if (stepSeconds > 0) {
+            bool keepRunning = true;
+            for (size_t i = 0; i < observers.size(); i++)
+                keepRunning = observers[i]->onStep(now) && keepRunning;
+            if (!keepRunning)
+                break;
+            // the observers' time is not part of the next tick
+            startTick();
+        }
+    }
+    ht.makeHashTable(links);
+    congestionEvents->set(ht.numberOfCongestionEvents());
+    return processedEvents - before;
+}
+
+void SimulationEngine::handleDeparture(int slot) {
+    int road = compact.findEdge(store.currentIntersection(slot), store.nextIntersection(slot));
+    if (road == -1)
+        return; // the road was removed from the network: the vehicle stays where it is
+
+    if ((compact.edgeFlags[road] & CompactGraph::EDGE_BLOCKED) || !links.enter(road, slot, now)) {
+        schedule(now + retryInterval, VEHICLE_DEPARTURE, vehicleOfSlot[slot], nullptr, slot);
+        return;
+    }
+    store.setCurrentEdge(slot, road);
+}
+
+void SimulationEngine::handleLinkUpdate() {
+    PROFILE_SCOPE(PROFILE_MOVEMENT);
+    TRACE_SCOPE("linkUpdate", "movement");
+    moved.clear();
+    finished.clear();
+    links.step(now, greenAt, store, moved, finished);
+    vehiclesInNetwork->set(links.getVehicleCount());
+
+    // keep the Vehicle objects at the intersection they last crossed
+    if (eventLog)
+        std::sort(moved.begin(), moved.end()); // the same log for any number of threads
+    for (size_t i = 0; i < moved.size(); i++) {
+        vehicleOfSlot[moved[i]]->moveForward();
+        if (eventLog)
+            eventLog->record(now, LOG_VEHICLE_MOVE, moved[i]);
+    }
+    for (size_t i = 0; i < finished.size(); i++) {
+        vehicleOfSlot[finished[i]]->moveForward();
+        if (eventLog)
+            eventLog->record(now, LOG_VEHICLE_MOVE, finished[i]);
+        schedule(now, VEHICLE_ARRIVAL, vehicleOfSlot[finished[i]], nullptr, finished[i]);
+    }
+    schedule(now + 1, LINK_UPDATE);
+}
+
+void SimulationEngine::handleSignalPhase(TrafficSignal* signal, int intersection) {
+    int next;
+    if (signal->isCoordinated()) {
+        signal->advanceState(now);
+        next = signal->nextChangeAt(now);
+    } else if (signal->state == "red") {
+        signal->turnGreen(now);
+        next = now + signal->transitionTime;
+    } else {
+        // temp holds the time the current state started
+        signal->advanceState(now);
+        if (signal->state == "yellow")
+            next = signal->temp + signal->transitionTime;
+        else if (signal->state == "green")
+            next = signal->temp + signal->duration;
+        else
+            next = now + redTime;
+    }
+    phaseChanges->increment();
+    if (intersection != -1)
+        greenAt[intersection] = signal->state == "green";
+    if (eventLog)
+        eventLog->record(now, LOG_SIGNAL_STATE, signalNumber[signal], signal->temp,
+                         signal->state == "green" ? 2 : signal->state == "yellow" ? 1 : 0);
+    schedule(std::max(next, now + 1), SIGNAL_PHASE, nullptr, signal, intersection);
+}
+
+void SimulationEngine::handleIncident(int index) {
+    TRACE_SCOPE("incident", "incidents");
+    Incident& incident = incidents[index];
+    int start = compact.findIntersection(incident.start);
+    int end = compact.findIntersection(incident.end);
+    if (!incident.active) {
+        accidentManager.blockRoad(incident.start, incident.end, cityGraph, false);
+        if (eventLog && start != -1 && end != -1)
+            eventLog->record(now, LOG_ROAD_BLOCKED, start, end);
+        incident.active = true;
+        if (incident.duration > 0)
+            schedule(now + incident.duration, INCIDENT, nullptr, nullptr, index);
+    } else {
+        if (accidentManager.clearRoad(incident.start, incident.end, cityGraph) && eventLog)
+            eventLog->record(now, LOG_ROAD_CLEARED, start, end);
+        incident.active = false;
+    }
+    compact.refreshFlags(cityGraph);
+}
+
+void SimulationEngine::startTick() {
+    tickTime = -1;
+    tickBegan = std::chrono::steady_clock::now();
+    tickStart = Tracer::isTracing() ? Tracer::now() : -1;
+}
+
+// Records the wall time of the events of the simulated second that just ended, and its span in the trace
+void SimulationEngine::endTick() {
+    tickLatency->observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - tickBegan).count());
+    simulatedTime->set(tickTime);
+    if (tickStart >= 0 && Tracer::isTracing())
+        Tracer::complete("tick", "simulation", tickStart, Tracer::now(), "time", tickTime);
+    startTick();
+}
+
+// Logs the signals whose green time or served approach the last control cycle changed
+void SimulationEngine::logSignalTimings() {
+    int number = 0;
+    for (TrafficSignal* signal = traffic.getHeadSignal(); signal != nullptr; signal = signal->next, number++) {
+        if (number >= static_cast<int>(loggedDuration.size()))
+            break;
+        if (signal->duration == loggedDuration[number] && signal->greenApproach == loggedApproach[number])
+            continue;
+        loggedDuration[number] = signal->duration;
+        loggedApproach[number] = signal->greenApproach;
+        unsigned char initial = signal->greenApproach.empty() ? 0 : static_cast<unsigned char>(signal->greenApproach[0]);
+        eventLog->record(now, LOG_SIGNAL_TIMING, number, signal->duration, initial);
+        eventLog->record(now, LOG_SIGNAL_APPROACH, number, compact.findIntersection(signal->greenApproach));
+    }
+}
+
+int SimulationEngine::getTime() const {
+    return now;
+}
+
+long long SimulationEngine::getProcessedEvents() const {
+    return processedEvents;
+}
+
+int SimulationEngine::getPendingEvents() const {
+    return static_cast<int>(events.size());
+}
+
+int SimulationEngine::getArrivedVehicles() const {
+    return arrivedVehicles;
+}
+
+const LinkModel& SimulationEngine::getLinkModel() const {
+    return links;
+}
+
+void SimulationEngine::printSummary() const {
+    std::cout << "Simulated time: " << now << "s" << std::endl;
+    std::cout << "Events processed: " << processedEvents << " (" << events.size() << " pending)" << std::endl;
+    std::cout << "Vehicles arrived: " << arrivedVehicles << " of " << vehicles.size()
+              << ", on the roads: " << links.getVehicleCount() << std::endl;
+}
@@ -0,0 +1,294 @@
+#ifndef SIMULATION_ENGINE_H
+#define SIMULATION_ENGINE_H
+
+#include <chrono>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "graph.h"
+#include "vehicle.h"
+#include "vehicles.h"
+#include "accidents.h"
+#include "trafficSignal.h"
+#include "trafficLightManagement.h"
+#include "congestionMonitoring.h"
+#include "compactGraph.h"
+#include "vehicleStore.h"
+#include "linkModel.h"
+#include "eventLog.h"
+#include "metrics.h"
+
+/**
+ * @enum SimulationEventType
+ * @brief The kinds of events processed by the SimulationEngine.
+ */
+enum SimulationEventType {
+    VEHICLE_DEPARTURE,  /**< A vehicle tries to enter the first road of its path */
+    VEHICLE_ARRIVAL,    /**< A vehicle has reached the end of its path */
+    LINK_UPDATE,        /**< Vehicles that may leave their road move on (once per second) */
+    SIGNAL_PHASE,       /**< A traffic signal changes state */
+    SIGNAL_CONTROL,     /**< Green times are recomputed from the congestion counts */
+    INCIDENT            /**< A road is blocked or reopened */
+};
+
+/**
+ * @struct SimulationEvent
+ * @brief An event scheduled at a simulated time.
+ */
+struct SimulationEvent {
+    int time;                  /**< Simulated time of the event in seconds */
+    long long sequence;        /**< Scheduling order, breaks ties between events at the same time */
+    SimulationEventType type;  /**< Kind of event */
+    Vehicle* vehicle;          /**< Vehicle of a VEHICLE_DEPARTURE / VEHICLE_ARRIVAL event */
+    TrafficSignal* signal;     /**< Signal of a SIGNAL_PHASE event */
+    int index;                 /**< Vehicle slot, signal intersection (-1 if not in the network) or incident of the event */
+};
+
+/**
+ * @class SimulationObserver
+ * @brief Interface for objects that follow a running simulation (e.g. the Visualizer).
+ */
+class SimulationObserver {
+public:
+    virtual ~SimulationObserver() {}
+
+    /**
+     * @brief Called after each event has been processed.
+     * @param event The processed event.
+     */
+    virtual void onEvent(const SimulationEvent&) {}
+
+    /**
+     * @brief Called each time the simulation clock reaches the end of a step (see SimulationEngine::run).
+     * @param time The simulated time in seconds.
+     * @return false to stop the simulation, true to continue.
+     */
+    virtual bool onStep(int) { return true; }
+};
+
+/**
+ * @class SimulationEngine
+ * @brief Headless discrete-event simulation of the traffic network.
+ *
+ * Events are kept in a priority queue ordered by simulated time and processed one after the other,
+ * so the simulation runs as fast as the events can be handled, without a window or a real-time clock.
+ * Vehicles with a preset path move through a LinkModel: they queue on each road for at least its
+ * travel time, cross an intersection only while its signal is green, and wait while the next road is
+ * full or blocked. The Vehicle objects are kept in step so the list always shows where each vehicle
+ * is. Signals cycle through their states (coordinated signals follow their plan), green times are
+ * recomputed periodically by TrafficLightManagement from congestion counts derived from the road
+ * queues, and incidents block roads at a given time and optionally reopen them later. The road
+ * queues may be updated by several threads (see setThreadCount()).
+ *
+ * Observers are notified of every event and, when run() is given a step, at the end of every step.
+ * With an EventLog attached, every change to the vehicles, signals and roads is recorded in it.
+ */
+class SimulationEngine {
+public:
+    /**
+     * @brief Constructs an engine over the simulation state. The engine does not own any of it.
+     */
+    SimulationEngine(Graph& cityGraph, Vehicles& vehicles, TrafficLightManagement& traffic,
+                     CongestionMonitoring& ht, Accident_roads& accidentManager);
+
+    /**
+     * @brief Sets the interval at which green times are recomputed (0 disables it). Default 60 s.
+     * @param seconds The interval in seconds.
+     */
+    void setControlInterval(int seconds);
+
+    /**
+     * @brief Sets how long an uncoordinated signal stays red before turning green again. Default 30 s.
+     * @param seconds The red time in seconds.
+     */
+    void setRedTime(int seconds);
+
+    /**
+     * @brief Sets how long a vehicle waits before trying a full or blocked first road again. Default 10 s.
+     * @param seconds The wait in seconds.
+     */
+    void setRetryInterval(int seconds);
+
+    /**
+     * @brief Sets the capacity and outflow of the roads, used from the next reset().
+     * @param vehiclesPerTravelSecond Capacity of a road per second of travel time. Default 1.
+     * @param saturationFlow Vehicles leaving a road per second of green. Default 1.
+     */
+    void setLinkCapacity(double vehiclesPerTravelSecond, int saturationFlow);
+
+    /**
+     * @brief Sets the number of threads updating the roads, used from the next reset(). Default 1.
+     *
+     * The network is split into one region per thread with a GraphPartitioner, whose roads that
+     * thread updates; signals, incidents and the other events stay on the calling thread. The
+     * simulation gives the same result for any number of threads.
+     * @param threads The number of threads.
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * @brief Gets the number of threads updating the roads.
+     * @return int
+     */
+    int getThreadCount() const;
+
+    /**
+     * @brief Adds an observer notified of the events and steps of the simulation.
+     * @param observer The observer; it must outlive the engine's use of it.
+     */
+    void addObserver(SimulationObserver* observer);
+
+    /**
+     * @brief Records every vehicle move, signal change and incident in a log (nullptr stops recording).
+     *
+     * Vehicles, signals and intersections are logged by their position in their lists at reset().
+     * @param log The log; it must outlive the engine's use of it.
+     */
+    void setEventLog(EventLog* log);
+
+    /**
+     * @brief Restarts the simulation at time 0 from the current state of the vehicles and signals.
+     *
+     * Rebuilds the road queues from the network and puts every vehicle back at its current
+     * intersection, then schedules the first departure of every vehicle with a preset path, the first
+     * phase change of every signal and the first control cycle. Incidents scheduled before are kept.
+     * Vehicles must not be added to or removed from the list until the next reset().
+     */
+    void reset();
+
+    /**
+     * @brief Schedules a road to be blocked by an incident.
+     * @param time The simulated time of the incident in seconds.
+     * @param start The start intersection of the road.
+     * @param end The end intersection of the road.
+     * @param duration How long the road stays blocked in seconds (0 keeps it blocked).
+     */
+    void scheduleIncident(int time, const std::string& start, const std::string& end, int duration = 0);
+
+    /**
+     * @brief Processes the next event.
+     * @return false if there was no event left, true otherwise.
+     */
+    bool step();
+
+    /**
+     * @brief Runs the simulation up to a simulated time.
+     *
+     * With a step greater than 0, the observers' onStep is called every step seconds of simulated time
+     * and the run stops early when one of them returns false.
+     * @param endTime The simulated time to stop at, in seconds.
+     * @param stepSeconds The interval between onStep calls (0 for none).
+     * @return The number of events processed.
+     */
+    long long run(int endTime, int stepSeconds = 0);
+
+    /**
+     * @brief Gets the current simulated time.
+     * @return int Seconds since reset().
+     */
+    int getTime() const;
+
+    /**
+     * @brief Gets the number of events processed since reset().
+     * @return long long
+     */
+    long long getProcessedEvents() const;
+
+    /**
+     * @brief Gets the number of events still scheduled.
+     * @return int
+     */
+    int getPendingEvents() const;
+
+    /**
+     * @brief Gets the number of vehicles that reached the end of their path since reset().
+     * @return int
+     */
+    int getArrivedVehicles() const;
+
+    /**
+     * @brief Gets the road queues of the simulation.
+     * @return const LinkModel&
+     */
+    const LinkModel& getLinkModel() const;
+
+    /**
+     * @brief Prints the time, event and vehicle counters of the simulation.
+     */
+    void printSummary() const;
+
+private:
+    /**
+     * @struct Incident
+     * @brief A road blocked from a given time, for a given duration.
+     */
+    struct Incident {
+        int time;           /**< Time the road is blocked */
+        std::string start;  /**< Start intersection of the road */
+        std::string end;    /**< End intersection of the road */
+        int duration;       /**< Time until the road reopens (0 for never) */
+        bool active;        /**< Whether the road is currently blocked by this incident */
+    };
+
+    /**
+     * @brief Orders events so that the priority queue pops the earliest (then first scheduled) one.
+     */
+    struct Later {
+        bool operator()(const SimulationEvent& a, const SimulationEvent& b) const {
+            return a.time != b.time ? a.time > b.time : a.sequence > b.sequence;
+        }
+    };
+
+    Graph& cityGraph;
+    Vehicles& vehicles;
+    TrafficLightManagement& traffic;
+    CongestionMonitoring& ht;
+    Accident_roads& accidentManager;
+
+    std::priority_queue<SimulationEvent, std::vector<SimulationEvent>, Later> events;  /**< Scheduled events */
+    std::vector<Incident> incidents;            /**< Every incident scheduled */
+    std::vector<SimulationObserver*> observers; /**< Observers notified of events and steps */
+    EventLog* eventLog;                         /**< Log of state changes (nullptr if none) */
+    std::unordered_map<const TrafficSignal*, int> signalNumber;  /**< Position of each signal in the signal list */
+    std::vector<int> loggedDuration;            /**< Green time of each signal as last logged */
+    std::vector<std::string> loggedApproach;    /**< Served approach of each signal as last logged */
+
+    CompactGraph compact;                 /**< Index-based copy of the network the links are built on */
+    VehicleStore store;                   /**< Paths and positions of the vehicles, by slot */
+    LinkModel links;                      /**< Road queues */
+    std::vector<Vehicle*> vehicleOfSlot;  /**< Vehicle object of each store slot */
+    std::vector<unsigned char> greenAt;   /**< For each intersection, whether vehicles may cross it */
+    std::vector<int> moved;               /**< Vehicles that changed road in the last link update */
+    std::vector<int> finished;            /**< Vehicles that completed their path in the last link update */
+
+    int now;                    /**< Current simulated time */
+    long long nextSequence;     /**< Sequence number of the next scheduled event */
+    long long processedEvents;  /**< Events processed since reset() */
+    int arrivedVehicles;        /**< Vehicles that completed their path since reset() */
+    int controlInterval;        /**< Seconds between SIGNAL_CONTROL events (0 for none) */
+    int redTime;                /**< Red time of uncoordinated signals */
+    int retryInterval;          /**< Wait before retrying a full or blocked road */
+    int threadCount;            /**< Threads updating the roads */
+    int tickTime;               /**< Simulated second of the events being timed as a tick, -1 before the first */
+    std::chrono::steady_clock::time_point tickBegan;  /**< Wall time the tick started */
+    long long tickStart;        /**< Trace clock time the tick started, -1 if not traced */
+
+    Gauge* vehiclesInNetwork;   /**< stms_vehicles_in_network */
+    Gauge* congestionEvents;    /**< stms_congestion_events */
+    Gauge* simulatedTime;       /**< stms_simulated_seconds */
+    Counter* eventsProcessed;   /**< stms_events_processed_total */
+    Counter* phaseChanges;      /**< stms_signal_phase_changes_total */
+    Histogram* tickLatency;     /**< stms_tick_duration_seconds */
+
+    void schedule(int time, SimulationEventType type, Vehicle* vehicle = nullptr, TrafficSignal* signal = nullptr, int index = -1);
+    void handleDeparture(int slot);
+    void handleLinkUpdate();
+    void handleSignalPhase(TrafficSignal* signal, int intersection);
+    void handleIncident(int incident);
+    void logSignalTimings();
+    void startTick();
+    void endTick();
+};
+
+#endif // SIMULATION_ENGINE_H
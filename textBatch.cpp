@@ -0,0 +1,55 @@
+#include "textBatch.h"
+
+TextBatch::TextBatch() : font(nullptr), characterSize(30), vertices(sf::Triangles) {}
+
+void TextBatch::setFont(const sf::Font& font, unsigned characterSize) {
+    this->font = &font;
+    this->characterSize = characterSize;
+    vertices.clear();
+}
+
+void TextBatch::clear() {
+    vertices.clear();
+}
+
+void TextBatch::append(const std::string& text, const sf::Vector2f& position, const sf::Color& color) {
+    if (!font)
+        return;
+    // the baseline of the first line is one character size below the top, as in sf::Text
+    float x = position.x;
+    float y = position.y + characterSize;
+    sf::Uint32 previous = 0;
+    for (std::size_t i = 0; i < text.size(); i++) {
+        sf::Uint32 current = static_cast<unsigned char>(text[i]);
+        x += font->getKerning(previous, current, characterSize);
+        previous = current;
+
+        const sf::Glyph& glyph = font->getGlyph(current, characterSize, false);
+        if (glyph.bounds.width > 0 && glyph.bounds.height > 0) {
+            float left = x + glyph.bounds.left;
+            float top = y + glyph.bounds.top;
+            float right = left + glyph.bounds.width;
+            float bottom = top + glyph.bounds.height;
+            float u1 = static_cast<float>(glyph.textureRect.left);
+            float v1 = static_cast<float>(glyph.textureRect.top);
+            float u2 = u1 + glyph.textureRect.width;
+            float v2 = v1 + glyph.textureRect.height;
+
+            vertices.append(sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u1, v1)));
+            vertices.append(sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1)));
+            vertices.append(sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2)));
+            vertices.append(sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2)));
+            vertices.append(sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1)));
+            vertices.append(sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2)));
+        }
+        x += glyph.advance;
+    }
+}
+
+void TextBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (!font || vertices.getVertexCount() == 0)
+        return;
+    // the atlas may have grown while glyphs were appended; existing glyphs keep their place in it
+    states.texture = &font->getTexture(characterSize);
+    target.draw(vertices, states);
+}
@@ -0,0 +1,51 @@
+#ifndef TEXT_BATCH_H
+#define TEXT_BATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+/**
+ * @class TextBatch
+ * @brief Many short texts of one font and size, drawn with a single draw call.
+ *
+ * The glyphs of every appended text are laid out as textured triangles into one vertex array that
+ * samples the font's glyph atlas (the texture SFML fills with the glyphs rendered so far), so drawing
+ * thousands of labels costs one draw call instead of one sf::Text each. Text is laid out like sf::Text
+ * at the same position and size: one line, with kerning, no styles.
+ */
+class TextBatch : public sf::Drawable {
+public:
+    /**
+     * @brief Constructs an empty batch with no font.
+     */
+    TextBatch();
+
+    /**
+     * @brief Sets the font and character size of the texts, removing the texts appended before.
+     * @param font The font; it must outlive the batch.
+     * @param characterSize The character size in pixels.
+     */
+    void setFont(const sf::Font& font, unsigned characterSize);
+
+    /**
+     * @brief Removes all texts, keeping the memory for the next ones.
+     */
+    void clear();
+
+    /**
+     * @brief Appends a text.
+     * @param text The characters (one byte each).
+     * @param position The position of the top-left corner, as given to sf::Text::setPosition.
+     * @param color The fill color.
+     */
+    void append(const std::string& text, const sf::Vector2f& position, const sf::Color& color);
+
+private:
+    const sf::Font* font;
+    unsigned characterSize;
+    sf::VertexArray vertices;  /**< Six vertices (two triangles) per visible glyph */
+
+    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+};
+
+#endif // TEXT_BATCH_H
@@ -0,0 +1,61 @@
+#include "threadTeam.h"
+#include "tracer.h"
+
+ThreadTeam::ThreadTeam(int size) : job(nullptr), generation(0), pending(0), stopping(false) {
+    for (int member = 1; member < size; member++)
+        workers.push_back(std::thread(&ThreadTeam::work, this, member));
+}
+
+ThreadTeam::~ThreadTeam() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+int ThreadTeam::size() const {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+void ThreadTeam::run(const std::function<void(int)>& job) {
+    if (workers.empty()) {
+        job(0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->job = &job;
+        pending = static_cast<int>(workers.size());
+        generation++;
+    }
+    started.notify_all();
+    job(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return pending == 0; });
+    this->job = nullptr;
+}
+
+void ThreadTeam::work(int member) {
+    Tracer::setThreadName("worker", member);
+    unsigned long seen = 0;
+    for (;;) {
+        const std::function<void(int)>* current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            started.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            current = job;
+        }
+        (*current)(member);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0)
+            done.notify_one();
+    }
+}
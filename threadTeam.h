@@ -0,0 +1,60 @@
+#ifndef THREAD_TEAM_H
+#define THREAD_TEAM_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadTeam
+ * @brief A fixed group of threads that repeatedly run the same job together.
+ *
+ * Unlike parallelFor(), which starts and joins its threads on every call, the workers of a team are
+ * started once and sleep between jobs, so a team suits work split into many short phases (e.g. one
+ * per simulation tick). The calling thread is member 0 of the team; run() returns once every member
+ * has finished, so consecutive run() calls are separated by a barrier.
+ */
+class ThreadTeam {
+public:
+    /**
+     * @brief Starts the workers of a team.
+     * @param size The number of members including the calling thread (values below 1 use 1).
+     */
+    explicit ThreadTeam(int size);
+
+    /**
+     * @brief Stops and joins the workers.
+     */
+    ~ThreadTeam();
+
+    /**
+     * @brief Gets the number of members including the calling thread.
+     * @return int
+     */
+    int size() const;
+
+    /**
+     * @brief Runs a job on every member and waits for all of them to finish.
+     * @param job Callable invoked as job(member) with member in [0, size()).
+     */
+    void run(const std::function<void(int)>& job);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable started;         /**< Signalled when a job is posted or the team stops */
+    std::condition_variable done;            /**< Signalled when the last worker finishes a job */
+    const std::function<void(int)>* job;     /**< The job being run */
+    unsigned long generation;                /**< Number of jobs posted so far */
+    int pending;                             /**< Workers still running the current job */
+    bool stopping;
+
+    void work(int member);
+
+    ThreadTeam(const ThreadTeam&);
+    ThreadTeam& operator=(const ThreadTeam&);
+};
+
+#endif // THREAD_TEAM_H
@@ -0,0 +1,41 @@
+// Writes a synthetic city in the dataset CSV formats.
+//
+// usage: ./tools/generateCity <grid|radial|geometric> <intersections> [vehicles] [seed] [directory] [closureShare]
+// Generates a connected network of the given layout and size with a signal at every intersection
+// where three or more roads meet, closes closureShare of the roads (0.01 by default) and draws
+// `vehicles` trips (as many as intersections by default). The files are written to directory
+// ("generated" by default), which must exist. The same arguments always give the same files.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "../cityGenerator.h"
+
+int main(int argc, char* argv[]) {
+    CityOptions options;
+    if (argc < 3 || !CityGenerator::parseLayout(argv[1], options.layout)) {
+        std::cerr << "usage: " << argv[0] << " <grid|radial|geometric> <intersections> [vehicles] [seed] [directory] [closureShare]" << std::endl;
+        return 1;
+    }
+    options.intersections = std::atoll(argv[2]);
+    options.vehicles = argc > 3 ? std::atoll(argv[3]) : options.intersections;
+    options.seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1;
+    std::string directory = argc > 5 ? argv[5] : "generated";
+    if (argc > 6)
+        options.closureShare = std::atof(argv[6]);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CityGenerator generator(options);
+    generator.generate();
+    double generateTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!generator.write(directory))
+        return 1;
+    double totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "intersections: " << generator.getIntersectionCount() << ", roads: " << 2 * generator.getRoadCount()
+              << ", signals: " << generator.signalAt.size() << ", closures: " << generator.closedRoad.size()
+              << ", vehicles: " << generator.tripStart.size() << std::endl;
+    std::cout << "generated in " << generateTime << " s, written to " << directory << "/ in " << totalTime - generateTime << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,35 @@
+// Converts a road network CSV file to a binary snapshot the application maps at startup.
+//
+// usage: ./tools/roadSnapshot [road_network.csv] [snapshot]
+// Reads dataset/road_network.csv and writes dataset/road_network.bin by default. While that file
+// exists, ./app loads the road network from it instead of the CSV file, as long as the CSV file
+// has the size and modification time recorded in the snapshot; rerun the tool after editing it.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../graph.h"
+#include "../roadSnapshot.h"
+
+int main(int argc, char* argv[]) {
+    std::string input = argc > 1 ? argv[1] : "dataset/road_network.csv";
+    std::string output = argc > 2 ? argv[2] : "dataset/road_network.bin";
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Graph graph;
+    graph.loadRoadData(input);
+    if (graph.headVertex == nullptr) {
+        std::cerr << "No road network found in " << input << std::endl;
+        return 1;
+    }
+    if (!RoadSnapshot::write(output, graph, input))
+        return 1;
+
+    RoadSnapshot snapshot;
+    if (!snapshot.open(output))
+        return 1;
+    std::cout << "intersections: " << snapshot.getIntersectionCount() << ", roads: " << snapshot.getEdgeCount()
+              << ", written to " << output << " in "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s" << std::endl;
+    return 0;
+}
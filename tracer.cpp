@@ -0,0 +1,218 @@
+#include "tracer.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+const std::size_t RING_SIZE = 1 << 16;   // spans buffered per thread
+const int FLUSH_INTERVAL_MS = 50;
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    long long start, duration;  // nanoseconds
+    const char* argName;
+    long long arg;
+};
+
+/**
+ * Spans of one thread: written by that thread only, read by the flush thread only.
+ */
+struct ThreadBuffer {
+    std::vector<TraceEvent> ring;
+    std::atomic<unsigned long long> head;  // spans written, stored by the thread
+    std::atomic<unsigned long long> tail;  // spans flushed, stored by the flush thread
+    int tid;
+    std::string name;
+    bool described;                        // the thread name was written to the file
+
+    ThreadBuffer() : ring(RING_SIZE), head(0), tail(0), tid(0), described(false) {}
+};
+
+struct ThreadState {
+    const char* name;
+    int index;
+    ThreadBuffer* buffer;
+};
+
+thread_local ThreadState threadState = {nullptr, -1, nullptr};
+
+// Buffers are kept for the life of the process, so a thread's pointer stays valid across traces
+std::mutex registryMutex;
+std::vector<ThreadBuffer*> registry;
+
+std::mutex flushMutex;
+std::condition_variable flushWake;  // signalled when a ring is half full or tracing stops
+bool stopping = false;
+std::thread flusher;
+std::FILE* file = nullptr;
+std::string filename;
+bool firstEvent = true;
+bool writeFailed = false;
+std::atomic<long long> dropped(0);
+std::chrono::steady_clock::time_point origin;
+
+ThreadBuffer* registerThread() {
+    ThreadBuffer* buffer = new ThreadBuffer;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->tid = static_cast<int>(registry.size()) + 1;
+    char name[64];
+    if (!threadState.name)
+        std::snprintf(name, sizeof(name), "thread %d", buffer->tid);
+    else if (threadState.index >= 0)
+        std::snprintf(name, sizeof(name), "%s %d", threadState.name, threadState.index);
+    else
+        std::snprintf(name, sizeof(name), "%s", threadState.name);
+    buffer->name = name;
+    registry.push_back(buffer);
+    return buffer;
+}
+
+void writeEvent(const char* text) {
+    if (std::fputs(firstEvent ? "\n" : ",\n", file) < 0 || std::fputs(text, file) < 0)
+        writeFailed = true;
+    firstEvent = false;
+}
+
+// Moves the buffered spans of every thread to the file; called by the flush thread, or by close()
+void flushBuffers() {
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers = registry;
+    }
+    char text[512];
+    for (std::size_t b = 0; b < buffers.size(); b++) {
+        ThreadBuffer& buffer = *buffers[b];
+        unsigned long long head = buffer.head.load(std::memory_order_acquire);
+        unsigned long long tail = buffer.tail.load(std::memory_order_relaxed);
+        if (head == tail)
+            continue;
+        if (!buffer.described) {
+            std::snprintf(text, sizeof(text),
+                          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                          buffer.tid, buffer.name.c_str());
+            writeEvent(text);
+            buffer.described = true;
+        }
+        for (; tail != head; tail++) {
+            const TraceEvent& event = buffer.ring[tail % RING_SIZE];
+            int length = std::snprintf(text, sizeof(text),
+                                       "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                                       event.name, event.category, buffer.tid, event.start / 1e3, event.duration / 1e3);
+            if (event.argName)
+                std::snprintf(text + length, sizeof(text) - length, ",\"args\":{\"%s\":%lld}}", event.argName, event.arg);
+            else
+                std::snprintf(text + length, sizeof(text) - length, "}");
+            writeEvent(text);
+        }
+        buffer.tail.store(head, std::memory_order_release);
+    }
+}
+}
+
+std::atomic<bool> Tracer::tracing(false);
+
+bool Tracer::open(const std::string& name) {
+    close();
+    file = std::fopen(name.c_str(), "w");
+    if (!file) {
+        std::cerr << "Error: Unable to open file " << name << std::endl;
+        return false;
+    }
+    filename = name;
+    firstEvent = true;
+    writeFailed = std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file) < 0;
+    dropped.store(0);
+    {
+        // spans left from an earlier trace are discarded
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (std::size_t b = 0; b < registry.size(); b++) {
+            registry[b]->tail.store(registry[b]->head.load());
+            registry[b]->described = false;
+        }
+    }
+    origin = std::chrono::steady_clock::now();
+    stopping = false;
+    flusher = std::thread(&Tracer::flushLoop);
+    tracing.store(true);
+    return true;
+}
+
+bool Tracer::close() {
+    if (!file)
+        return true;
+    tracing.store(false);
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);
+        stopping = true;
+    }
+    flushWake.notify_one();
+    flusher.join();
+    flushBuffers();
+
+    if (std::fputs("\n]}\n", file) < 0)
+        writeFailed = true;
+    if (std::fclose(file) != 0)
+        writeFailed = true;
+    file = nullptr;
+    if (dropped.load() > 0)
+        std::cout << "Warning: " << dropped.load() << " trace events were dropped" << std::endl;
+    if (writeFailed) {
+        std::cerr << "Error: Unable to write file " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Tracer::setThreadName(const char* name, int index) {
+    threadState.name = name;
+    threadState.index = index;
+}
+
+long long Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void Tracer::complete(const char* name, const char* category, long long start, long long end,
+                      const char* argName, long long arg) {
+    if (!isTracing())
+        return;
+    if (!threadState.buffer)
+        threadState.buffer = registerThread();
+    ThreadBuffer& buffer = *threadState.buffer;
+    unsigned long long head = buffer.head.load(std::memory_order_relaxed);
+    unsigned long long used = head - buffer.tail.load(std::memory_order_acquire);
+    if (used >= RING_SIZE) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    TraceEvent& event = buffer.ring[head % RING_SIZE];
+    event.name = name;
+    event.category = category;
+    event.start = start;
+    event.duration = end - start;
+    event.argName = argName;
+    event.arg = arg;
+    buffer.head.store(head + 1, std::memory_order_release);
+    if (used + 1 == RING_SIZE / 2)
+        flushWake.notify_one();
+}
+
+long long Tracer::getDroppedEvents() {
+    return dropped.load();
+}
+
+void Tracer::flushLoop() {
+    std::unique_lock<std::mutex> lock(flushMutex);
+    while (!stopping) {
+        flushWake.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS));
+        lock.unlock();
+        flushBuffers();
+        lock.lock();
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <string>
+
+/**
+ * @class Tracer
+ * @brief Records timed spans of every thread into a Chrome trace-event JSON file.
+ *
+ * The file opens in chrome://tracing or https://ui.perfetto.dev, with one track per thread (named by
+ * setThreadName()). Each thread appends its spans to a ring buffer of its own without locks; a
+ * background thread moves them to the file every 50 ms, or sooner when a ring is half
+ * full. A thread whose ring is full drops its spans rather than waiting (they are counted and
+ * reported by close()). When no trace is open, a span costs one relaxed atomic load.
+ *
+ * The tracer is process-wide. open() and close() are called between runs, while no other thread is
+ * recording spans.
+ */
+class Tracer {
+public:
+    /**
+     * @brief Starts tracing into a file, replaced if it exists.
+     * @param filename The JSON file.
+     * @return true on success, false otherwise (an error is printed).
+     */
+    static bool open(const std::string& filename);
+
+    /**
+     * @brief Stops tracing, writes the spans still buffered and closes the file.
+     * @return true if the file was written, false otherwise (an error is printed).
+     */
+    static bool close();
+
+    /**
+     * @brief Tells whether a trace is open.
+     * @return bool
+     */
+    static bool isTracing() { return tracing.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Names the calling thread's track; call before its first span.
+     * @param name The name, a string literal.
+     * @param index Appended to the name (e.g. the worker number), or -1 for none.
+     */
+    static void setThreadName(const char* name, int index = -1);
+
+    /**
+     * @brief Gets the time of the trace clock.
+     * @return Nanoseconds since open().
+     */
+    static long long now();
+
+    /**
+     * @brief Records a finished span of the calling thread.
+     * @param name The span name, a string literal.
+     * @param category The subsystem, a string literal.
+     * @param start Start time from now().
+     * @param end End time from now().
+     * @param argName Name of an integer shown with the span (a string literal), or nullptr for none.
+     * @param arg The integer.
+     */
+    static void complete(const char* name, const char* category, long long start, long long end,
+                         const char* argName = nullptr, long long arg = 0);
+
+    /**
+     * @brief Gets the number of spans dropped because a ring buffer was full, since open().
+     * @return long long
+     */
+    static long long getDroppedEvents();
+
+private:
+    static std::atomic<bool> tracing;
+
+    static void flushLoop();
+};
+
+/**
+ * @class TraceSpan
+ * @brief Records the time between its construction and its destruction as a span.
+ */
+class TraceSpan {
+public:
+    TraceSpan(const char* name, const char* category, const char* argName = nullptr, long long arg = 0)
+        : name(name), category(category), argName(argName), arg(arg),
+          start(Tracer::isTracing() ? Tracer::now() : -1) {}
+
+    ~TraceSpan() {
+        if (start >= 0)
+            Tracer::complete(name, category, start, Tracer::now(), argName, arg);
+    }
+
+private:
+    const char* name;
+    const char* category;
+    const char* argName;
+    long long arg;
+    long long start;  /**< -1 if no trace was open at construction */
+
+    TraceSpan(const TraceSpan&);
+    TraceSpan& operator=(const TraceSpan&);
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Records the rest of the enclosing scope as a span when a trace is open
+#define TRACE_SCOPE(name, category) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name, category)
+
+#endif // TRACER_H
@@ -3,7 +3,11 @@
 // # include "visualizer.h" 
 # include "trafficSignal.h"
 # include "congestionMonitoring.h"
+# include "maxPressureController.h"
+# include "greenWave.h"
+# include "graph.h"
 # include <string>
+# include <vector>
 /**
  * @class TrafficLightManagement
  * @brief Manages the traffic lights at each intersection.
@@ -16,6 +20,22 @@ const std::string SIGNALS_FILE = "dataset/traffic_signals.csv";
 class TrafficLightManagement {
       private:
             TrafficSignal* headSignal;
+            MaxPressureController controller; //< adaptive controller that computes the green times
+            std::vector<TrafficSignal*> controlledSignals; //< signal of each controller intersection (NULL if none)
+            int controllerVersion; //< graph topology version the controller was built from (-1 if never built)
+
+            friend class Checkpoint;
+
+            /**
+             * @brief Rebuilds the controller if roads or intersections were added or removed since the last build.
+             * 
+             * @param cityGraph The road network.
+             */
+            void syncController(Graph& cityGraph);
+            /**
+             * @brief Copies the green times and served approaches of the last control cycle to the signals.
+             */
+            void applyControllerTimings();
       public:
             /**
              * @brief Constructor for TrafficLightManagement class.
@@ -26,17 +46,46 @@ class TrafficLightManagement {
             /**
              * @brief Assigns a traffic signal to each intersection. 
              * 
-             * Loads the time duration for each signal from the csv file.
+             * Loads the time duration for each signal from the csv file. The optional Offset(s) and
+             * CycleLength(s) columns make the signal follow a coordinated plan.
              * 
              * 
              */
             void makeTrafficSignals();
             /**
-             * @brief Updates the traffic signals based on the congestion monitoring data.
+             * @brief Runs one max-pressure control cycle and updates the green times of the signals.
+             * 
+             * Every intersection is evaluated in parallel. The queues are read from the congestion
+             * monitoring hash table; the green time of each signal is bounded by the controller's
+             * minimum and maximum green times and the served approach is stored in the signal.
+             * Coordinated signals keep the green time of their corridor plan.
              * 
-             * @param congestionMonitoring The congestion monitoring hash table.
+             * @param ht The congestion monitoring hash table.
+             * @param cityGraph The road network, used to rebuild the controller when its topology changes.
+             * @param threadCount The number of threads to use (0 uses every hardware thread).
              */
-            void updateTrafficSignals(CongestionMonitoring& ht);
+            void updateTrafficSignals(CongestionMonitoring& ht, Graph& cityGraph, int threadCount = 0);
+            /**
+             * @brief Runs one max-pressure control cycle on the queues of a link model.
+             * 
+             * Same as the hash table version, but roads are matched by full intersection names, so
+             * networks whose intersections are not single letters are controlled too.
+             * 
+             * @param links The link model the vehicles move through.
+             * @param cityGraph The road network the link model was built from.
+             * @param threadCount The number of threads to use (0 uses every hardware thread).
+             */
+            void updateTrafficSignals(const LinkModel& links, Graph& cityGraph, int threadCount = 0);
+            /**
+             * @brief Applies a green-wave corridor plan to the signals of the corridor.
+             * 
+             * The signals take the plan's cycle length, offset and green time and from then on
+             * follow the coordinated cycle.
+             * 
+             * @param plan The corridor plan computed by the GreenWaveOptimizer.
+             * @return int The number of signals that were updated.
+             */
+            int applyCorridorPlan(const CorridorPlan& plan);
             /**
              * @brief Adds a signal to the list of traffic signals.
              * 
@@ -55,12 +104,18 @@ class TrafficLightManagement {
              * @return TrafficSignal* The signal for the given intersection.
              */
             TrafficSignal* getSignal(std::string intersection);
+            /**
+             * @brief Returns the first signal of the list; the others follow through TrafficSignal::next.
+             * 
+             * @return TrafficSignal* The first signal, or NULL if there are none.
+             */
+            TrafficSignal* getHeadSignal();
             /**
              * @brief Manages the traffic lights at each intersection
              * 
              * Call this function continuously to automatically manage the traffic lights.
              * 
-             * @param mostCongestedIntersection The intersection with the most congestion.
+             * @param mostCongestedIntersection The intersection with the most congestion (single-letter ids only).
              * @param vs The visualizer object.
              */
             void manageTrafficLights(char mostCongestedIntersection, Visualizer* vs);
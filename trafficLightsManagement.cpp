@@ -1,33 +1,51 @@
 #include "trafficLightManagement.h"
 #include "trafficSignal.h"
+#include "csvReader.h"
+#include "profiler.h"
+#include "tracer.h"
 #include <iostream>
-#include <fstream>
+#include <vector>
 TrafficLightManagement::TrafficLightManagement(){
       headSignal = NULL;
+      controllerVersion = -1;
 }
 
 void TrafficLightManagement::makeTrafficSignals(){
       // load the data from the signals file
-      std::ifstream file(SIGNALS_FILE);
-
-      if (!file.is_open()){
-            std::cerr << "Error: Unable to open file " << SIGNALS_FILE << std::endl;
+      CsvReader reader;
+      if (!reader.open(SIGNALS_FILE))
             return;
-      }
-      std::string line;
-      std::getline(file, line); // skip the header
-      while (std::getline(file, line)){
+      reader.skipRow(); // skip the header
+
+      // new signals go after the last one
+      TrafficSignal* last = headSignal;
+      while (last != NULL && last->next != NULL)
+            last = last->next;
+
+      std::vector<CsvField> fields;
+      while (reader.nextRow(fields)){
+            int duration;
+            if (fields.size() < 2 || fields[0].empty() || !fields[1].toInt(duration)){
+                  std::cerr << "Error: Invalid row in " << SIGNALS_FILE << std::endl;
+                  continue;
+            }
             TrafficSignal* signal = new TrafficSignal();
+            signal->intersectionId = fields[0].str();
+            signal->duration = duration;
+
+            // optional coordination columns: Intersection,GreenTime(s),Offset(s),CycleLength(s)
+            int offset, cycleLength;
+            if (fields.size() >= 4 && fields[2].toInt(offset) && fields[3].toInt(cycleLength)){
+                  signal->offset = offset;
+                  signal->cycleLength = cycleLength;
+            }
 
-            std::string intersection = "";
-            std::string duration = "";
-            intersection = line.substr(0, line.find(","));
-            duration = line.substr(line.find(",") + 1);
-            signal->intersectionId = intersection[0];
-            signal->duration = std::stoi(duration);
-
-
-            addSignal(signal);
+            signal->next = NULL;
+            if (last == NULL)
+                  headSignal = signal;
+            else
+                  last->next = signal;
+            last = signal;
       }
 }     
 
@@ -44,40 +62,81 @@ void TrafficLightManagement::addSignal( TrafficSignal* signal){
       temp->next = signal;
 }
 
-void TrafficLightManagement::updateTrafficSignals(CongestionMonitoring& ht){
-      for(int i = 0; i< HASH_TABLE_SIZE; i++) {
-            RoadNode* temp = &ht.hashTable[i];
-            while(temp) {
-                  // only chagnge the signal time if the car count is greater than 5
-                  if(temp->carCount > 5)
-                  if (temp->path[0] != '\0' && temp->path[1] != '\0') {
-                        string intersection = "";
-                        intersection += temp->path[0];
-                        TrafficSignal* signal = getSignal(intersection);
-                        if (signal != NULL) {
-                              signal->duration = signal->duration + temp->carCount;
-                              cout << "Intersection " << intersection << " Green Time: " << signal->duration << "s (updated)" << endl;
-                        }
-                        
-                  }
-                  temp = temp->right;
-            }
+void TrafficLightManagement::syncController(Graph& cityGraph){
+      // rebuild the controller only when roads or intersections were added or removed
+      if (controllerVersion == cityGraph.getTopologyVersion())
+            return;
+      controller.build(cityGraph);
+      controlledSignals.assign(controller.getIntersectionCount(), NULL);
+      for (int i = 0; i < controller.getIntersectionCount(); i++)
+            controlledSignals[i] = getSignal(controller.getName(i));
+      controllerVersion = cityGraph.getTopologyVersion();
+}
+
+void TrafficLightManagement::applyControllerTimings(){
+      for (int i = 0; i < controller.getIntersectionCount(); i++){
+            TrafficSignal* signal = controlledSignals[i];
+            // coordinated signals keep the green time of their corridor plan
+            if (signal == NULL || signal->isCoordinated())
+                  continue;
+            signal->duration = controller.getGreenTime(i);
+            int road = controller.getServedRoad(i);
+            signal->greenApproach = road == -1 ? "-" : controller.getName(controller.getRoadFrom(road));
       }
 }
 
+void TrafficLightManagement::updateTrafficSignals(CongestionMonitoring& ht, Graph& cityGraph, int threadCount){
+      PROFILE_SCOPE(PROFILE_SIGNALS);
+      TRACE_SCOPE("signalUpdate", "signals");
+      syncController(cityGraph);
+      controller.loadQueues(ht);
+      controller.runControlCycle(threadCount);
+      applyControllerTimings();
+}
+
+void TrafficLightManagement::updateTrafficSignals(const LinkModel& links, Graph& cityGraph, int threadCount){
+      PROFILE_SCOPE(PROFILE_SIGNALS);
+      TRACE_SCOPE("signalUpdate", "signals");
+      syncController(cityGraph);
+      controller.loadQueues(links);
+      controller.runControlCycle(threadCount);
+      applyControllerTimings();
+}
+
+
+int TrafficLightManagement::applyCorridorPlan(const CorridorPlan& plan){
+      int updated = 0;
+      for (size_t i = 0; i < plan.intersections.size(); i++){
+            TrafficSignal* signal = getSignal(plan.intersections[i]);
+            if (signal == NULL)
+                  continue;
+            signal->cycleLength = plan.cycleLength;
+            signal->offset = plan.offsets[i];
+            signal->duration = plan.greenTimes[i];
+            updated++;
+      }
+      return updated;
+}
 
 void TrafficLightManagement::printGreenTimes(){
       TrafficSignal* temp = headSignal;
       while (temp != NULL){
-            std::cout << "Intersection " << temp->intersectionId << " Green Time: " << temp->duration << "s" << std::endl;
+            std::cout << "Intersection " << temp->intersectionId << " Green Time: " << temp->duration << "s";
+            if (temp->isCoordinated())
+                  std::cout << " (Offset: " << temp->offset << "s, Cycle: " << temp->cycleLength << "s)";
+            std::cout << std::endl;
             temp = temp->next;
       }
      
 }
+TrafficSignal* TrafficLightManagement::getHeadSignal(){
+      return headSignal;
+}
+
 TrafficSignal* TrafficLightManagement::getSignal(string intersection) {
       TrafficSignal* temp = headSignal;
       while (temp) {
-            if (temp->intersectionId == intersection[0])
+            if (temp->intersectionId == intersection)
                   return temp;
             temp = temp->next;
       }
@@ -87,7 +146,7 @@ TrafficSignal* TrafficLightManagement::getSignal(string intersection) {
 void TrafficLightManagement::manageTrafficLights(char mostCongestedRoad, Visualizer* vs){
       TrafficSignal* temp = headSignal;
       while (temp) {
-            if (temp->intersectionId == mostCongestedRoad) {
+            if (temp->intersectionId.size() == 1 && temp->intersectionId[0] == mostCongestedRoad) {
                   temp->turnGreen(vs);
             }
             temp = temp->next;
@@ -6,7 +6,7 @@
 
 class Visualizer;
 
-TrafficSignal::TrafficSignal(std::string state, char intersectionId, int duration, int transitionTime) {
+TrafficSignal::TrafficSignal(std::string state, std::string intersectionId, int duration, int transitionTime) {
       // Convert the state to lowercase
       for (int i = 0; i < state.length(); i++)
             state[i] = static_cast<char>(std::tolower(state[i]));
@@ -20,6 +20,10 @@ TrafficSignal::TrafficSignal(std::string state, char intersectionId, int duratio
       duration > 0 ? this->transitionTime = transitionTime : this->transitionTime = transitionTime * -1;
 
       this->intersectionId = intersectionId;
+      this->greenApproach = "-";
+      this->cycleLength = 0;
+      this->offset = 0;
+      this->temp = 0;
 
       next = NULL;
 }
@@ -47,7 +51,7 @@ void TrafficSignal::print() {
       std::cout << "Duration: " << duration << std::endl;
 }
 
-int TrafficSignal::getIntersectionId() {
+std::string TrafficSignal::getIntersectionId() {
       return intersectionId;
 }
 
@@ -56,20 +60,28 @@ int TrafficSignal::getDuration() {
 }
 
 void TrafficSignal::advanceState(Visualizer* visualizer) {
+      advanceState(static_cast<int>(visualizer->getElapsedTimeInSeconds()));
+}
 
-      // to advance from red to yellow, call the turn green method
+void TrafficSignal::advanceState(int time) {
+
+      // coordinated signals follow their cycle instead of the turnGreen/advanceState sequence
+      if (isCoordinated()) {
+            state = stateAt(time);
+            return;
+      }
 
-      // this->temp = visualizer->getElapsedTimeInSeconds();
+      // to advance from red to yellow, call the turn green method
       if (state == "yellow") {
-            if (abs(this->temp-visualizer->getElapsedTimeInSeconds()) >= transitionTime) {
+            if (abs(this->temp - time) >= transitionTime) {
                   state = "green";
-                  this->temp = visualizer->getElapsedTimeInSeconds();
+                  this->temp = time;
             }
       }
       if (state == "green") {
-            if (abs(this->temp-visualizer->getElapsedTimeInSeconds()) >= this->duration) {
+            if (abs(this->temp - time) >= this->duration) {
                   state = "red";
-                  this->temp = visualizer->getElapsedTimeInSeconds();
+                  this->temp = time;
             }
       }
 
@@ -80,7 +92,36 @@ int TrafficSignal::getTransitionTime() {
 }
 
 void TrafficSignal::turnGreen(Visualizer* visualizer) {
+      turnGreen(static_cast<int>(visualizer->getElapsedTimeInSeconds()));
+}
+
+void TrafficSignal::turnGreen(int time) {
       state = "yellow";
-      this->temp = visualizer->getElapsedTimeInSeconds();
+      this->temp = time;
+}
+
+bool TrafficSignal::isCoordinated() {
+      return cycleLength > 0;
 }
 
+std::string TrafficSignal::stateAt(int time) {
+      if (!isCoordinated())
+            return state;
+      int phase = ((time - offset) % cycleLength + cycleLength) % cycleLength;
+      if (phase < duration)
+            return "green";
+      if (phase < duration + transitionTime)
+            return "yellow";
+      return "red";
+}
+
+int TrafficSignal::nextChangeAt(int time) {
+      if (!isCoordinated())
+            return time;
+      int phase = ((time - offset) % cycleLength + cycleLength) % cycleLength;
+      if (phase < duration)
+            return time + duration - phase;
+      if (phase < duration + transitionTime)
+            return time + duration + transitionTime - phase;
+      return time + cycleLength - phase;
+}
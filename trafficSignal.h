@@ -3,6 +3,7 @@
 #define TRAFFIC_SIGNAL_H
 // #include "visualizer.h"
 #include <string>
+#include "memoryAccounting.h"
 class Visualizer;
 /**
  * @class TrafficSignal
@@ -21,8 +22,8 @@ class Visualizer;
  * @var std::string TrafficSignal::state
  * The current state of the traffic signal ("red", "yellow", or "green").
  * 
- * @var int TrafficSignal::intersectionId
- * The ID of the intersection for which the signal is.
+ * @var std::string TrafficSignal::intersectionId
+ * The name of the intersection for which the signal is.
  * 
  * @var int TrafficSignal::duration
  * The duration for which the signal state is maintained, in seconds.
@@ -30,10 +31,10 @@ class Visualizer;
  * @var int TrafficSignal::transitionTime
  * The time the "yellow" state is maintained, in seconds.
  * 
- * @fn TrafficSignal::TrafficSignal(std::string state, int intersectionId, int duration, int transitionTime)
+ * @fn TrafficSignal::TrafficSignal(std::string state, std::string intersectionId, int duration, int transitionTime)
  * @brief Constructor to initialize the TrafficSignal object with the given state, intersectionId, and duration.
  * @param state The initial state of the signal ("red", "yellow", or "green"). Default value is "red".
- * @param intersectionId The ID of the intersection for which the signal is. Default value is -1.
+ * @param intersectionId The name of the intersection for which the signal is. Default value is "-".
  * @param duration The duration for which the signal state is maintained, in seconds. Default value is 60.
  * @param transitionTime The time the "yellow" state is maintained, in seconds. Default value is 5.
  * 
@@ -52,9 +53,9 @@ class Visualizer;
  * @fn void TrafficSignal::print()
  * @brief Print the signal state, intersectionId, and duration on the console.
  * 
- * @fn int TrafficSignal::getIntersectionId()
+ * @fn std::string TrafficSignal::getIntersectionId()
  * @brief Get the Intersection ID of the signal.
- * @return The Intersection ID as an integer.
+ * @return The name of the intersection.
  * 
  * @fn int TrafficSignal::getDuration()
  * @brief Get the duration for which the signal state is maintained.
@@ -67,29 +68,32 @@ class Visualizer;
  * @fn void TrafficSignal::advanceState()
  * @brief Advance the state of the traffic signal to the next state in the sequence "red" -> "yellow" -> "green" -> "yellow" -> "red".
  */
-class TrafficSignal {
+class TrafficSignal : public MemoryTracked<MEMORY_SIGNALS> {
       public:
             std::string state; //<  "red", "yellow", "green"
             int transitionTime; //< the time the "yellow" state is maintained
 
-            char intersectionId; //< ID of the intersection for which the signal is
+            std::string intersectionId; //< name of the intersection for which the signal is
             int duration; //< duration a state is to be maintained in seconds
             TrafficSignal* next; //< pointer to the next signal in the list
             int temp; //< temporary variable to store the duration the current state has been maintained
+            std::string greenApproach; //< upstream intersection whose road is served while green ("-" if none)
+            int cycleLength; //< length of the coordinated cycle in seconds (0 if the signal is not coordinated)
+            int offset; //< start of the green phase within the coordinated cycle, in seconds
 
 
 
             /**
              * @brief Initializes a TrafficSignal instance with the specified state ("red", "yellow", or "green"), 
              * Intersection ID, and duration. 
-             * Defaults to "red" state, -1 Intersection ID, and 60 seconds duration.
+             * Defaults to "red" state, "-" Intersection ID, and 60 seconds duration.
              * 
              * @param state string "red", "yellow" or "green". Default value is "red"
-             * @param intersectionId char ID of the intersection for which the signal is. Default value is '-'
+             * @param intersectionId name of the intersection for which the signal is. Default value is "-"
              * @param duration int duration a state is to be maintained in seconds. Default value is 60
              * @param transitionTime int the time the "yellow" state is maintained. Default value is 5
              */
-            TrafficSignal(std::string state = "red", char intersectionId = '-', int duration = 60, int transitionTime = 5);
+            TrafficSignal(std::string state = "red", std::string intersectionId = "-", int duration = 60, int transitionTime = 5);
 
             /**
              * @brief Retrieves the current state of the traffic signal
@@ -118,10 +122,10 @@ class TrafficSignal {
 
             /**
              * @brief Retrieve the ID of the intersection for which the signal is
-             * @return int Intersection ID
+             * @return std::string Intersection name
              * 
              */
-            int getIntersectionId();
+            std::string getIntersectionId();
 
             /**
              * @brief Retrieve the duration for which a signal state is maintained
@@ -142,10 +146,48 @@ class TrafficSignal {
              */
             void advanceState(Visualizer* visualizer);
 
+            /**
+             * @brief Advance the state of the traffic signal at a given simulated time
+             * 
+             * Same sequence as advanceState(Visualizer*), driven by a simulation clock instead of the window clock
+             * @param time The simulated time in seconds
+             */
+            void advanceState(int time);
+
             /**
              * @brief Turn the traffic signal from red to green
              */
             void turnGreen(Visualizer* visualizer);
+
+            /**
+             * @brief Turn the traffic signal from red to green at a given simulated time
+             * @param time The simulated time in seconds
+             */
+            void turnGreen(int time);
+
+            /**
+             * @brief Checks if the signal follows a coordinated (fixed cycle and offset) plan
+             * @return true if the signal has a cycle length, false otherwise
+             */
+            bool isCoordinated();
+
+            /**
+             * @brief Computes the state of a coordinated signal at a given time
+             * 
+             * Within each cycle the signal is green for duration seconds starting at its offset,
+             * then yellow for transitionTime seconds, then red until the next cycle.
+             * 
+             * @param time The time in seconds
+             * @return string "red", "yellow" or "green". Uncoordinated signals return their current state
+             */
+            std::string stateAt(int time);
+
+            /**
+             * @brief Computes when a coordinated signal next changes state
+             * @param time The time in seconds
+             * @return int The time of the next state change, or time if the signal is not coordinated
+             */
+            int nextChangeAt(int time);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+/**
+ * @class TripleBuffer
+ * @brief Hands the newest value from one writer thread to one reader thread without locks or waiting.
+ *
+ * Three slots rotate between the writer (the slot being filled), the reader (the slot being used)
+ * and a middle slot holding the newest published value. publish() and update() each swap their slot
+ * with the middle one through a single atomic exchange, so neither thread ever waits for the other:
+ * the writer overwrites values the reader skipped, and the reader keeps its value until a newer one
+ * is published. A slot is never used by both threads at once, so published values are read without
+ * copying and their memory (e.g. vector capacity) is reused by the writer.
+ *
+ * @tparam T The value type; default constructible.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(1), back(0), front(2) {}
+
+    /**
+     * @brief Gets the writer's slot, to be filled before publish(). It holds an older value.
+     * @return T&
+     */
+    T& writeBuffer() { return slots[back]; }
+
+    /**
+     * @brief Publishes the writer's slot as the newest value and gives the writer another slot.
+     */
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    /**
+     * @brief Takes the newest published value, if one was published since the last call.
+     * @return true if readBuffer() now holds a newer value, false if it is unchanged.
+     */
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    /**
+     * @brief Gets the reader's slot: the value taken by the last successful update().
+     * @return const T&
+     */
+    const T& readBuffer() const { return slots[front]; }
+
+private:
+    static const int INDEX = 3;  /**< Bits of the middle word holding the slot index */
+    static const int FRESH = 4;  /**< Set in the middle word when its slot has not been read yet */
+
+    T slots[3];
+    std::atomic<int> middle;  /**< Index of the middle slot, with FRESH */
+    int back;                 /**< Slot of the writer, used by the writer thread only */
+    int front;                /**< Slot of the reader, used by the reader thread only */
+
+    TripleBuffer(const TripleBuffer&);
+    TripleBuffer& operator=(const TripleBuffer&);
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -1,16 +1,37 @@
 #include <string>
 #include <iostream>
+#include <cctype>
 #include "vehicle.h"
 using namespace std;
+VehiclePriority parsePriority(const std::string& priorityLevel)
+{
+    size_t begin = 0, end = priorityLevel.size();
+    while (begin < end && isspace(static_cast<unsigned char>(priorityLevel[begin])))
+        begin++;
+    while (end > begin && isspace(static_cast<unsigned char>(priorityLevel[end - 1])))
+        end--;
+    std::string level;
+    for (size_t i = begin; i < end; i++)
+        level += static_cast<char>(tolower(static_cast<unsigned char>(priorityLevel[i])));
+
+    if (level == "high")
+        return PRIORITY_HIGH;
+    if (level == "medium")
+        return PRIORITY_MEDIUM;
+    return PRIORITY_LOW;
+}
 Vehicle::Vehicle(std::string vehicleID, std::string startIntersection, std::string endIntersection, std::string priorityLevel)
     : startIntersection(startIntersection), endIntersection(endIntersection)
 {
     this->vehicleID = vehicleID;
     this->priorityLevel = priorityLevel;
+    this->priority = parsePriority(priorityLevel);
     this->next = NULL;
-    this->path = new std::string[1000];
+    this->prev = NULL;
+    this->nextInBucket = NULL;
+    this->prevInBucket = NULL;
     this->currentIntersectionInPath = 0;
-    this->path[currentIntersectionInPath] = startIntersection;
+    this->path.push_back(startIntersection);
     this->pathLength = 1;
     this->presetPath = false;
 }
@@ -19,12 +40,14 @@ void Vehicle::moveForward(std::string nextIntersectionId){
         return;
     
     if (presetPath){
-        currentIntersectionInPath++;
+        if (currentIntersectionInPath + 1 < pathLength)
+            currentIntersectionInPath++;
         return;
     }
     currentIntersectionInPath++;
+    path.resize(currentIntersectionInPath + 1);
     path[currentIntersectionInPath] = nextIntersectionId;
-    pathLength++;
+    pathLength = currentIntersectionInPath + 1;
 }
 
 void Vehicle::printVehicle(){
@@ -37,7 +60,7 @@ void Vehicle::printVehicle(){
         std::cout << path[i] << " ";
     }
     std::cout << "Path: ";
-    for(int i = 0; i <= pathLength; i++){
+    for(int i = 0; i < pathLength; i++){
         std::cout << path[i] << " ";
     }
 
@@ -47,12 +70,23 @@ void Vehicle::printVehicle(){
 
 void Vehicle::setPath(std::string path){
     this->presetPath = true;
-    this->pathLength = 0;
-    for (int i= 0; i< path.length(); i++){
-        this->path[i] = path[i];
-        this->pathLength++;
+    this->path.clear();
+    // one intersection name per whitespace-separated word
+    std::size_t i = 0;
+    while (i < path.length()){
+        while (i < path.length() && isspace(static_cast<unsigned char>(path[i])))
+            i++;
+        std::size_t begin = i;
+        while (i < path.length() && !isspace(static_cast<unsigned char>(path[i])))
+            i++;
+        if (i > begin)
+            this->path.push_back(path.substr(begin, i - begin));
     }
-    this->pathLength = path.length();
+    if (this->path.empty())
+        this->path.push_back(startIntersection);
+    this->pathLength = this->path.size();
+    if (currentIntersectionInPath >= pathLength)
+        currentIntersectionInPath = pathLength - 1;
 }
 void Vehicle::printPath(){
     std::cout << "Path: ";
@@ -61,3 +95,9 @@ void Vehicle::printPath(){
     }
     std::cout << std::endl;
 }
+
+std::string Vehicle::nextIntersection() const{
+    if (currentIntersectionInPath + 1 < pathLength)
+        return path[currentIntersectionInPath + 1];
+    return "";
+}
@@ -2,17 +2,39 @@
 #define VEHICLE_H
 
 #include<string>
+#include<vector>
+#include "memoryAccounting.h"
+
+/**
+ * @enum VehiclePriority
+ * @brief Dispatch priority of a vehicle; lower values are served first.
+ */
+enum VehiclePriority {
+    PRIORITY_HIGH = 0,
+    PRIORITY_MEDIUM = 1,
+    PRIORITY_LOW = 2
+};
+
+const int PRIORITY_LEVELS = 3; //<Number of VehiclePriority values
+
+/**
+ * @brief Parses a priority level string such as "High", "medium" or " LOW ".
+ * @param priorityLevel The priority level (case-insensitive, surrounding whitespace ignored).
+ * @return The parsed priority; unknown levels are treated as PRIORITY_LOW.
+ */
+VehiclePriority parsePriority(const std::string& priorityLevel);
 
 /**
  * @struct Vehicle
  * @brief A structure representing a vehicle with details about its route and priority.
  */
-struct Vehicle {
+struct Vehicle : MemoryTracked<MEMORY_VEHICLES> {
     std::string vehicleID; //<The unique identifier for the vehicle
     const std::string startIntersection; //<The starting intersection for the vehicle's route never to be changed
     const std::string endIntersection; //<The ending intersection for the vehicle's route never to be changed
     std::string priorityLevel; //<The priority level of the vehicle (e.g., high, low)
-    std::string* path; //<The path the vehicle will take to reach its destination.
+    VehiclePriority priority; //<The priority level parsed once at construction
+    std::vector<std::string, TrackingAllocator<std::string, MEMORY_VEHICLES> > path; //<The path the vehicle will take to reach its destination (one intersection per entry, sized to the path).
     int currentIntersectionInPath; //< an index in the path array that represents the current intersection the vehicle is at. the next intersection is at currentIntersectionInPath + 1
     int pathLength; //<The length of the path array
     bool presetPath; //<A boolean to check if the path is preset or not    
@@ -20,6 +42,18 @@ struct Vehicle {
      * @brief Pointer to the next vehicle in a linked list.
      */
     Vehicle *next;
+    /**
+     * @brief Pointer to the previous vehicle in a linked list.
+     */
+    Vehicle *prev;
+    /**
+     * @brief Pointer to the next vehicle of the same priority, in list order (maintained by Vehicles).
+     */
+    Vehicle *nextInBucket;
+    /**
+     * @brief Pointer to the previous vehicle of the same priority, in list order (maintained by Vehicles).
+     */
+    Vehicle *prevInBucket;
 
     
     /**
@@ -34,6 +68,7 @@ struct Vehicle {
      * @brief updates the currentIntersectionId of the vehicle
      * @param nextIntersectionId  The id of the next intersection the vehicle will move to
      * if the nextIntersectionId is not provided, the vehicle will move to the next intersection in the path only if it is preset
+     * a vehicle with a preset path never moves past the last intersection of its path
      * 
      */
     void moveForward(std::string nextIntersectionId = "");
@@ -46,8 +81,8 @@ struct Vehicle {
      * @brief sets the path of the vehicle
      * 
      * @param path the path the vehicle will take
-     * @note if the initial intersection of the vehicle is "A" the path must be "ABC.."
-     * but it cannot be "BC.."
+     * @note the intersection names are separated by whitespace: if the initial intersection of the
+     * vehicle is "A" the path must be "A B C .." but it cannot be "B C .."
      * 
      * @note the path must be preset before the vehicle starts moving
      * 
@@ -58,6 +93,12 @@ struct Vehicle {
      * 
      */
     void printPath();
+    /**
+     * @brief returns the intersection after the current one in the path
+     * 
+     * @return the next intersection, or an empty string if the vehicle is at the end of its path
+     */
+    std::string nextIntersection() const;
     
 };
 
@@ -0,0 +1,198 @@
+#include "vehicleStore.h"
+#include <algorithm>
+#include <iostream>
+
+const int VehicleStore::NO_EDGE;
+const int VehicleStore::MAX_PATH_LENGTH;
+
+VehicleStore::VehicleStore() : freeHead(-1), liveCount(0), garbageEntries(0) {}
+
+void VehicleStore::reserve(int vehicles, std::size_t pathEntries) {
+    ids.reserve(vehicles);
+    currentEdge.reserve(vehicles);
+    pathOffset.reserve(vehicles);
+    pathLength.reserve(vehicles);
+    pathPosition.reserve(vehicles);
+    priority.reserve(vehicles);
+    pathArena.reserve(pathEntries);
+}
+
+int VehicleStore::spawn(int32_t id, const int32_t* path, int length, uint8_t priority) {
+    // a negative id would mark the slot as free
+    if (id < 0 || !path || length < 1 || length > MAX_PATH_LENGTH)
+        return -1;
+
+    // when the arena is full, reclaim the slices of despawned vehicles instead of growing it,
+    // as long as they make up a quarter of the arena (so compaction is not repeated every spawn)
+    if (pathArena.size() + length > pathArena.capacity() && garbageEntries * 4 >= pathArena.size() && garbageEntries > 0)
+        compactPaths();
+
+    int slot;
+    if (freeHead != -1) {
+        slot = freeHead;
+        freeHead = currentEdge[slot];
+    } else {
+        slot = static_cast<int>(ids.size());
+        ids.push_back(-1);
+        currentEdge.push_back(NO_EDGE);
+        pathOffset.push_back(0);
+        pathLength.push_back(0);
+        pathPosition.push_back(0);
+        this->priority.push_back(0);
+    }
+
+    ids[slot] = id;
+    currentEdge[slot] = NO_EDGE;
+    pathOffset[slot] = static_cast<uint32_t>(pathArena.size());
+    pathLength[slot] = static_cast<uint16_t>(length);
+    pathPosition[slot] = 0;
+    this->priority[slot] = priority;
+    pathArena.insert(pathArena.end(), path, path + length);
+    liveCount++;
+    return slot;
+}
+
+bool VehicleStore::despawn(int slot) {
+    if (!isAlive(slot))
+        return false;
+    garbageEntries += pathLength[slot];
+    ids[slot] = -1;
+    pathLength[slot] = 0;
+    currentEdge[slot] = freeHead;
+    freeHead = slot;
+    liveCount--;
+    return true;
+}
+
+bool VehicleStore::advance(int slot) {
+    if (pathPosition[slot] + 1 >= pathLength[slot])
+        return false;
+    pathPosition[slot]++;
+    currentEdge[slot] = NO_EDGE;
+    return true;
+}
+
+bool VehicleStore::isAlive(int slot) const {
+    return slot >= 0 && slot < static_cast<int>(ids.size()) && ids[slot] != -1;
+}
+
+int32_t VehicleStore::getId(int slot) const {
+    return ids[slot];
+}
+
+uint8_t VehicleStore::getPriority(int slot) const {
+    return priority[slot];
+}
+
+int VehicleStore::currentIntersection(int slot) const {
+    return pathArena[pathOffset[slot] + pathPosition[slot]];
+}
+
+int VehicleStore::nextIntersection(int slot) const {
+    if (pathPosition[slot] + 1 >= pathLength[slot])
+        return -1;
+    return pathArena[pathOffset[slot] + pathPosition[slot] + 1];
+}
+
+int VehicleStore::getPathPosition(int slot) const {
+    return pathPosition[slot];
+}
+
+int VehicleStore::getCurrentEdge(int slot) const {
+    return currentEdge[slot];
+}
+
+void VehicleStore::setCurrentEdge(int slot, int edge) {
+    currentEdge[slot] = edge;
+}
+
+const int32_t* VehicleStore::getPath(int slot, int& length) const {
+    length = pathLength[slot];
+    return pathArena.data() + pathOffset[slot];
+}
+
+int VehicleStore::size() const {
+    return liveCount;
+}
+
+int VehicleStore::slotCount() const {
+    return static_cast<int>(ids.size());
+}
+
+void VehicleStore::compactPaths() {
+    // slide the live slices to the front of the arena in offset order; a slice never moves
+    // past its old position, so the copy can be done in place and keeps the arena's capacity
+    std::vector<int> order;
+    order.reserve(liveCount);
+    for (int slot = 0; slot < slotCount(); slot++) {
+        if (ids[slot] != -1)
+            order.push_back(slot);
+    }
+    std::sort(order.begin(), order.end(), [this](int a, int b) { return pathOffset[a] < pathOffset[b]; });
+
+    uint32_t write = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        int slot = order[i];
+        std::copy(pathArena.begin() + pathOffset[slot], pathArena.begin() + pathOffset[slot] + pathLength[slot],
+                  pathArena.begin() + write);
+        pathOffset[slot] = write;
+        write += pathLength[slot];
+    }
+    pathArena.resize(write);
+    garbageEntries = 0;
+}
+
+std::size_t VehicleStore::memoryUsage() const {
+    return ids.capacity() * sizeof(int32_t) + currentEdge.capacity() * sizeof(int32_t) +
+           pathOffset.capacity() * sizeof(uint32_t) + pathLength.capacity() * sizeof(uint16_t) +
+           pathPosition.capacity() * sizeof(uint16_t) + priority.capacity() * sizeof(uint8_t) +
+           pathArena.capacity() * sizeof(int32_t);
+}
+
+int VehicleStore::loadFrom(Vehicles& vehicles, const CompactGraph& graph) {
+    if (vehicles.getHead() != nullptr && graph.getIntersectionCount() == 0) {
+        std::cerr << "Error: The road network has no intersection to place the vehicles at" << std::endl;
+        return -1;
+    }
+    int loaded = 0, unknownStarts = 0, cutPaths = 0;
+    std::vector<int32_t> path;
+    for (Vehicle* v = vehicles.getHead(); v != nullptr; v = v->next, loaded++) {
+        path.clear();
+        int entries = v->pathLength;
+        if (entries > MAX_PATH_LENGTH) {
+            entries = MAX_PATH_LENGTH;
+            cutPaths++;
+        }
+        for (int i = 0; i < entries; i++) {
+            int intersection = graph.findIntersection(v->path[i]);
+            if (intersection == -1)
+                break;
+            path.push_back(intersection);
+        }
+        if (path.empty()) {
+            int start = graph.findIntersection(v->startIntersection);
+            if (start == -1) {
+                start = 0;
+                unknownStarts++;
+            }
+            path.push_back(start);
+        }
+
+        // cannot fail: the id is not negative and the path holds 1 to MAX_PATH_LENGTH intersections
+        int slot = spawn(loaded, path.data(), static_cast<int>(path.size()), static_cast<uint8_t>(v->priority));
+
+        // the vehicle's position in the copied path
+        int position = v->currentIntersectionInPath < static_cast<int>(path.size()) ? v->currentIntersectionInPath : static_cast<int>(path.size()) - 1;
+        for (int i = 0; i < position; i++)
+            advance(slot);
+        int next = nextIntersection(slot);
+        if (next != -1)
+            setCurrentEdge(slot, graph.findEdge(currentIntersection(slot), next));
+    }
+    if (unknownStarts > 0)
+        std::cerr << "Warning: " << unknownStarts << " vehicles start at intersections that are not in the road network; "
+                  << "they are parked at intersection 0 and never move" << std::endl;
+    if (cutPaths > 0)
+        std::cerr << "Warning: " << cutPaths << " paths were cut to " << MAX_PATH_LENGTH << " intersections" << std::endl;
+    return loaded;
+}
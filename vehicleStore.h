@@ -0,0 +1,184 @@
+#ifndef VEHICLE_STORE_H
+#define VEHICLE_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "compactGraph.h"
+#include "vehicles.h"
+
+/**
+ * @class VehicleStore
+ * @brief Structure-of-arrays storage for large vehicle populations.
+ *
+ * Each vehicle occupies a slot; every attribute lives in its own array indexed by slot, so a pass
+ * over one attribute (e.g. the current road of every vehicle) touches contiguous memory only.
+ * Paths are stored as intersection indices of a CompactGraph in one shared arena; each vehicle
+ * owns a slice [pathOffset, pathOffset + pathLength). Despawned slots go on a free list and are
+ * reused by the next spawn; their path slices are reclaimed by compacting the arena in place when it
+ * is full and at least a quarter of it is garbage.
+ *
+ * A vehicle costs 17 bytes plus 4 bytes per intersection of its path, i.e. under 100 bytes for
+ * paths of up to 20 intersections.
+ */
+class VehicleStore {
+public:
+    static const int NO_EDGE = -1;  /**< Current edge of a vehicle that is not on a road */
+    static const int MAX_PATH_LENGTH = 65535;  /**< Most intersections a path can hold */
+
+    /**
+     * @brief Constructs an empty store.
+     */
+    VehicleStore();
+
+    /**
+     * @brief Reserves memory for a number of vehicles and path entries.
+     * @param vehicles The number of vehicles.
+     * @param pathEntries The total number of path intersections.
+     */
+    void reserve(int vehicles, std::size_t pathEntries);
+
+    /**
+     * @brief Adds a vehicle to the store, reusing a free slot when possible.
+     * @param id The external id of the vehicle (not negative).
+     * @param path The intersections of the path, as CompactGraph indices.
+     * @param length The number of intersections in the path (at least 1, at most MAX_PATH_LENGTH).
+     * @param priority The priority of the vehicle (a VehiclePriority value).
+     * @return The slot of the vehicle, or -1 if the id or the path is invalid.
+     */
+    int spawn(int32_t id, const int32_t* path, int length, uint8_t priority = PRIORITY_LOW);
+
+    /**
+     * @brief Removes a vehicle and puts its slot on the free list.
+     * @param slot The slot of the vehicle.
+     * @return true if a live vehicle was removed, false otherwise.
+     */
+    bool despawn(int slot);
+
+    /**
+     * @brief Moves a vehicle to the next intersection of its path.
+     *
+     * The current edge is reset to NO_EDGE; the caller sets the road the vehicle enters next.
+     * @param slot The slot of the vehicle.
+     * @return true if the vehicle moved, false if it already was at the end of its path.
+     */
+    bool advance(int slot);
+
+    /**
+     * @brief Checks if a slot holds a live vehicle.
+     * @param slot The slot to check.
+     * @return bool
+     */
+    bool isAlive(int slot) const;
+
+    /**
+     * @brief Gets the external id of a vehicle.
+     * @param slot The slot of the vehicle.
+     * @return int32_t
+     */
+    int32_t getId(int slot) const;
+
+    /**
+     * @brief Gets the priority of a vehicle.
+     * @param slot The slot of the vehicle.
+     * @return uint8_t A VehiclePriority value
+     */
+    uint8_t getPriority(int slot) const;
+
+    /**
+     * @brief Gets the intersection a vehicle is at (or has last passed).
+     * @param slot The slot of the vehicle.
+     * @return int The CompactGraph index of the intersection.
+     */
+    int currentIntersection(int slot) const;
+
+    /**
+     * @brief Gets the intersection after the current one on a vehicle's path.
+     * @param slot The slot of the vehicle.
+     * @return int The CompactGraph index of the intersection, or -1 at the end of the path.
+     */
+    int nextIntersection(int slot) const;
+
+    /**
+     * @brief Gets the index of the current intersection in a vehicle's path.
+     * @param slot The slot of the vehicle.
+     * @return int
+     */
+    int getPathPosition(int slot) const;
+
+    /**
+     * @brief Gets the road a vehicle is on.
+     * @param slot The slot of the vehicle.
+     * @return int The CompactGraph index of the road, or NO_EDGE.
+     */
+    int getCurrentEdge(int slot) const;
+
+    /**
+     * @brief Sets the road a vehicle is on.
+     * @param slot The slot of the vehicle.
+     * @param edge The CompactGraph index of the road, or NO_EDGE.
+     */
+    void setCurrentEdge(int slot, int edge);
+
+    /**
+     * @brief Gets the path of a vehicle.
+     * @param slot The slot of the vehicle.
+     * @param length Receives the number of intersections in the path.
+     * @return const int32_t* Pointer to the first intersection of the path in the arena.
+     */
+    const int32_t* getPath(int slot, int& length) const;
+
+    /**
+     * @brief Gets the number of live vehicles.
+     * @return int
+     */
+    int size() const;
+
+    /**
+     * @brief Gets the number of slots (live and free).
+     * @return int
+     */
+    int slotCount() const;
+
+    /**
+     * @brief Moves every live path to the front of the arena, dropping the slices of despawned vehicles.
+     */
+    void compactPaths();
+
+    /**
+     * @brief Gets the memory used by the store's arrays (allocated capacity).
+     * @return std::size_t Bytes.
+     */
+    std::size_t memoryUsage() const;
+
+    /**
+     * @brief Copies every vehicle of a Vehicles list into the store.
+     *
+     * Vehicles get their position in the list as id, and the i-th vehicle gets slot i. The current
+     * road of every vehicle is set from the graph; intersections unknown to the graph end the copied
+     * path and paths longer than MAX_PATH_LENGTH are cut. A vehicle whose start intersection is not
+     * in the graph is parked at intersection 0 without a next intersection, so it never moves; a
+     * warning gives the number of such vehicles and of cut paths.
+     * @param vehicles The vehicles to copy.
+     * @param graph The compact road network used to translate intersection names.
+     * @return The number of vehicles copied, or -1 if the graph has no intersection while there are vehicles.
+     */
+    int loadFrom(Vehicles& vehicles, const CompactGraph& graph);
+
+private:
+    std::vector<int32_t> ids;            /**< External id of each slot (-1 for free slots) */
+    std::vector<int32_t> currentEdge;    /**< Road of each vehicle; next free slot for free slots */
+    std::vector<uint32_t> pathOffset;    /**< Start of each vehicle's path in the arena */
+    std::vector<uint16_t> pathLength;    /**< Number of intersections in each vehicle's path */
+    std::vector<uint16_t> pathPosition;  /**< Index of the current intersection in the path */
+    std::vector<uint8_t> priority;       /**< VehiclePriority of each vehicle */
+    std::vector<int32_t> pathArena;      /**< Intersections of every path, one slice per vehicle */
+
+    int freeHead;                        /**< First free slot (-1 if none) */
+    int liveCount;                       /**< Number of live vehicles */
+    std::size_t garbageEntries;          /**< Arena entries owned by despawned vehicles */
+
+    friend class Checkpoint;
+};
+
+#endif // VEHICLE_STORE_H
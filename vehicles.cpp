@@ -1,17 +1,28 @@
 #include <iostream>
-#include<fstream>
-#include <sstream>
 #include "vehicles.h"  // Include the correct header file
 #include"graph.h"
+#include "csvReader.h"
+#include "parallelFor.h"
+#include "profiler.h"
+#include <vector>
 
 // Constructor initializes an empty list
 Vehicles::Vehicles() {
     head = nullptr;
+    tail = nullptr;
+    for (int i = 0; i < PRIORITY_LEVELS; i++) {
+        bucketHead[i] = nullptr;
+        bucketTail[i] = nullptr;
+    }
    
 }
 
 // Destructor cleans up the list by deleting all vehicles
 Vehicles::~Vehicles() {
+    clear();
+}
+
+void Vehicles::clear() {
     Vehicle* current = head;
     while (current != nullptr) {
         Vehicle* next = current->next;
@@ -19,115 +30,194 @@ Vehicles::~Vehicles() {
         current = next;
     }
     head = nullptr;
+    tail = nullptr;
+    for (int i = 0; i < PRIORITY_LEVELS; i++) {
+        bucketHead[i] = nullptr;
+        bucketTail[i] = nullptr;
+    }
+    index.clear();
+}
+
+// Creates a vehicle, rejecting IDs that are already in the list
+Vehicle* Vehicles::createVehicle(std::string VehicleID, std::string startIntersection, std::string endIntersection, std::string priorityLevel) {
+    if (index.count(VehicleID)) {
+        std::cerr << "Vehicle " << VehicleID << " already exists!" << std::endl;
+        return nullptr;
+    }
+    return new Vehicle(VehicleID, startIntersection, endIntersection, priorityLevel);
+}
+
+// Links a vehicle after another one (or at the head) and adds it to the index
+void Vehicles::linkAfter(Vehicle* previous, Vehicle* vehicle) {
+    vehicle->prev = previous;
+    vehicle->next = previous ? previous->next : head;
+    if (vehicle->next)
+        vehicle->next->prev = vehicle;
+    else
+        tail = vehicle;
+    if (previous)
+        previous->next = vehicle;
+    else
+        head = vehicle;
+    index[vehicle->vehicleID] = vehicle;
+
+    // the bucket keeps list order: the vehicle follows the closest earlier vehicle of its priority,
+    // which is known without a search at both ends of the list and for an empty bucket
+    int bucket = vehicle->priority;
+    Vehicle* before = nullptr;
+    if (vehicle->next == nullptr) {
+        before = bucketTail[bucket];
+    } else if (previous != nullptr && bucketTail[bucket] != nullptr) {
+        before = previous;
+        while (before != nullptr && before->priority != vehicle->priority)
+            before = before->prev;
+    }
+    vehicle->prevInBucket = before;
+    vehicle->nextInBucket = before ? before->nextInBucket : bucketHead[bucket];
+    if (vehicle->nextInBucket)
+        vehicle->nextInBucket->prevInBucket = vehicle;
+    else
+        bucketTail[bucket] = vehicle;
+    if (before)
+        before->nextInBucket = vehicle;
+    else
+        bucketHead[bucket] = vehicle;
+}
+
+// Unlinks a vehicle, removing it from its priority bucket and the index
+void Vehicles::unlink(Vehicle* vehicle) {
+    int bucket = vehicle->priority;
+    if (vehicle->prevInBucket)
+        vehicle->prevInBucket->nextInBucket = vehicle->nextInBucket;
+    else
+        bucketHead[bucket] = vehicle->nextInBucket;
+    if (vehicle->nextInBucket)
+        vehicle->nextInBucket->prevInBucket = vehicle->prevInBucket;
+    else
+        bucketTail[bucket] = vehicle->prevInBucket;
+    vehicle->nextInBucket = nullptr;
+    vehicle->prevInBucket = nullptr;
+
+    if (vehicle->prev)
+        vehicle->prev->next = vehicle->next;
+    else
+        head = vehicle->next;
+    if (vehicle->next)
+        vehicle->next->prev = vehicle->prev;
+    else
+        tail = vehicle->prev;
+    vehicle->next = nullptr;
+    vehicle->prev = nullptr;
+    index.erase(vehicle->vehicleID);
+}
+
+// Unlinks a vehicle and frees it
+void Vehicles::unlinkAndDelete(Vehicle* vehicle) {
+    unlink(vehicle);
+    delete vehicle;
 }
 
 // Inserts a new vehicle at the beginning of the list
 void Vehicles::insertAtHead(std::string VehicleID, std::string startIntersection, std::string endIntersection, std::string priorityLevel) {
-    Vehicle* newVehicle = new Vehicle(VehicleID, startIntersection, endIntersection, priorityLevel);
-    if (isEmpty()) {
-        head = newVehicle;
-    } else {
-        newVehicle->next = head;
-        head = newVehicle;
-    }
+    Vehicle* newVehicle = createVehicle(VehicleID, startIntersection, endIntersection, priorityLevel);
+    if (newVehicle)
+        linkAfter(nullptr, newVehicle);
 }
 
 void Vehicles::enqueue(std::string VehicleID, std::string startIntersection, std::string endIntersection, std::string priorityLevel) {
     // Create the new Vehicle object
-    Vehicle* newVehicle = new Vehicle(VehicleID, startIntersection, endIntersection, priorityLevel);
+    Vehicle* newVehicle = createVehicle(VehicleID, startIntersection, endIntersection, priorityLevel);
+    if (!newVehicle)
+        return;
 
-    if (isEmpty()) {
-        head = newVehicle;  // If list is empty, just add the new vehicle as the head
-    } else if (priorityLevel == "High") {
-        // If priority is High, insert at the head of the list
-        insertAtHead(VehicleID, startIntersection, endIntersection, priorityLevel);
-    } else if (priorityLevel == "Medium") {
-        // If priority is Medium, insert after the head (just after high-priority vehicles)
-        Vehicle* current = head;
-        while (current->next != nullptr && current->next->priorityLevel == "Medium") {
-            current = current->next;
-        }
-        newVehicle->next = current->next;  // Set the next of the new vehicle to the current vehicle's next
-        current->next = newVehicle;        // Insert the new vehicle after the current vehicle
-    } else {
-        // If priority is Low, insert at the end of the list
-        Vehicle* current = head;
-        while (current->next != nullptr) {
-            current = current->next;
-        }
-        current->next = newVehicle;  // Insert the vehicle at the end
+    // Insert after the last vehicle of the same priority, or of the closest higher priority;
+    // if there is none, the vehicle goes to the head of the list
+    Vehicle* previous = nullptr;
+    for (int bucket = newVehicle->priority; bucket >= 0 && previous == nullptr; bucket--) {
+        previous = bucketTail[bucket];
     }
+    linkAfter(previous, newVehicle);
 }
 
 
 // Insert after a specific position in the list
 bool Vehicles::insertAfterPosition(int position, std::string VehicleID, std::string startIntersection, std::string endIntersection, std::string priorityLevel) {
     if (position < 0) return false;
-    Vehicle* newVehicle = new Vehicle(VehicleID, startIntersection, endIntersection, priorityLevel);
-    if (position == 0) {
-        insertAtHead(VehicleID, startIntersection, endIntersection, priorityLevel);
-        return true;
-    }
     Vehicle* current = head;
     int index = 0;
     while (current != nullptr && index < position) {
         current = current->next;
         index++;
     }
+    if (position == 0) {
+        insertAtHead(VehicleID, startIntersection, endIntersection, priorityLevel);
+        return findVehicle(VehicleID) == head;
+    }
     if (current == nullptr) return false;
 
-    newVehicle->next = current->next;
-    current->next = newVehicle;
+    Vehicle* newVehicle = createVehicle(VehicleID, startIntersection, endIntersection, priorityLevel);
+    if (!newVehicle) return false;
+    linkAfter(current, newVehicle);
     return true;
 }
 
 // Insert after a specific vehicle ID
 bool Vehicles::insertAfterID(std::string ID, std::string VehicleID, std::string startIntersection, std::string endIntersection, std::string priorityLevel) {
-    int position = findIDInVehicles(ID);
-    if (position == -1) return false;
-    return insertAfterPosition(position, VehicleID, startIntersection, endIntersection, priorityLevel);
+    Vehicle* current = findVehicle(ID);
+    if (current == nullptr) return false;
+    Vehicle* newVehicle = createVehicle(VehicleID, startIntersection, endIntersection, priorityLevel);
+    if (!newVehicle) return false;
+    linkAfter(current, newVehicle);
+    return true;
 }
 
 // Delete the first vehicle in the list
 void Vehicles::deleteAtStart() {
     if (!isEmpty()) {
-        Vehicle* temp = head;
-        head = head->next;
-        delete temp;
+        unlinkAndDelete(head);
     }
 }
 
+// Removes the vehicle at the head of the queue without deleting it
+Vehicle* Vehicles::dequeue() {
+    if (isEmpty()) return nullptr;
+    Vehicle* vehicle = head;
+    unlink(vehicle);
+    return vehicle;
+}
+
+// Removes the oldest vehicle of a priority without deleting it
+Vehicle* Vehicles::dequeue(VehiclePriority priority) {
+    Vehicle* vehicle = bucketHead[priority];
+    if (vehicle != nullptr)
+        unlink(vehicle);
+    return vehicle;
+}
+
 // Delete the last vehicle in the list
 bool Vehicles::deleteAtEnd() {
     if (isEmpty()) return false;
-    if (head->next == nullptr) {
-        deleteAtStart();
-        return true;
-    }
-    Vehicle* secondLast = head;
-    while (secondLast->next && secondLast->next->next != nullptr) {
-        secondLast = secondLast->next;
-    }
-    delete secondLast->next;
-    secondLast->next = nullptr;
+    unlinkAndDelete(tail);
     return true;
 }
 
-// Delete a vehicle by its ID
-bool Vehicles::deleteAtID(std::string ID) {
-    if (head == nullptr) return false;
-    if (head->vehicleID == ID) {
-        deleteAtStart();
-        return true;
-    }
+// Delete the vehicle at a specific index
+bool Vehicles::deleteAtIndex(int position) {
+    if (position < 0) return false;
     Vehicle* current = head;
-    while (current->next != nullptr && current->next->vehicleID != ID) {
+    for (int i = 0; current != nullptr && i < position; i++) {
         current = current->next;
     }
-    if (current->next == nullptr) return false;
-    Vehicle* temp = current->next;
-    current->next = current->next->next;
-    delete temp;
+    if (current == nullptr) return false;
+    unlinkAndDelete(current);
+    return true;
+}
+
+// Delete a vehicle by its ID
+bool Vehicles::deleteAtID(std::string ID) {
+    Vehicle* vehicle = findVehicle(ID);
+    if (vehicle == nullptr) return false;
+    unlinkAndDelete(vehicle);
     return true;
 }
 
@@ -147,54 +237,78 @@ void Vehicles::printVehicles() {
 
 // Finds a vehicle in the list by its ID
 int Vehicles::findIDInVehicles(std::string vehicleID) {
-    Vehicle* current = head;
-    int index = 0;
-    while (current != nullptr) {
-        if (current->vehicleID == vehicleID) return index;
-        current = current->next;
-        index++;
+    Vehicle* vehicle = findVehicle(vehicleID);
+    if (vehicle == nullptr) return -1;
+    int position = 0;
+    for (Vehicle* current = head; current != vehicle; current = current->next) {
+        position++;
     }
-    return -1;
+    return position;
+}
+
+// Finds a vehicle through the hash index
+Vehicle* Vehicles::findVehicle(const std::string& vehicleID) {
+    VehicleIndex::iterator found = index.find(vehicleID);
+    return found == index.end() ? nullptr : found->second;
+}
+
+// Returns the oldest vehicle of a priority
+Vehicle* Vehicles::peek(VehiclePriority priority) {
+    return bucketHead[priority];
+}
+
+// Returns the number of vehicles in the list
+int Vehicles::size() {
+    return static_cast<int>(index.size());
 }
 
 // Loads vehicle data from CSV files
 void Vehicles::loadAndReadCSVs() {
-    std::ifstream vehiclesFile("dataset/vehicles.csv");
-    std::ifstream emergencyVehiclesFile("dataset/emergency_vehicles.csv");
+    PROFILE_SCOPE(PROFILE_LOADING);
+    loadVehicleFile("dataset/vehicles.csv", false);
+    loadVehicleFile("dataset/emergency_vehicles.csv", true);
+}
 
-    std::string line, vehicleID, startIntersection, endIntersection, priorityLevel;
+void Vehicles::loadVehicleFile(const std::string& filename, bool emergency) {
+    CsvReader reader;
+    if (!reader.open(filename))
+        return;
+    reader.skipRow(); // header
 
-   
-    if (vehiclesFile.is_open()) {
-        getline(vehiclesFile, line); // Skip the header
-        while (getline(vehiclesFile, line)) {
-            std::stringstream ss(line);
-            getline(ss, vehicleID, ',');
-            getline(ss, startIntersection, ',');
-            getline(ss, endIntersection, ',');
-            
-            
-            enqueue(vehicleID, startIntersection, endIntersection, "low");
+    // the vehicles are built on several threads for large files, then linked in file order
+    std::vector<CsvChunk> chunks = reader.split();
+    std::vector<std::vector<Vehicle*> > parsed(chunks.size());
+    parallelFor(static_cast<int>(chunks.size()), static_cast<int>(chunks.size()), [&](int begin, int end) {
+        std::vector<CsvField> fields;
+        for (int c = begin; c < end; c++) {
+            while (chunks[c].nextRow(fields)) {
+                CsvField priorityLevel = emergency && fields.size() > 3 ? fields[3] : CsvField("low", 3);
+                parsed[c].push_back(new Vehicle(fields[0].str(), fields.size() > 1 ? fields[1].str() : std::string(),
+                                                fields.size() > 2 ? fields[2].str() : std::string(), priorityLevel.str()));
+            }
         }
-        vehiclesFile.close();
-    }
+    });
 
-  
-    if (emergencyVehiclesFile.is_open()) {
-        getline(emergencyVehiclesFile, line); // Skip the header
-        while (getline(emergencyVehiclesFile, line)) {
-            std::stringstream ss(line);
-            getline(ss, vehicleID, ',');
-            getline(ss, startIntersection, ',');
-            getline(ss, endIntersection, ',');
-            getline(ss, priorityLevel, ',');
-            
-          
-            if (findIDInVehicles(vehicleID) == -1) {
-                enqueue(vehicleID, startIntersection, endIntersection, priorityLevel);
+    size_t rows = 0;
+    for (size_t c = 0; c < parsed.size(); c++)
+        rows += parsed[c].size();
+    index.reserve(index.size() + rows);
+    for (size_t c = 0; c < parsed.size(); c++) {
+        for (size_t v = 0; v < parsed[c].size(); v++) {
+            Vehicle* vehicle = parsed[c][v];
+            // emergency vehicles already listed as regular ones are skipped silently
+            if (index.count(vehicle->vehicleID)) {
+                if (!emergency)
+                    std::cerr << "Vehicle " << vehicle->vehicleID << " already exists!" << std::endl;
+                delete vehicle;
+                continue;
             }
+            // as enqueue(): after the last vehicle of the same or the closest higher priority
+            Vehicle* previous = nullptr;
+            for (int bucket = vehicle->priority; bucket >= 0 && previous == nullptr; bucket--)
+                previous = bucketTail[bucket];
+            linkAfter(previous, vehicle);
         }
-        emergencyVehiclesFile.close();
     }
 }
 
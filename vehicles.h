@@ -3,6 +3,7 @@
 
 #include <string> // Ensure string header is included
 #include<limits>
+#include<unordered_map>
 #include "vehicle.h"
 #include "Route.h"
 
@@ -11,10 +12,63 @@
 /**
  * @class Vehicles
  * @brief A class to manage a linked list of vehicles.
+ *
+ * The list is doubly linked and keeps a pointer to its tail. An ID -> vehicle hash index is kept
+ * in sync by every insert and delete method, so lookups, insertions after an ID and deletions by
+ * ID take constant time. Vehicle IDs are unique: inserting an ID that already exists is rejected.
+ *
+ * enqueue() keeps the list ordered as a dispatch queue: all High vehicles, then Medium, then Low,
+ * each priority in arrival (FIFO) order. Every vehicle is also linked into the bucket of its
+ * priority (Vehicle::nextInBucket / prevInBucket), which keeps the list order of the vehicles of
+ * that priority, so enqueue(), dequeue() and unlinking take constant time. The positional insert
+ * methods place a vehicle exactly where asked and may break the priority order; they look back
+ * through the list for the closest vehicle of the same priority to place it in its bucket.
+ * dequeue() always serves the list head and dequeue(priority) the first vehicle of that priority.
  */
 class Vehicles {
 private:
+    typedef std::unordered_map<std::string, Vehicle*, std::hash<std::string>, std::equal_to<std::string>,
+                               TrackingAllocator<std::pair<const std::string, Vehicle*>, MEMORY_VEHICLES> > VehicleIndex;
+
     Vehicle* head; // Pointer to the head of the linked list
+    Vehicle* tail; // Pointer to the last vehicle of the linked list
+    VehicleIndex index; // Vehicle ID -> vehicle in the list
+    Vehicle* bucketHead[PRIORITY_LEVELS]; // First vehicle of each priority bucket (nullptr if empty)
+    Vehicle* bucketTail[PRIORITY_LEVELS]; // Last vehicle of each priority bucket (nullptr if empty)
+
+    /**
+     * @brief Creates a vehicle unless its ID is already in the list.
+     * @return The new vehicle, or nullptr if the ID already exists.
+     */
+    Vehicle* createVehicle(std::string VehicleID, std::string startIntersection, std::string endIntersection, std::string priorityLevel);
+
+    /**
+     * @brief Links a vehicle into the list after another one and into its priority bucket, and indexes it.
+     * @param previous The vehicle to insert after, or nullptr to insert at the head.
+     * @param vehicle The vehicle to insert.
+     */
+    void linkAfter(Vehicle* previous, Vehicle* vehicle);
+
+    /**
+     * @brief Unlinks a vehicle from the list and its priority bucket and removes it from the index.
+     * @param vehicle The vehicle to remove.
+     */
+    void unlink(Vehicle* vehicle);
+
+    /**
+     * @brief Unlinks a vehicle (see unlink()) and deletes it.
+     * @param vehicle The vehicle to remove.
+     */
+    void unlinkAndDelete(Vehicle* vehicle);
+
+    /**
+     * @brief Enqueues every vehicle of a CSV file whose ID is not in the list yet.
+     * @param filename The file (VehicleID,StartIntersection,EndIntersection[,PriorityLevel]).
+     * @param emergency true to read the priority column; the vehicles of other files are Low.
+     */
+    void loadVehicleFile(const std::string& filename, bool emergency);
+
+    friend class Checkpoint;
 
 public:
 /**
@@ -27,6 +81,11 @@ Vehicles();
  */
 ~Vehicles();
 
+/**
+ * @brief Deletes every vehicle in the linked list.
+ */
+void clear();
+
 /**
  * @brief Inserts a vehicle at the head of the linked list.
  * @param VehicleID The ID of the vehicle.
@@ -37,7 +96,10 @@ Vehicles();
 void insertAtHead(std::string VehicleID, std::string startIntersection, std::string endIntersection, std::string priorityLevel);
 
 /**
- * @brief Enqueues a vehicle at the end of the linked list.
+ * @brief Enqueues a vehicle at the end of its priority bucket in constant time.
+ *
+ * The priority level is parsed case-insensitively ("low", "Low" and "LOW" are the same);
+ * unknown levels are enqueued as Low.
  * @param VehicleID The ID of the vehicle.
  * @param startIntersection The starting intersection of the vehicle.
  * @param endIntersection The ending intersection of the vehicle.
@@ -72,6 +134,19 @@ bool insertAfterID(std::string ID, std::string VehicleID, std::string startInter
  */
 void deleteAtStart();
 
+/**
+ * @brief Removes the vehicle at the head of the queue (the oldest vehicle of the highest priority).
+ * @return The removed vehicle, now owned by the caller, or nullptr if the list is empty.
+ */
+Vehicle* dequeue();
+
+/**
+ * @brief Removes the oldest vehicle of one priority.
+ * @param priority The priority bucket to serve.
+ * @return The removed vehicle, now owned by the caller, or nullptr if the bucket is empty.
+ */
+Vehicle* dequeue(VehiclePriority priority);
+
 /**
  * @brief Deletes the vehicle at the end of the linked list.
  * @return True if the deletion was successful, false otherwise.
@@ -107,11 +182,35 @@ void printVehicles();
  * @brief Finds the position of a vehicle with a specific ID in the linked list.
  * @param vehicleID The ID of the vehicle to be found.
  * @return The position of the vehicle in the linked list, or -1 if not found.
+ * @note Unknown IDs are answered from the hash index; known IDs walk the list to count the position.
  */
 int findIDInVehicles(std::string vehicleID);
 
+/**
+ * @brief Finds a vehicle by its ID using the hash index.
+ * @param vehicleID The ID of the vehicle to be found.
+ * @return A pointer to the vehicle, or nullptr if not found.
+ */
+Vehicle* findVehicle(const std::string& vehicleID);
+
+/**
+ * @brief Gets the number of vehicles in the linked list.
+ * @return The number of vehicles.
+ */
+int size();
+
+/**
+ * @brief Gets the oldest vehicle of one priority without removing it.
+ * @param priority The priority bucket.
+ * @return The vehicle, or nullptr if the bucket is empty.
+ */
+Vehicle* peek(VehiclePriority priority);
+
 /**
  * @brief Loads and reads vehicle data from CSV files.
+ *
+ * Reads dataset/vehicles.csv and then dataset/emergency_vehicles.csv through a memory mapping;
+ * large files are parsed on several threads.
  */
 void loadAndReadCSVs();
 
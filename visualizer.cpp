@@ -1,207 +1,377 @@
 #include "visualizer.h"
+#include "compactGraph.h"
+#include "graphLayout.h"
+#include "parallelFor.h"
+#include "profiler.h"
+#include "tracer.h"
 #include <SFML/Graphics.hpp>
 #include <cmath>
+#include <climits>
+#include <thread>
+
+const float Visualizer::MIN_LABEL_PIXELS = 8.0f;
+const int Visualizer::MAX_SPEED = 1 << 16;
+const char* const Visualizer::COORDINATES_FILE = "dataset/intersections.csv";
+const char* const Visualizer::LAYOUT_CACHE = "dataset/layouts";
+const unsigned char Visualizer::EDGE_OPEN;
+const unsigned char Visualizer::EDGE_GREEN;
+const unsigned char Visualizer::EDGE_BLOCKED;
+const unsigned char Visualizer::EDGE_HEAT;
+const int Visualizer::HEAT_BUCKETS;
 
 // Constructor for the Visualizer class
-Visualizer::Visualizer() {
-    // Empty constructor
+Visualizer::Visualizer() : resourcesLoaded(false), secondsPerFrame(1), engine(nullptr), graph(nullptr), vehicles(nullptr), traffic(nullptr), ht(nullptr), accidentManager(nullptr),
+      layoutVersion(-1), paceTime(0), pacedSpeed(0), running(false), speed(5), heatmap(false), exportTexture(nullptr), encoder(nullptr), edgeLines(sf::Lines), vehicleTextStale(true) {
 }
 
 // Function to draw the simulation
 void Visualizer::drawSimulation(Graph &graph, Vehicles &vehicles, TrafficLightManagement &traffic, CongestionMonitoring &ht, Accident_roads &accidentManager) {
-    // Create a window for the simulation
-    sf::RenderWindow window(sf::VideoMode(800, 800), "Graph Visualization");
-
-    // Main loop to keep the window open
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window.close();
-        }
-
-        // Clear the window with black color
-        window.clear(sf::Color::Black);
-
-        // Initialize variables for drawing vertices
-        VertexNode* currentVertexNode = graph.headVertex;
-        std::map<std::string, sf::Vector2f> positions;
-        sf::Vector2f center(400, 400); // Center of the window
-        float radius = 350.0f; // Radius for circular layout
-        int numVertices = 0;
-
-        // Count the number of vertices in the graph
-        currentVertexNode = graph.headVertex;
-        while (currentVertexNode) {
-            numVertices++;
-            currentVertexNode = currentVertexNode->next;
-        }
+    SimulationEngine engine(graph, vehicles, traffic, ht, accidentManager);
+    engine.reset();
+    drawSimulation(engine, graph, vehicles, traffic, ht, accidentManager);
+}
 
-        // Load the font for vertex labels
-        sf::Font font;
-        if (!font.loadFromFile("sprites/font.ttf")) {
-            std::cout << "Couldn't load font\n";
-        }
+// Function to draw a simulation driven by an existing engine
+void Visualizer::drawSimulation(SimulationEngine &engine, Graph &graph, Vehicles &vehicles, TrafficLightManagement &traffic, CongestionMonitoring &ht, Accident_roads &accidentManager) {
+    this->engine = &engine;
+    this->graph = &graph;
+    this->vehicles = &vehicles;
+    this->traffic = &traffic;
+    this->ht = &ht;
+    this->accidentManager = &accidentManager;
+
+    // Create a window for the simulation, redrawn at the display rate
+    window.create(sf::VideoMode(800, 800), "Graph Visualization");
+    window.setVerticalSyncEnabled(true);
+    view = window.getDefaultView();
+    loadResources();
+
+    // The first frame is published before the simulation thread starts, which then publishes the others
+    publishFrame(engine.getTime());
+    pacedSpeed = 0;
+    running = true;
+    engine.addObserver(this);
+    std::thread simulation([this, &engine]() {
+        Tracer::setThreadName("simulation");
+        // The engine calls onStep after every secondsPerFrame simulated seconds until the window is closed
+        engine.run(INT_MAX, secondsPerFrame);
+    });
 
-        // Calculate the angle between each vertex for circular layout
-        float angleIncrement = 2 * M_PI / numVertices;
-        float currentAngle = 0.0f;
-
-        // Draw vertices in a circular pattern
-        currentVertexNode = graph.headVertex;
-        while (currentVertexNode) {
-            Vertex* vertex = currentVertexNode->vertex;
-
-            // Calculate the position of the vertex
-            float x = center.x + radius * cos(currentAngle);
-            float y = center.y + radius * sin(currentAngle);
-
-            // Store the position for later use
-            positions[vertex->name] = sf::Vector2f(x + 20, y + 20);
-
-            // Increment the angle for the next vertex
-            currentAngle += angleIncrement;
-
-            // Draw the vertex label
-            sf::Text label;
-            label.setFont(font);
-            label.setString(vertex->name);
-            label.setCharacterSize(47);
-            label.setFillColor(sf::Color::White);
-            label.setPosition(x, y - 7);
-            window.draw(label);
-
-            // Draw the green time for the traffic light
-            int greenTime = traffic.getSignal(vertex->name)->getDuration();
-            std::string greenTimeStr = std::to_string(greenTime);
-            label.setString(greenTimeStr);
-            label.setPosition(x - 20, y - 20);
-            drawVehicles(vehicles, vertex->name, positions[vertex->name], window);
-
-            currentVertexNode = currentVertexNode->next;
-        }
+    while (window.isOpen()) {
+        handleEvents();
+        bool fresh = frames.update();
+        window.setView(view);
+        drawFrame(window, frames.readBuffer(), fresh);
+        window.display();
+    }
+    running = false;
+    simulation.join();
+}
 
-        // Draw edges as lines
-        currentVertexNode = graph.headVertex;
-        while (currentVertexNode) {
-            Vertex* vertex = currentVertexNode->vertex;
-            EdgeNode* currentEdgeNode = vertex->edges;
+// Function to render a simulation offscreen into image files or a raw video stream
+bool Visualizer::exportSimulation(SimulationEngine &engine, Graph &graph, Vehicles &vehicles, TrafficLightManagement &traffic, CongestionMonitoring &ht, Accident_roads &accidentManager,
+                                  const std::string &output, int endTime, int interval, unsigned width, unsigned height, int threads) {
+    this->engine = &engine;
+    this->graph = &graph;
+    this->vehicles = &vehicles;
+    this->traffic = &traffic;
+    this->ht = &ht;
+    this->accidentManager = &accidentManager;
+
+    sf::RenderTexture texture;
+    if (!texture.create(width, height)) {
+        std::cerr << "Error: Unable to create a " << width << "x" << height << " render texture" << std::endl;
+        return false;
+    }
+    FrameEncoder frameEncoder;
+    if (!frameEncoder.open(output, threads))
+        return false;
+    loadResources();
+    exportTexture = &texture;
+    encoder = &frameEncoder;
+
+    // A frame of the starting state, then one at the end of every step; the simulation never waits for a window
+    publishFrame(engine.getTime());
+    exportFrame();
+    engine.addObserver(this);
+    engine.run(endTime, interval > 0 ? interval : 1);
+
+    exportTexture = nullptr;
+    encoder = nullptr;
+    bool ok = frameEncoder.close();
+    std::cout << "Frames exported to " << output << ": " << frameEncoder.getFrameCount() << std::endl;
+    return ok;
+}
 
-            while (currentEdgeNode) {
-                Edge* edge = currentEdgeNode->edge;
+// Function to publish a frame after each simulation step
+bool Visualizer::onStep(int time) {
+    if (encoder) {
+        publishFrame(time);
+        exportFrame();
+        return true;
+    }
+    if (!running)
+        return false;
+    publishFrame(time);
+    pace(time);
+    return running;
+}
 
-                // Only draw the edge if it exists as a directed path
-                std::string start = vertex->name;
-                std::string end = edge->destination->name;
+// Function to render the newest frame offscreen and queue it for encoding
+void Visualizer::exportFrame() {
+    bool fresh = frames.update();
+    const FrameSnapshot &frame = frames.readBuffer();
+    // The whole network, whatever the size of the frames
+    if (frame.layout)
+        exportTexture->setView(sf::View(frame.layout->bounds));
+    drawFrame(*exportTexture, frame, fresh);
+    exportTexture->display();
+    encoder->submit(exportTexture->getTexture().copyToImage());
+}
 
-                if (graph.getEdgeWeight(start, end) != -1) {
-                    // Get the color for the edge
-                    sf::Color color = choseColor(currentEdgeNode, vertex, traffic, ht, accidentManager);
+// Function to handle the window events
+void Visualizer::handleEvents() {
+    sf::Event event;
+    while (window.pollEvent(event)) {
+        if (event.type == sf::Event::Closed) {
+            window.close();
+        } else if (event.type == sf::Event::MouseWheelScrolled) {
+            zoom(event.mouseWheelScroll.delta, event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+        } else if (event.type == sf::Event::KeyPressed) {
+            int current = speed;
+            if ((event.key.code == sf::Keyboard::Add || event.key.code == sf::Keyboard::Equal) && current < MAX_SPEED)
+                speed = current * 2;
+            else if ((event.key.code == sf::Keyboard::Subtract || event.key.code == sf::Keyboard::Hyphen) && current > 1)
+                speed = current / 2;
+            else if (event.key.code == sf::Keyboard::H)
+                heatmap = !heatmap;
+        }
+    }
+}
 
-                    // Create the vertex array with the correct color
-                    sf::Vertex line[] = {
-                        sf::Vertex(positions[start], color),
-                        sf::Vertex(positions[end], color)
-                    };
+// Function to keep the simulation to the chosen speed
+void Visualizer::pace(int time) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    int current = speed;
+    if (current != pacedSpeed) {
+        pacedSpeed = current;
+        paceStart = now;
+        paceTime = time;
+        return;
+    }
+    std::chrono::steady_clock::time_point target =
+        paceStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(double(time - paceTime) / current));
+    if (target > now) {
+        std::this_thread::sleep_until(target);
+    } else if (now - target > std::chrono::seconds(1)) {
+        // Too slow for this speed: go on from here instead of catching up later
+        paceStart = now;
+        paceTime = time;
+    }
+}
 
-                    // Draw the edge
-                    window.draw(line, 2, sf::Lines);
-                }
+// Function to load the fonts and textures once
+void Visualizer::loadResources() {
+    if (resourcesLoaded)
+        return;
+    resourcesLoaded = true;
+    if (!labelFont.loadFromFile("sprites/font.ttf") || !weightFont.loadFromFile("sprites/font3.ttf")) {
+        std::cerr << "Couldn't load font\n";
+    }
+    if (!roadTexture.loadFromFile("sprites/road.png") || !vehicleTexture.loadFromFile("sprites/redCar.png")) {
+        std::cerr << "Couldn't load texture\n";
+    }
+    roadSprite.setTexture(roadTexture);
+    vehicleSprite.setTexture(vehicleTexture);
+}
 
-                currentEdgeNode = currentEdgeNode->next;
-            }
+// Function to rebuild the layout after the graph topology has changed
+void Visualizer::updateLayout() {
+    if (layoutVersion == graph->getTopologyVersion())
+        return;
+    layoutVersion = graph->getTopologyVersion();
+    std::shared_ptr<FrameLayout> next = std::make_shared<FrameLayout>();
+
+    layoutVertices.clear();
+    for (VertexNode* node = graph->headVertex; node; node = node->next)
+        layoutVertices.push_back(node->vertex);
+    int numVertices = layoutVertices.size();
+
+    // Place the vertices at their coordinates if the dataset has them, else by a force-directed layout
+    // (cached per network, so a large network is laid out once), scaled into the window
+    CompactGraph compact;
+    compact.build(*graph);
+    GraphLayout placement;
+    placement.setThreadCount(defaultThreadCount());
+    placement.setCacheDirectory(LAYOUT_CACHE);
+    placement.compute(compact, COORDINATES_FILE);
+    placement.fit(50, 50, 700, 700);
+    vertexIndex.clear();
+    next->bounds = sf::FloatRect(0, 0, 800, 800);
+    for (int i = 0; i < numVertices; i++) {
+        float x = placement.x[i];
+        float y = placement.y[i];
+        vertexIndex[layoutVertices[i]->name] = i;
+        next->names.push_back(layoutVertices[i]->name);
+        next->positions.push_back(sf::Vector2f(x + 20, y + 20));
+        next->namePositions.push_back(sf::Vector2f(x, y - 7));
+    }
 
-            currentVertexNode = currentVertexNode->next;
+    // A line and a weight label per road
+    layoutEdges.clear();
+    edgeSource.clear();
+    for (int i = 0; i < numVertices; i++) {
+        for (EdgeNode* node = layoutVertices[i]->edges; node; node = node->next) {
+            layoutEdges.push_back(node->edge);
+            edgeSource.push_back(i);
         }
-
-        // Load the font for edge weights
-        sf::Font font2;
-        if (!font2.loadFromFile("sprites/font3.ttf")) {
-            std::cerr << "Couldn't load font\n";
-            return;
+    }
+    for (size_t e = 0; e < layoutEdges.size(); e++) {
+        sf::Vector2f startPos = next->positions[edgeSource[e]];
+        std::unordered_map<std::string, int>::const_iterator end = vertexIndex.find(layoutEdges[e]->destination->name);
+        sf::Vector2f endPos = end != vertexIndex.end() ? next->positions[end->second] : startPos;
+        next->weightPositions.push_back((startPos + endPos) / 2.0f);
+
+        // Offset one direction of a two-way road slightly so that both are visible
+        sf::Vector2f direction = endPos - startPos;
+        if (atan2(direction.y, direction.x) < 0) {
+            startPos += sf::Vector2f(5, 5);
+            endPos += sf::Vector2f(5, 5);
         }
+        next->edgeStart.push_back(startPos);
+        next->edgeEnd.push_back(endPos);
+        next->travelTime.push_back(layoutEdges[e]->travelTime);
+    }
+    layout = next;
+}
 
-        // Draw edge weights
-        currentVertexNode = graph.headVertex;
-        while (currentVertexNode) {
-            Vertex* vertex = currentVertexNode->vertex;
-            EdgeNode* currentEdgeNode = vertex->edges;
-            while (currentEdgeNode) {
-                Edge* edge = currentEdgeNode->edge;
-                sf::Vector2f startPos = positions[vertex->name];
-                sf::Vector2f endPos = positions[edge->destination->name];
-                sf::Vector2f midPos = (startPos + endPos) / 2.0f;
-
-                // Determine the direction of the edge
-                sf::Vector2f direction = endPos - startPos;
-                float angle = atan2(direction.y, direction.x);
-                if (angle < 0) {
-                    // Offset the line position slightly if the color is blue
-                    startPos += sf::Vector2f(5, 5);
-                    endPos += sf::Vector2f(5, 5);
-                }
-
-                // Get the color for the edge
-                sf::Color edgeColor = choseColor(currentEdgeNode, vertex, traffic, ht, accidentManager);
-                sf::Vertex line[] = {
-                    sf::Vertex(startPos, edgeColor),
-                    sf::Vertex(endPos, edgeColor)
-                };
-                window.draw(line, 2, sf::Lines);
-
-                // Draw the edge weight label
-                sf::Text weightLabel;
-                weightLabel.setFont(font2);
-                weightLabel.setString(std::to_string(edge->travelTime));
-                weightLabel.setCharacterSize(20);
-                weightLabel.setFillColor(sf::Color::Blue);
-                weightLabel.setPosition(midPos);
-                window.draw(weightLabel);
-
-                currentEdgeNode = currentEdgeNode->next;
-            }
-            currentVertexNode = currentVertexNode->next;
+// Function to copy the simulation state into a frame for the render thread
+void Visualizer::publishFrame(int time) {
+    updateLayout();
+    FrameSnapshot &frame = frames.writeBuffer();
+    frame.time = time;
+    frame.layout = layout;
+
+    // The engine's roads are numbered like the layout's as long as the topology has not changed since reset()
+    frame.edgeStates.resize(layoutEdges.size());
+    const LinkModel* links = engine ? &engine->getLinkModel() : nullptr;
+    if (heatmap && links && links->getLinkCount() == static_cast<int>(layoutEdges.size())) {
+        for (size_t e = 0; e < layoutEdges.size(); e++) {
+            int capacity = links->getCapacity(e);
+            int bucket = capacity > 0 ? links->getQueueLength(e) * HEAT_BUCKETS / capacity : 0;
+            if (bucket >= HEAT_BUCKETS)
+                bucket = HEAT_BUCKETS - 1;
+            frame.edgeStates[e] = layoutEdges[e]->isBlocked() ? EDGE_BLOCKED : EDGE_HEAT + bucket;
         }
+    } else {
+        // One signal lookup per intersection, shared by all of its roads
+        greenAt.assign(layoutVertices.size(), 0);
+        for (size_t i = 0; i < layoutVertices.size(); i++) {
+            TrafficSignal* signal = traffic->getSignal(layoutVertices[i]->name);
+            greenAt[i] = signal && signal->state == "green";
+        }
+        for (size_t e = 0; e < layoutEdges.size(); e++)
+            frame.edgeStates[e] = edgeState(layoutEdges[e], greenAt[edgeSource[e]] != 0);
+    }
 
-        // Display the window contents
-        window.display();
-        sf::sleep(sf::seconds(1));
-
-        // Move vehicles forward
-        Vehicle *currentVehicle = vehicles.getHead();
-        while (currentVehicle != NULL) {
-            if (currentVehicle->presetPath)
-                currentVehicle->moveForward();
+    // The vehicles at an intersection of the layout; the strings of the slot are reused
+    size_t count = 0;
+    frame.vehicleAt.clear();
+    for (Vehicle *currentVehicle = vehicles->getHead(); currentVehicle != NULL; currentVehicle = currentVehicle->next) {
+        int step = currentVehicle->currentIntersectionInPath;
+        if (step < 0 || step >= static_cast<int>(currentVehicle->path.size()))
+            continue;
+        std::unordered_map<std::string, int>::const_iterator at = vertexIndex.find(currentVehicle->path[step]);
+        if (at == vertexIndex.end())
+            continue;
+        frame.vehicleAt.push_back(at->second);
+        if (count < frame.vehicleIDs.size())
+            frame.vehicleIDs[count] = currentVehicle->vehicleID;
+        else
+            frame.vehicleIDs.push_back(currentVehicle->vehicleID);
+        count++;
+    }
+    frame.vehicleIDs.resize(count);
+    frames.publish();
+}
 
-            currentVehicle = currentVehicle->next;
+// Function to draw a frame on the window or the export texture
+void Visualizer::drawFrame(sf::RenderTarget &target, const FrameSnapshot &frame, bool fresh) {
+    PROFILE_SCOPE(PROFILE_RENDERING);
+    TRACE_SCOPE("drawFrame", "rendering");
+    // Geometry and labels of the network, rebuilt when the simulation published a new layout
+    if (frame.layout && frame.layout != drawnLayout) {
+        drawnLayout = frame.layout;
+        fresh = true;
+        const FrameLayout &next = *drawnLayout;
+        nameText.setFont(labelFont, 47);
+        for (size_t i = 0; i < next.names.size(); i++)
+            nameText.append(next.names[i], next.namePositions[i], sf::Color::White);
+        edgeLines.setPrimitiveType(sf::Lines);
+        edgeLines.resize(2 * next.edgeStart.size());
+        drawnStates.assign(next.edgeStart.size(), EDGE_OPEN);
+        weightText.setFont(weightFont, 20);
+        for (size_t e = 0; e < next.edgeStart.size(); e++) {
+            edgeLines[2 * e] = sf::Vertex(next.edgeStart[e], sf::Color::White);
+            edgeLines[2 * e + 1] = sf::Vertex(next.edgeEnd[e], sf::Color::White);
+            weightText.append(std::to_string(next.travelTime[e]), next.weightPositions[e], sf::Color::Blue);
         }
     }
+    if (fresh)
+        vehicleTextStale = true;
+
+    // Recolor only the edges whose color class changed since the frame drawn before
+    for (size_t e = 0; fresh && e < frame.edgeStates.size() && e < drawnStates.size(); e++) {
+        if (drawnStates[e] != frame.edgeStates[e]) {
+            drawnStates[e] = frame.edgeStates[e];
+            sf::Color color = stateColor(frame.edgeStates[e]);
+            edgeLines[2 * e].color = color;
+            edgeLines[2 * e + 1].color = color;
+        }
+    }
+
+    // Level of detail: the 20 pixel labels are skipped once zoomed out too far to read them
+    sf::Vector2u targetSize = target.getSize();
+    float scale = targetSize.x > 0 ? target.getView().getSize().x / targetSize.x : 1.0f;
+    bool showDetails = scale > 0 && 20 / scale >= MIN_LABEL_PIXELS;
+
+    // Clear the target with black color
+    target.clear(sf::Color::Black);
+    target.draw(nameText);
+    if (showDetails)
+        drawVehicles(frame, target);
+    target.draw(edgeLines);
+    if (showDetails)
+        target.draw(weightText);
 }
 
-// Function to draw vehicles at a specific intersection
-void Visualizer::drawVehicles(Vehicles &vehicles, const std::string &intersection, const sf::Vector2f &position, sf::RenderWindow &window) {
-    Vehicle *currentVehicle = vehicles.getHead();
-    int decrement = 0;
-    while (currentVehicle != NULL) {
-        if (currentVehicle->path[currentVehicle->currentIntersectionInPath] == intersection) {
-            // Draw vehicle label
-            sf::Font font;
-            if (!font.loadFromFile("sprites/font3.ttf")) {
-                std::cerr << "Couldn't load font\n";
-                return;
-            }
-
-            sf::Text label;
-            label.setFont(font);
-            label.setString(currentVehicle->vehicleID);
-            label.setCharacterSize(20);
-            label.setFillColor(sf::Color::Red);
-            label.setPosition(position.x, position.y - 20 + decrement);
-            window.draw(label);
-            decrement -= 20;
+// Function to draw the vehicles of a frame at their intersections
+void Visualizer::drawVehicles(const FrameSnapshot &frame, sf::RenderTarget &target) {
+    if (vehicleTextStale && frame.layout) {
+        vehicleTextStale = false;
+        const std::vector<sf::Vector2f> &positions = frame.layout->positions;
+        vehiclesAt.assign(positions.size(), 0);
+        vehicleText.setFont(weightFont, 20);
+        for (size_t v = 0; v < frame.vehicleAt.size(); v++) {
+            // Add the vehicle label, stacked above the ones already at this intersection
+            int at = frame.vehicleAt[v];
+            float offset = 20.0f * ++vehiclesAt[at];
+            vehicleText.append(frame.vehicleIDs[v], sf::Vector2f(positions[at].x, positions[at].y - offset), sf::Color::Red);
         }
-        currentVehicle = currentVehicle->next;
     }
+    target.draw(vehicleText);
+}
+
+// Function to zoom the view around the point under the mouse
+void Visualizer::zoom(float delta, int x, int y) {
+    if (delta == 0)
+        return;
+    window.setView(view);
+    sf::Vector2f before = window.mapPixelToCoords(sf::Vector2i(x, y));
+    view.zoom(delta > 0 ? 0.8f : 1.25f);
+    window.setView(view);
+    sf::Vector2f after = window.mapPixelToCoords(sf::Vector2i(x, y));
+    view.move(before - after);
 }
 
 // Function to get the elapsed time in seconds
@@ -209,20 +379,39 @@ float Visualizer::getElapsedTimeInSeconds() {
     return clock.getElapsedTime().asSeconds();
 }
 
-// Function to choose the color for an edge based on various conditions
-sf::Color Visualizer::choseColor(EdgeNode *edgeNode, Vertex *vertex, TrafficLightManagement &traffic, CongestionMonitoring &ht, Accident_roads &accidentManager) {
+// Function to choose the color class of a road from its state and the state of its signal
+unsigned char Visualizer::edgeState(const Edge *edge, bool sourceGreen) {
     // Check if the edge is blocked
-    if (edgeNode->edge->isBlocked()) {
-        return sf::Color::Magenta;
+    if (edge->isBlocked()) {
+        return EDGE_BLOCKED;
     }
 
     // Check if the edge has a green light
-    std::string signal = traffic.getSignal(vertex->name)->state;
-    if (signal == "green") {
-        std::cout << "Green light" << std::endl;
-        return sf::Color::Green;
+    if (sourceGreen) {
+        return EDGE_GREEN;
     }
 
-    // Default color if none of the above conditions are met
-    return sf::Color::White;
+    // Default class if none of the above conditions are met
+    return EDGE_OPEN;
+}
+
+// Function to get the color of a color class
+sf::Color Visualizer::stateColor(unsigned char state) {
+    if (state == EDGE_BLOCKED)
+        return sf::Color::Magenta;
+    if (state == EDGE_GREEN)
+        return sf::Color::Green;
+    if (state < EDGE_HEAT)
+        return sf::Color::White;
+
+    // Occupancy: green when empty, yellow when half full, red when full
+    float heat = static_cast<float>(state - EDGE_HEAT) / (HEAT_BUCKETS - 1);
+    if (heat < 0.5f)
+        return sf::Color(static_cast<sf::Uint8>(510 * heat), 255, 0);
+    return sf::Color(255, static_cast<sf::Uint8>(510 * (1 - heat)), 0);
+}
+
+// Function to switch between the heatmap and the signal colors
+void Visualizer::setHeatmap(bool enabled) {
+    heatmap = enabled;
 }
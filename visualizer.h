@@ -2,8 +2,12 @@
 #define VISUALIZER_H
 
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
-#include <map>
+#include <unordered_map>
+#include <vector>
 #include "graph.h"
 #include "vehicle.h"
 #include "vehicles.h"
@@ -11,16 +15,186 @@
 #include "accidents.h"
 #include "trafficLightManagement.h"
 #include "congestionMonitoring.h"
+#include "simulationEngine.h"
+#include "textBatch.h"
+#include "frameEncoder.h"
+#include "tripleBuffer.h"
 
-class Visualizer {
+/**
+ * @struct FrameLayout
+ * @brief Where each intersection, road and label of the network is drawn.
+ *
+ * Built by the simulation thread when the graph topology changes and never modified afterwards, so
+ * it is shared by every FrameSnapshot until the next change.
+ */
+struct FrameLayout {
+    sf::FloatRect bounds;                       /**< Area the network is laid out in */
+    std::vector<std::string> names;             /**< Name of each intersection */
+    std::vector<sf::Vector2f> positions;        /**< Position of each intersection (where its vehicles are drawn) */
+    std::vector<sf::Vector2f> namePositions;    /**< Position of the name label of each intersection */
+    std::vector<sf::Vector2f> edgeStart;        /**< Start of the line of each road */
+    std::vector<sf::Vector2f> edgeEnd;          /**< End of the line of each road */
+    std::vector<sf::Vector2f> weightPositions;  /**< Position of the travel time label of each road */
+    std::vector<int> travelTime;                /**< Travel time of each road */
+};
+
+/**
+ * @struct FrameSnapshot
+ * @brief The simulation state drawn in a frame, copied at the end of a simulation step.
+ *
+ * Once published it is only read, by the render thread, so the simulation may go on changing the
+ * state it was copied from.
+ */
+struct FrameSnapshot {
+    int time;                                   /**< Simulated time in seconds */
+    std::shared_ptr<const FrameLayout> layout;  /**< The network, null before the first snapshot */
+    std::vector<unsigned char> edgeStates;      /**< Color class of each road of the layout (see Visualizer::stateColor) */
+    std::vector<int> vehicleAt;                 /**< Intersection of each vehicle shown */
+    std::vector<std::string> vehicleIDs;        /**< ID of each vehicle shown */
+
+    FrameSnapshot() : time(0) {}
+};
+
+class Visualizer : public SimulationObserver {
 private:
     sf::RenderWindow window;  
     sf::Sprite roadSprite;
     sf::Sprite vehicleSprite;
-    sf::Font font;
+    sf::Font labelFont; //<Font of the intersection names
+    sf::Font weightFont; //<Font of the travel times and vehicle IDs
     sf::Texture roadTexture;
     sf::Texture vehicleTexture;
+    bool resourcesLoaded; //<Fonts and textures are loaded once, by the first frame
     sf::Clock clock; //<Measures elapsed time
+    int secondsPerFrame; //<Simulated seconds between two published frames
+
+    // State copied into the frames, set by drawSimulation and read by the simulation thread only
+    SimulationEngine* engine;
+    Graph* graph;
+    Vehicles* vehicles;
+    TrafficLightManagement* traffic;
+    CongestionMonitoring* ht;
+    Accident_roads* accidentManager;
+
+    // Simulation thread: the layout, rebuilt only when the graph topology version changes
+    int layoutVersion; //<Graph topology version the layout was built for, -1 before the first frame
+    std::shared_ptr<const FrameLayout> layout; //<Layout given to the frames
+    std::vector<Vertex*> layoutVertices; //<Intersections in vertex list order
+    std::unordered_map<std::string, int> vertexIndex; //<Index of each intersection by name
+    std::vector<Edge*> layoutEdges; //<Roads in adjacency list order
+    std::vector<int> edgeSource; //<Start intersection of each road
+    std::vector<char> greenAt; //<Whether the signal of each intersection is green in the current step
+    std::chrono::steady_clock::time_point paceStart; //<Real time at which the simulation was at paceTime
+    int paceTime; //<Simulated time from which the pace is kept
+    int pacedSpeed; //<Speed the pace was started with
+
+    // Shared between the threads
+    TripleBuffer<FrameSnapshot> frames; //<Newest frame published by the simulation
+    std::atomic<bool> running; //<Cleared when the window is closed, to stop the simulation
+    std::atomic<int> speed; //<Simulated seconds per real second, 5 at first, doubled and halved with the + and - keys
+    std::atomic<bool> heatmap; //<Color the roads by occupancy (queued vehicles over capacity) instead of signal state, toggled with the H key
+
+    // Offscreen export, set by exportSimulation and used by the simulation thread
+    sf::RenderTexture* exportTexture; //<Target the frames are rendered to, null when drawing in the window
+    FrameEncoder* encoder; //<Writes the exported frames
+
+    // Render thread: what is on screen
+    std::shared_ptr<const FrameLayout> drawnLayout; //<Layout the geometry and labels below were built from
+    sf::VertexArray edgeLines; //<Two vertices per road, recolored in place when the road's state changes
+    std::vector<unsigned char> drawnStates; //<Color class of each road in edgeLines
+    TextBatch nameText; //<Intersection names
+    TextBatch weightText; //<Travel time of each road
+    TextBatch vehicleText; //<Vehicle IDs of the frame on screen
+    bool vehicleTextStale; //<vehicleText is from an older frame
+    std::vector<int> vehiclesAt; //<Number of vehicle labels placed at each intersection
+    sf::View view; //<Visible part of the network, zoomed with the mouse wheel
+    static const float MIN_LABEL_PIXELS; //<Travel times and vehicle IDs are hidden when drawn smaller than this
+    static const int MAX_SPEED; //<Upper bound of speed
+    static const char* const COORDINATES_FILE; //<Intersection coordinates used for the layout when it covers the network
+    static const char* const LAYOUT_CACHE; //<Directory of the cached force-directed layouts
+
+    // Color classes of the roads in a FrameSnapshot
+    static const unsigned char EDGE_OPEN = 0; //<White
+    static const unsigned char EDGE_GREEN = 1; //<Green signal at the start of the road
+    static const unsigned char EDGE_BLOCKED = 2; //<Magenta
+    static const unsigned char EDGE_HEAT = 3; //<First of the HEAT_BUCKETS occupancy classes, from empty to full
+    static const int HEAT_BUCKETS = 8;
+
+    /**
+     * @brief Copies the simulation state into a snapshot and publishes it to the render thread.
+     *
+     * @param time The simulated time in seconds.
+     */
+    void publishFrame(int time);
+
+    /**
+     * @brief Rebuilds the layout if the graph topology has changed.
+     *
+     * Intersections are placed with GraphLayout: at their coordinates from COORDINATES_FILE when it
+     * has them all, otherwise by a force-directed layout cached in LAYOUT_CACHE.
+     */
+    void updateLayout();
+
+    /**
+     * @brief Keeps the simulation to the chosen speed, sleeping if it is ahead of it.
+     *
+     * @param time The simulated time in seconds.
+     */
+    void pace(int time);
+
+    /**
+     * @brief Draws a snapshot on a render target, through the target's current view.
+     *
+     * The road geometry and labels are rebuilt only when the snapshot has a new layout, and only the
+     * roads whose color class changed are recolored. All roads are drawn with one draw call and each
+     * kind of label with one more, through the glyph atlas of its font.
+     *
+     * @param target The window or offscreen texture; display() is left to the caller.
+     * @param frame The snapshot.
+     * @param fresh Whether the snapshot is newer than the one drawn before.
+     */
+    void drawFrame(sf::RenderTarget &target, const FrameSnapshot &frame, bool fresh);
+
+    /**
+     * @brief Renders the newest snapshot offscreen and queues it for encoding.
+     */
+    void exportFrame();
+
+    /**
+     * @brief Loads the fonts and textures from the sprites folder, on the first call only.
+     */
+    void loadResources();
+
+    /**
+     * @brief Handles the pending window events (closing, zoom, speed keys).
+     */
+    void handleEvents();
+
+    /**
+     * @brief Zooms the view in or out around a point of the window.
+     *
+     * @param delta The mouse wheel movement, positive to zoom in.
+     * @param x The horizontal position of the point in the window.
+     * @param y The vertical position of the point in the window.
+     */
+    void zoom(float delta, int x, int y);
+
+    /**
+     * @brief Chooses the color class of a road.
+     *
+     * @param edge The road.
+     * @param sourceGreen Whether the signal at the start of the road is green.
+     * @return EDGE_BLOCKED if the road is blocked, EDGE_GREEN if its signal is green, EDGE_OPEN otherwise.
+     */
+    static unsigned char edgeState(const Edge *edge, bool sourceGreen);
+
+    /**
+     * @brief Gets the color of a color class: white, green, magenta, then green through yellow to red for occupancy.
+     *
+     * @param state The color class.
+     * @return sf::Color
+     */
+    static sf::Color stateColor(unsigned char state);
 
 public:
 /**
@@ -28,7 +202,8 @@ public:
  * @brief A class to handle the visualization of the traffic management system.
  *
  * This class is responsible for rendering the simulation of the traffic management system,
- * including roads and vehicles, using the SFML library.
+ * including roads and vehicles, using the SFML library. It does not move anything itself: it observes
+ * a SimulationEngine and draws the frames the engine publishes, in a window or offscreen.
  */
 
 /**
@@ -41,6 +216,10 @@ Visualizer();
 /**
  * @brief Draws the entire simulation graph.
  *
+ * Runs a SimulationEngine over the given state and draws it until the window is closed.
+ * The engine runs on its own thread and publishes a FrameSnapshot every secondsPerFrame simulated
+ * seconds, while the calling thread draws the newest one at the display rate; neither waits for the other.
+ *
  * @param graph The graph representing the traffic network.
  * @param vehicles The collection of vehicles to be drawn.
  * @param traffic The traffic light management system.
@@ -50,33 +229,78 @@ Visualizer();
 void drawSimulation(Graph &graph, Vehicles &vehicles, TrafficLightManagement &traffic, CongestionMonitoring &ht, Accident_roads &accidentManager);
 
 /**
- * @brief Draws vehicles at the specified intersection.
+ * @brief Draws a simulation driven by an existing engine until the window is closed.
+ *
+ * The engine must have been reset() and must run over the same state as the other parameters.
+ *
+ * @param engine The simulation engine, e.g. with incidents already scheduled.
+ * @param graph The graph representing the traffic network.
+ * @param vehicles The collection of vehicles to be drawn.
+ * @param traffic The traffic light management system.
+ * @param ht The congestion monitoring system.
+ * @param accidentManager The accident management system.
+ */
+void drawSimulation(SimulationEngine &engine, Graph &graph, Vehicles &vehicles, TrafficLightManagement &traffic, CongestionMonitoring &ht, Accident_roads &accidentManager);
+
+/**
+ * @brief Renders the simulation offscreen into an image sequence or a raw video stream.
+ *
+ * Runs the engine on the calling thread without opening a window: a frame is rendered into an
+ * sf::RenderTexture every interval simulated seconds and handed to a FrameEncoder, whose worker
+ * threads compress and write it while the simulation goes on. SFML still needs an OpenGL driver
+ * for the texture (e.g. Mesa's software renderer on a server without a GPU), but no display.
  *
+ * @param engine The simulation engine, already reset().
+ * @param graph The graph representing the traffic network.
  * @param vehicles The collection of vehicles to be drawn.
- * @param intersection The name of the intersection where vehicles are to be drawn.
- * @param position The position where the vehicles should be drawn.
- * @param window The render window where the vehicles will be drawn.
+ * @param traffic The traffic light management system.
+ * @param ht The congestion monitoring system.
+ * @param accidentManager The accident management system.
+ * @param output A directory for numbered PNG images, or a file ending in .rgba or .raw for a raw RGBA stream.
+ * @param endTime The simulated time to stop at, in seconds.
+ * @param interval The simulated seconds between two frames.
+ * @param width The width of the frames in pixels.
+ * @param height The height of the frames in pixels.
+ * @param threads The number of encoder threads (values below 1 use one per hardware thread).
+ * @return true if every frame was written, false otherwise (an error is printed).
  */
-void drawVehicles(Vehicles &vehicles, const std::string &intersection, const sf::Vector2f &position, sf::RenderWindow &window);
+bool exportSimulation(SimulationEngine &engine, Graph &graph, Vehicles &vehicles, TrafficLightManagement &traffic, CongestionMonitoring &ht, Accident_roads &accidentManager,
+                      const std::string &output, int endTime, int interval, unsigned width, unsigned height, int threads);
 
 /**
- * @brief Gets the elapsed time in seconds since the last clock reset.
+ * @brief Chooses between the occupancy heatmap and the signal colors for the roads.
  *
- * @return The elapsed time in seconds.
+ * @param enabled true for the heatmap.
  */
-float getElapsedTimeInSeconds();
+void setHeatmap(bool enabled);
 
 /**
- * @brief Chooses a color for the edge and vertex based on traffic conditions.
+ * @brief Publishes a frame at the end of each simulation step, on the simulation thread.
  *
- * @param edge The edge node representing the road segment.
- * @param vertex The vertex representing the intersection.
- * @param traffic The traffic light management system.
- * @param ht The congestion monitoring system.
- * @param accidentManager The accident management system.
- * @return The chosen color.
+ * When exporting, the frame is rendered and queued for encoding instead.
+ *
+ * @param time The simulated time in seconds.
+ * @return false once the window has been closed.
+ */
+bool onStep(int time);
+
+/**
+ * @brief Draws the ID of every vehicle of a snapshot next to its intersection.
+ *
+ * The IDs at the same intersection are stacked upwards and all of them are drawn with one draw
+ * call; they are laid out again only when the snapshot changes.
+ *
+ * @param frame The snapshot holding the vehicles to be drawn.
+ * @param target The render target where the vehicles will be drawn.
  */
-sf::Color choseColor(EdgeNode *edge, Vertex *vertex, TrafficLightManagement &traffic, CongestionMonitoring &ht, Accident_roads &accidentManager);
+void drawVehicles(const FrameSnapshot &frame, sf::RenderTarget &target);
+
+/**
+ * @brief Gets the elapsed time in seconds since the last clock reset.
+ *
+ * @return The elapsed time in seconds.
+ */
+float getElapsedTimeInSeconds();
 
    
 };